@@ -0,0 +1,175 @@
+#ifndef G8AsyncRecognizer_h
+#define G8AsyncRecognizer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Cancellation.h"
+#import "G8Engine.h"
+#import "G8ResultNode.h"
+#import "G8TaskPool.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Leptonica internals
+struct Pix;
+
+namespace g8 {
+
+class RequestCoalescer;
+
+/**
+ * How `AsyncRecognizer` recognizes one image.
+ */
+struct RecognitionOptions {
+    int pageSegMode = -1;            ///< tesseract::PageSegMode, -1 to keep the engine's mode
+    int sourceResolution = 0;        ///< Resolution of the image, 0 to use the image's
+    int deadlineMsecs = 0;           ///< Time limit, 0 for none
+    CancellationToken cancellation;  ///< Skips or stops the recognition once cancelled
+    std::function<void(int)> progress;  ///< Called on the worker thread when the percentage increases, may be empty
+    std::shared_ptr<RequestCoalescer> coalescer;  ///< Shares the recognition with identical requests in flight, may be empty
+};
+
+/**
+ * Outcome of recognizing one image.
+ */
+struct RecognitionOutput {
+    bool recognized = false;   ///< false if the image couldn't be loaded, recognition failed or was cancelled
+    bool cancelled = false;    ///< Whether the cancellation token stopped or skipped the recognition
+    std::string text;          ///< UTF-8 text as TessBaseAPI::GetUTF8Text returns it
+    int meanConfidence = 0;    ///< TessBaseAPI::MeanTextConf, 0-100
+    double seconds = 0;        ///< Time spent on loading and recognizing the image
+    size_t worker = 0;         ///< Index of the worker thread that recognized the image
+    bool coalesced = false;    ///< Whether the result was shared by an identical request, see RequestCoalescer
+};
+
+/**
+ * Recognizes images asynchronously on the worker threads of a TaskPool,
+ * each bound to its own engine. Every submission gets exactly one result,
+ * through a future or a completion callback.
+ *
+ * Engines are taken from EnginePool, or created from the configuration when
+ * the pool is empty, and returned to it when the recognizer is destroyed.
+ * Only Tesseract, Leptonica and the standard library are used, so the
+ * recognizer runs wherever the core builds.
+ *
+ * Usage example:
+ * @code
+ * g8::AsyncRecognizer recognizer(config);
+ * g8::RecognitionOptions options;
+ * options.progress = [](int percent) { printf("%d%%\n", percent); };
+ * std::future<g8::RecognitionOutput> result = recognizer.submit([] { return pixRead("page.png"); }, options);
+ * ...
+ * options.cancellation.cancel();
+ * printf("%s", result.get().text.c_str());
+ * @endcode
+ */
+class AsyncRecognizer final {
+public:
+    /**
+     * Produces an image on a worker thread; ownership of the Pix passes to
+     * the recognizer. Returns nullptr if the image can't be loaded.
+     */
+    using ImageLoader = std::function<Pix*()>;
+
+    /**
+     * Called on the worker thread once the image is done.
+     */
+    using Completion = std::function<void(RecognitionOutput)>;
+
+    /**
+     * Starts the worker threads. Engines are created lazily.
+     * @param config      Configuration of the worker engines
+     * @param concurrency Worker threads, 0 for one per processor core
+     */
+    explicit AsyncRecognizer(const EngineConfig& config, size_t concurrency = 0);
+
+    /**
+     * Finishes every submitted image, then returns the engines to the pool.
+     * Cancel the submissions first to get it over with quickly.
+     */
+    ~AsyncRecognizer();
+
+    AsyncRecognizer(const AsyncRecognizer&) = delete;
+    AsyncRecognizer& operator=(const AsyncRecognizer&) = delete;
+
+    /**
+     * Queues an image and calls completion when it's done. With a
+     * coalescer in the options, a request for the same image and options as
+     * one being recognized gets a copy of its result instead; its progress
+     * callback isn't called.
+     * @param image      Loader of the image
+     * @param options    Recognition settings, cancellation and progress
+     * @param completion Called exactly once, on a worker thread
+     */
+    void submit(ImageLoader image, RecognitionOptions options, Completion completion);
+
+    /**
+     * Queues an image.
+     * @return A future for the result
+     */
+    std::future<RecognitionOutput> submit(ImageLoader image, RecognitionOptions options = RecognitionOptions());
+
+    /**
+     * Recognizes an image with the engine of the calling worker thread, for
+     * code that already runs on the pool, e.g. a coroutine resumed on it.
+     * @param pix     The image, not taken over
+     * @param options Recognition settings, cancellation and progress
+     * @param blocks  If not nullptr, receives the results detached from the engine
+     * @return The outcome; not recognized if called from another thread
+     */
+    RecognitionOutput recognizeOnWorker(Pix* pix, const RecognitionOptions& options,
+                                        std::vector<ResultNode>* blocks = nullptr);
+
+    /**
+     * The engine bound to the calling worker thread, created on first use.
+     * @return nullptr if called from another thread or if the engine can't
+     *         be created
+     */
+    Engine* workerEngine();
+
+    /**
+     * The configuration of the worker engines.
+     */
+    const EngineConfig& config() const noexcept;
+
+    /**
+     * Number of worker threads.
+     */
+    size_t threadCount() const noexcept;
+
+    /**
+     * The work-stealing pool, e.g. for its statistics or to run tasks that
+     * use `workerEngine`.
+     */
+    TaskPool& pool() noexcept;
+    const TaskPool& pool() const noexcept;
+
+private:
+    void run(const ImageLoader& image, const RecognitionOptions& options, const Completion& completion);
+
+    const EngineConfig config_;
+    std::vector<std::unique_ptr<Engine>> engines_;  ///< Indexed by worker
+    TaskPool pool_;  ///< Declared last, so that workers stop before engines go
+};
+
+/**
+ * Recognizes an image with an engine on the calling thread, the way
+ * AsyncRecognizer's workers do. The engine's page segmentation mode is
+ * restored and its results are cleared afterwards.
+ * @param engine  The engine, used by no other thread meanwhile
+ * @param pix     The image, not taken over
+ * @param options Recognition settings, cancellation and progress; the
+ *                coalescer is ignored
+ * @param blocks  If not nullptr, receives the results detached from the engine
+ * @return The outcome; `worker` is left at 0
+ */
+RecognitionOutput recognizeWithEngine(Engine& engine, Pix* pix, const RecognitionOptions& options,
+                                      std::vector<ResultNode>* blocks = nullptr);
+
+} // namespace g8
+
+#endif /* G8AsyncRecognizer_h */
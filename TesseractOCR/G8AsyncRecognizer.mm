@@ -0,0 +1,158 @@
+#import "G8AsyncRecognizer.h"
+#import "G8ConcurrencyGovernor.h"
+#import "G8EnginePool.h"
+#import "G8PixWrapper.h"
+#import "G8RequestCoalescer.h"
+#import "G8TextMonitor.h"
+#import <Tesseract/baseapi.h>
+#import <Tesseract/ocrclass.h>
+
+#include <chrono>
+
+namespace g8 {
+
+AsyncRecognizer::AsyncRecognizer(const EngineConfig& config, size_t concurrency)
+    : config_(config), pool_(concurrency) {
+    engines_.resize(pool_.threadCount());
+}
+
+AsyncRecognizer::~AsyncRecognizer() {
+    pool_.wait();
+    for (auto& engine : engines_) {
+        EnginePool::shared().release(std::move(engine));
+    }
+}
+
+void AsyncRecognizer::submit(ImageLoader image, RecognitionOptions options, Completion completion) {
+    ConcurrencyGovernor::shared().addPending();
+    pool_.submit([this, image = std::move(image), options = std::move(options), completion = std::move(completion)] {
+        ConcurrencyGovernor::shared().removePending();
+        run(image, options, completion);
+    });
+}
+
+std::future<RecognitionOutput> AsyncRecognizer::submit(ImageLoader image, RecognitionOptions options) {
+    // std::function needs a copyable callable, so the promise is shared
+    auto promise = std::make_shared<std::promise<RecognitionOutput>>();
+    std::future<RecognitionOutput> future = promise->get_future();
+    submit(std::move(image), std::move(options), [promise](RecognitionOutput output) {
+        promise->set_value(std::move(output));
+    });
+    return future;
+}
+
+const EngineConfig& AsyncRecognizer::config() const noexcept {
+    return config_;
+}
+
+size_t AsyncRecognizer::threadCount() const noexcept {
+    return pool_.threadCount();
+}
+
+TaskPool& AsyncRecognizer::pool() noexcept {
+    return pool_;
+}
+
+const TaskPool& AsyncRecognizer::pool() const noexcept {
+    return pool_;
+}
+
+Engine* AsyncRecognizer::workerEngine() {
+    const size_t worker = pool_.workerIndex();
+    if (worker == TaskPool::npos) {
+        return nullptr;
+    }
+
+    // Only this worker touches its slot
+    std::unique_ptr<Engine>& engine = engines_[worker];
+    if (!engine) {
+        engine = EnginePool::shared().acquire(config_);
+    }
+    if (!engine) {
+        engine = Engine::create(config_);
+    }
+    return engine.get();
+}
+
+void AsyncRecognizer::run(const ImageLoader& image, const RecognitionOptions& options, const Completion& completion) {
+    RecognitionOutput output;
+    output.worker = pool_.workerIndex();
+    if (options.cancellation.isCancelled()) {
+        output.cancelled = true;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        PixWrapper pix(image ? image() : nullptr);
+
+        // A follower is answered by the leader's finish
+        std::string key;
+        if (pix && options.coalescer) {
+            key = RequestCoalescer::key(pix.get(), config_, options);
+            if (options.coalescer->join(key, pix.get(), completion)) {
+                return;
+            }
+        }
+        if (pix) {
+            output = recognizeOnWorker(pix.get(), options);
+        }
+        output.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!key.empty()) {
+            options.coalescer->finish(key, pix.get(), output);
+        }
+    }
+    if (completion) {
+        completion(std::move(output));
+    }
+}
+
+RecognitionOutput AsyncRecognizer::recognizeOnWorker(Pix* pix, const RecognitionOptions& options,
+                                                     std::vector<ResultNode>* blocks) {
+    RecognitionOutput output;
+    Engine* engine = pix ? workerEngine() : nullptr;
+    if (engine) {
+        ConcurrencyGovernor::Lease lease = ConcurrencyGovernor::shared().acquire(1);
+        output = recognizeWithEngine(*engine, pix, options, blocks);
+    }
+    output.worker = pool_.workerIndex();
+    return output;
+}
+
+RecognitionOutput recognizeWithEngine(Engine& engine, Pix* pix, const RecognitionOptions& options,
+                                      std::vector<ResultNode>* blocks) {
+    RecognitionOutput output;
+    auto start = std::chrono::steady_clock::now();
+    tesseract::TessBaseAPI* api = engine.api();
+    const tesseract::PageSegMode pageSegMode = api->GetPageSegMode();
+    if (options.pageSegMode >= 0) {
+        api->SetPageSegMode(static_cast<tesseract::PageSegMode>(options.pageSegMode));
+    }
+    api->SetImage(pix);
+    if (options.sourceResolution > 0) {
+        api->SetSourceResolution(options.sourceResolution);
+    }
+
+    TextMonitor monitor;
+    monitor.setCancellationToken(options.cancellation);
+    monitor.setDeadline(options.deadlineMsecs);
+    if (options.progress) {
+        monitor.setProgressCallback(options.progress);
+    }
+    if (api->Recognize(monitor.get()) == 0 && !options.cancellation.isCancelled()) {
+        std::unique_ptr<char[]> text(api->GetUTF8Text());
+        output.text = text ? text.get() : "";
+        output.meanConfidence = api->MeanTextConf();
+        output.recognized = true;
+        if (blocks) {
+            std::unique_ptr<tesseract::ResultIterator> iterator(api->GetIterator());
+            *blocks = iterator ? buildResultTree(*iterator) : std::vector<ResultNode>();
+        }
+    } else {
+        output.cancelled = options.cancellation.isCancelled();
+    }
+
+    api->Clear();
+    api->SetPageSegMode(pageSegMode);
+    output.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return output;
+}
+
+} // namespace g8
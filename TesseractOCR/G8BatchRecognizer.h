@@ -0,0 +1,121 @@
+#ifndef G8BatchRecognizer_h
+#define G8BatchRecognizer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8AsyncRecognizer.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * Outcome of recognizing one image of a batch.
+ */
+struct BatchItemResult {
+    size_t index = 0;          ///< Position of the image in the batch
+    bool recognized = false;   ///< false if the image couldn't be loaded, recognition failed or was cancelled
+    std::string text;          ///< UTF-8 text as TessBaseAPI::GetUTF8Text returns it
+    int meanConfidence = 0;    ///< TessBaseAPI::MeanTextConf, 0-100
+    double seconds = 0;        ///< Time spent on loading and recognizing the image
+    size_t worker = 0;         ///< Index of the worker thread that recognized the image
+};
+
+/**
+ * How `BatchRecognizer` recognizes each image.
+ */
+struct BatchOptions {
+    int pageSegMode = -1;       ///< tesseract::PageSegMode, -1 to keep the engines' mode
+    int sourceResolution = 0;   ///< Resolution of the images, 0 to use each image's
+    int deadlineMsecs = 0;      ///< Time limit per image, 0 for none
+    CancellationToken cancellation;  ///< Cancels the batch, checked by every engine of it
+};
+
+/**
+ * Recognizes many images with one engine per worker thread of a
+ * work-stealing TaskPool, by submitting them to an AsyncRecognizer and
+ * waiting for all of them.
+ *
+ * Usage example:
+ * @code
+ * g8::BatchRecognizer recognizer(config);
+ * std::vector<g8::BatchRecognizer::ImageLoader> images;
+ * for (const auto& path : paths) {
+ *     images.push_back([path] { return pixRead(path.c_str()); });
+ * }
+ * auto results = recognizer.recognize(images, g8::BatchOptions(), [](const g8::BatchItemResult& result) {
+ *     printf("%zu: %s", result.index, result.text.c_str());
+ * });
+ * @endcode
+ */
+class BatchRecognizer final {
+public:
+    /**
+     * Produces an image on a worker thread; ownership of the Pix passes to
+     * the recognizer. Returns nullptr if the image can't be loaded.
+     */
+    using ImageLoader = AsyncRecognizer::ImageLoader;
+
+    /**
+     * Called on a worker thread as soon as an image is done; calls are
+     * serialized.
+     */
+    using ItemCompletion = std::function<void(const BatchItemResult&)>;
+
+    /**
+     * Starts the worker threads. Engines are created lazily.
+     * @param config      Configuration of the worker engines
+     * @param concurrency Worker threads, 0 for one per processor core
+     */
+    explicit BatchRecognizer(const EngineConfig& config, size_t concurrency = 0);
+
+    BatchRecognizer(const BatchRecognizer&) = delete;
+    BatchRecognizer& operator=(const BatchRecognizer&) = delete;
+
+    /**
+     * Recognizes all images and blocks until they're done. Concurrent calls
+     * run one after the other.
+     * @param images     Image loaders in batch order
+     * @param options    Recognition settings applied to every image
+     * @param completion Called for each image in completion order, may be empty
+     * @return The results in batch order
+     */
+    std::vector<BatchItemResult> recognize(const std::vector<ImageLoader>& images,
+                                           const BatchOptions& options = BatchOptions(),
+                                           const ItemCompletion& completion = nullptr);
+
+    /**
+     * Stops the current batch by cancelling its token: images not started
+     * yet are skipped and running recognitions are cancelled. Can be called
+     * from any thread.
+     */
+    void cancel();
+
+    /**
+     * The configuration of the worker engines.
+     */
+    const EngineConfig& config() const noexcept;
+
+    /**
+     * Number of worker threads.
+     */
+    size_t threadCount() const noexcept;
+
+    /**
+     * The work-stealing pool, e.g. for its statistics.
+     */
+    const TaskPool& pool() const noexcept;
+
+private:
+    std::mutex batchMutex_;
+    std::mutex cancellationMutex_;
+    CancellationToken cancellation_;  ///< Token of the current batch
+    AsyncRecognizer recognizer_;  ///< Declared last, so that it finishes before the batch state goes
+};
+
+} // namespace g8
+
+#endif /* G8BatchRecognizer_h */
@@ -0,0 +1,72 @@
+#import "G8BatchRecognizer.h"
+
+#include <condition_variable>
+
+namespace g8 {
+
+BatchRecognizer::BatchRecognizer(const EngineConfig& config, size_t concurrency)
+    : recognizer_(config, concurrency) {
+}
+
+std::vector<BatchItemResult> BatchRecognizer::recognize(const std::vector<ImageLoader>& images,
+                                                        const BatchOptions& options,
+                                                        const ItemCompletion& completion) {
+    std::lock_guard<std::mutex> batchLock(batchMutex_);
+    {
+        std::lock_guard<std::mutex> lock(cancellationMutex_);
+        cancellation_ = options.cancellation;
+    }
+
+    RecognitionOptions itemOptions;
+    itemOptions.pageSegMode = options.pageSegMode;
+    itemOptions.sourceResolution = options.sourceResolution;
+    itemOptions.deadlineMsecs = options.deadlineMsecs;
+    itemOptions.cancellation = options.cancellation;
+
+    std::vector<BatchItemResult> results(images.size());
+    std::mutex completionMutex;
+    std::condition_variable finished;
+    size_t pending = images.size();
+    for (size_t i = 0; i < images.size(); ++i) {
+        recognizer_.submit(images[i], itemOptions, [&, i](RecognitionOutput output) {
+            BatchItemResult& result = results[i];
+            result.index = i;
+            result.recognized = output.recognized;
+            result.text = std::move(output.text);
+            result.meanConfidence = output.meanConfidence;
+            result.seconds = output.seconds;
+            result.worker = output.worker;
+
+            std::lock_guard<std::mutex> lock(completionMutex);
+            if (completion) {
+                completion(result);
+            }
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(completionMutex);
+    finished.wait(lock, [&] { return pending == 0; });
+    return results;
+}
+
+void BatchRecognizer::cancel() {
+    std::lock_guard<std::mutex> lock(cancellationMutex_);
+    cancellation_.cancel();
+}
+
+const EngineConfig& BatchRecognizer::config() const noexcept {
+    return recognizer_.config();
+}
+
+size_t BatchRecognizer::threadCount() const noexcept {
+    return recognizer_.threadCount();
+}
+
+const TaskPool& BatchRecognizer::pool() const noexcept {
+    return recognizer_.pool();
+}
+
+} // namespace g8
@@ -0,0 +1,71 @@
+#ifndef G8Cancellation_h
+#define G8Cancellation_h
+
+#import <Foundation/Foundation.h>
+
+#include <atomic>
+#include <memory>
+
+namespace g8 {
+
+/**
+ * A cancellation flag shared by all copies of a token, e.g. by every engine
+ * of a batch or of a page recognized in parallel. Once cancelled it stays
+ * cancelled.
+ *
+ * Tesseract polls its cancel callback for every word; `cancelCallback`
+ * answers with a single atomic load and never calls into Objective-C.
+ *
+ * Usage example:
+ * @code
+ * g8::CancellationToken token;
+ * g8::TextMonitor monitor;
+ * monitor.setCancellationToken(token);
+ * // On another thread:
+ * token.cancel();
+ * @endcode
+ */
+class CancellationToken final {
+public:
+    /**
+     * Creates a token with a new, not cancelled flag.
+     */
+    CancellationToken();
+
+    /**
+     * Cancels the token and all of its copies. Can be called from any thread.
+     */
+    void cancel() const noexcept;
+
+    /**
+     * Whether the token has been cancelled.
+     */
+    bool isCancelled() const noexcept;
+
+    /**
+     * A G8CancelationCallback for ETEXT_DESC::cancel.
+     * @param flag The token's `flag()`, passed as ETEXT_DESC::cancel_this
+     * @param words Number of words processed, unused
+     * @return true if the token has been cancelled
+     */
+    static bool cancelCallback(void* flag, int words) noexcept;
+
+    /**
+     * The flag to pass to `cancelCallback`. Valid as long as a copy of the
+     * token exists.
+     */
+    void* flag() const noexcept;
+
+    /**
+     * Whether both tokens share the same flag.
+     */
+    bool operator==(const CancellationToken& other) const noexcept { return state_ == other.state_; }
+    bool operator!=(const CancellationToken& other) const noexcept { return state_ != other.state_; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state_;
+};
+
+} // namespace g8
+
+#endif /* G8Cancellation_h */
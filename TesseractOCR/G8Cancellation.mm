@@ -0,0 +1,25 @@
+#import "G8Cancellation.h"
+
+namespace g8 {
+
+CancellationToken::CancellationToken() : state_(std::make_shared<std::atomic<bool>>(false)) {
+}
+
+void CancellationToken::cancel() const noexcept {
+    state_->store(true, std::memory_order_relaxed);
+}
+
+bool CancellationToken::isCancelled() const noexcept {
+    return state_->load(std::memory_order_relaxed);
+}
+
+bool CancellationToken::cancelCallback(void* flag, int words) noexcept {
+    // Nothing is published through the flag, a relaxed load is enough
+    return static_cast<const std::atomic<bool>*>(flag)->load(std::memory_order_relaxed);
+}
+
+void* CancellationToken::flag() const noexcept {
+    return state_.get();
+}
+
+} // namespace g8
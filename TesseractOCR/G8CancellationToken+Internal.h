@@ -0,0 +1,20 @@
+//
+//  G8CancellationToken+Internal.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8CancellationToken.h"
+#import "G8Cancellation.h"
+
+@interface G8CancellationToken (Internal)
+
+/**
+ *  The token shared with the engines. Only import this header from
+ *  Objective-C++ files.
+ */
+- (const g8::CancellationToken &)token;
+
+@end
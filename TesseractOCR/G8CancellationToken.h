@@ -0,0 +1,33 @@
+//
+//  G8CancellationToken.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `G8CancellationToken` cancels recognitions from any thread. Assign the
+ *  same token to several `G8Tesseract` objects to cancel them all at once.
+ *
+ *  Tesseract checks the token for every word it recognizes with a single
+ *  atomic read, so it costs nothing measurable, unlike
+ *  `shouldCancelImageRecognitionForTesseract:` which calls the delegate
+ *  every time. Once cancelled, a token stays cancelled; assign a new one to
+ *  recognize again.
+ */
+@interface G8CancellationToken : NSObject
+
+/**
+ *  Whether `cancel` has been called.
+ */
+@property (nonatomic, assign, readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ *  Cancel all recognitions using this token, running or future ones.
+ */
+- (void)cancel;
+
+@end
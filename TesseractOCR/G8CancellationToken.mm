@@ -0,0 +1,33 @@
+//
+//  G8CancellationToken.mm
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8CancellationToken.h"
+#import "G8CancellationToken+Internal.h"
+
+@implementation G8CancellationToken {
+    g8::CancellationToken _token;
+}
+
+- (BOOL)isCancelled {
+    return _token.isCancelled();
+}
+
+- (void)cancel {
+    _token.cancel();
+}
+
+- (const g8::CancellationToken &)token {
+    return _token;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p%@>", NSStringFromClass([self class]), self,
+            self.isCancelled ? @" cancelled" : @""];
+}
+
+@end
@@ -0,0 +1,82 @@
+#ifndef G8CascadeRecognizer_h
+#define G8CascadeRecognizer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Cancellation.h"
+#import "G8ResultNode.h"
+
+#include <functional>
+#include <vector>
+
+// Forward declarations to avoid exposing Leptonica internals
+struct Pix;
+
+namespace g8 {
+
+struct EngineConfig;
+
+/**
+ * Which results `refineLowConfidence` re-recognizes, and how.
+ */
+struct CascadeOptions {
+    int confidenceThreshold = 80;    ///< Words or lines less confident than this are re-recognized, 0-100
+    int regionLevel = 3;             ///< tesseract::PageIteratorLevel re-recognized, RIL_TEXTLINE or RIL_WORD
+    int padding = 4;                 ///< Margin kept around each box, in pixels
+    int sourceResolution = 0;        ///< Resolution given to the engine, 0 to use the image's
+    int deadlineMsecs = 0;           ///< Time limit for the refinement, 0 for none
+    CancellationToken cancellation;  ///< Stops the refinement
+    std::function<bool()> shouldCancel;  ///< Polled during recognition if set
+};
+
+/**
+ * What a refinement did.
+ */
+struct CascadeStatistics {
+    size_t candidates = 0;     ///< Words or lines below the threshold
+    size_t recognized = 0;     ///< Candidates the accurate engine recognized
+    size_t replaced = 0;       ///< Candidates replaced by a more confident accurate result
+    double seconds = 0;        ///< Time spent re-recognizing
+    bool interrupted = false;  ///< Whether cancellation or the deadline left candidates with their first result
+};
+
+/**
+ * Second stage of a cascade: re-recognizes the words or lines of a page
+ * recognized by a fast engine whose confidence is below a threshold, with
+ * a slower, more accurate engine, and keeps whichever result is more
+ * confident. Most words are confident after the fast pass, so the page
+ * costs little more than the fast engine alone while the doubtful words
+ * get the accurate one.
+ *
+ * Every candidate is recognized on its own within its box, words as single
+ * words and lines as single lines; the accurate words replace the fast
+ * ones in place, and the text, confidence and box of the lines, paragraphs
+ * and blocks above them are updated. The engine comes from EnginePool and
+ * is created from accurateConfig when the pool has none.
+ *
+ * Usage example:
+ * @code
+ * fast.Recognize(nullptr);
+ * std::unique_ptr<tesseract::ResultIterator> iterator(fast.GetIterator());
+ * std::vector<g8::ResultNode> blocks = g8::buildResultTree(*iterator);
+ * g8::CascadeStatistics statistics;
+ * g8::refineLowConfidence(pix, accurateConfig, g8::CascadeOptions(), blocks, statistics);
+ * @endcode
+ *
+ * @param pix            The image the blocks were recognized from, not taken over
+ * @param accurateConfig Configuration of the accurate engine
+ * @param options        Threshold, level, deadline and cancellation
+ * @param blocks         The fast results, in image coordinates; refined in place
+ * @param statistics     Receives what was done
+ * @return false if the accurate engine couldn't be created, in which case
+ *         blocks are left as they are
+ */
+bool refineLowConfidence(Pix* pix,
+                         const EngineConfig& accurateConfig,
+                         const CascadeOptions& options,
+                         std::vector<ResultNode>& blocks,
+                         CascadeStatistics& statistics);
+
+} // namespace g8
+
+#endif /* G8CascadeRecognizer_h */
@@ -0,0 +1,280 @@
+#import "G8CascadeRecognizer.h"
+#import "G8Engine.h"
+#import "G8EnginePool.h"
+#import "G8TextMonitor.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+#import <Tesseract/ocrclass.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+
+namespace g8 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Tells the monitor of the accurate engine when to stop.
+ */
+class Interruption final {
+public:
+    explicit Interruption(const CascadeOptions& options) : options_(options) {
+        if (options.deadlineMsecs > 0) {
+            deadline_ = Clock::now() + std::chrono::milliseconds(options.deadlineMsecs);
+        }
+    }
+
+    /**
+     * Whether refinement was cancelled or timed out; latches once it
+     * returns true.
+     */
+    bool interrupted() {
+        if (!interrupted_) {
+            interrupted_ = options_.cancellation.isCancelled() ||
+                           (deadline_ != Clock::time_point() && Clock::now() >= deadline_) ||
+                           (options_.shouldCancel && options_.shouldCancel());
+        }
+        return interrupted_;
+    }
+
+    /**
+     * Milliseconds until the deadline, 0 if there's none.
+     */
+    int remainingMsecs() const {
+        if (deadline_ == Clock::time_point()) {
+            return 0;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now());
+        return std::max(1, static_cast<int>(remaining.count()));
+    }
+
+private:
+    const CascadeOptions& options_;
+    Clock::time_point deadline_;
+    bool interrupted_ = false;
+};
+
+bool cancelCallback(void* interruption, int words) {
+    return static_cast<Interruption*>(interruption)->interrupted();
+}
+
+/**
+ * The accurate engine, set up on the page image.
+ */
+class Refiner final {
+public:
+    Refiner(tesseract::TessBaseAPI& api, Pix* pix, const CascadeOptions& options, Interruption& interruption)
+        : api_(api), options_(options), interruption_(interruption),
+          width_(pixGetWidth(pix)), height_(pixGetHeight(pix)) {
+        api.SetImage(pix);
+        if (options.sourceResolution > 0) {
+            api.SetSourceResolution(options.sourceResolution);
+        }
+    }
+
+    /**
+     * Recognizes the box of a word or line on its own.
+     * @param words Receives the words found
+     * @return false if recognition failed or was interrupted
+     */
+    bool recognize(const ResultNode& region, std::vector<ResultNode>& words) {
+        const int left = std::max(0, region.left - options_.padding);
+        const int top = std::max(0, region.top - options_.padding);
+        const int right = std::min(width_, region.right + options_.padding);
+        const int bottom = std::min(height_, region.bottom + options_.padding);
+        if (right <= left || bottom <= top) {
+            return false;
+        }
+
+        api_.SetPageSegMode(region.level == tesseract::RIL_WORD ? tesseract::PSM_SINGLE_WORD
+                                                                 : tesseract::PSM_SINGLE_LINE);
+        api_.SetRectangle(left, top, right - left, bottom - top);
+        TextMonitor monitor(cancelCallback, &interruption_);
+        if (options_.deadlineMsecs > 0) {
+            monitor.setDeadline(interruption_.remainingMsecs());
+        }
+        if (api_.Recognize(monitor.get()) != 0 || interruption_.interrupted()) {
+            return false;
+        }
+
+        // Boxes are reported in image coordinates
+        std::unique_ptr<tesseract::ResultIterator> iterator(api_.GetIterator());
+        if (!iterator) {
+            return true;
+        }
+        for (const ResultNode* word : collectResultNodes(buildResultTree(*iterator), tesseract::RIL_WORD)) {
+            words.push_back(*word);
+        }
+        return true;
+    }
+
+private:
+    tesseract::TessBaseAPI& api_;
+    const CascadeOptions& options_;
+    Interruption& interruption_;
+    const int width_;
+    const int height_;
+};
+
+float meanConfidence(const std::vector<ResultNode>& nodes) {
+    float confidence = 0;
+    for (const auto& node : nodes) {
+        confidence += node.confidence;
+    }
+    return nodes.empty() ? 0 : confidence / nodes.size();
+}
+
+/**
+ * Recomputes the box and confidence of a node from its children, and its
+ * text: words separated by spaces for a line, the lines separated as
+ * ResultIterator does for a paragraph, the children's text otherwise.
+ */
+void summarize(ResultNode& node) {
+    if (node.children.empty()) {
+        return;
+    }
+    node.text.clear();
+    const ResultNode& first = node.children.front();
+    node.left = first.left;
+    node.top = first.top;
+    node.right = first.right;
+    node.bottom = first.bottom;
+    for (const auto& child : node.children) {
+        if (node.level == tesseract::RIL_TEXTLINE && !node.text.empty()) {
+            node.text += ' ';
+        }
+        node.text += child.text;
+        node.left = std::min(node.left, child.left);
+        node.top = std::min(node.top, child.top);
+        node.right = std::max(node.right, child.right);
+        node.bottom = std::max(node.bottom, child.bottom);
+    }
+    if (node.level == tesseract::RIL_TEXTLINE) {
+        node.text += '\n';
+    } else if (node.level == tesseract::RIL_PARA) {
+        // Gives a refined paragraph-final line its separator back
+        separateLines(node);
+    }
+    node.confidence = meanConfidence(node.children);
+}
+
+/**
+ * Refines the words of a line one by one, or the line as a whole.
+ * @return Whether anything was replaced
+ */
+bool refineLine(ResultNode& line, Refiner& refiner, Interruption& interruption, const CascadeOptions& options,
+                CascadeStatistics& statistics) {
+    const float threshold = static_cast<float>(options.confidenceThreshold);
+    if (options.regionLevel == tesseract::RIL_TEXTLINE) {
+        if (line.confidence >= threshold) {
+            return false;
+        }
+        ++statistics.candidates;
+        std::vector<ResultNode> words;
+        if (interruption.interrupted() || !refiner.recognize(line, words)) {
+            return false;
+        }
+        ++statistics.recognized;
+        if (words.empty() || meanConfidence(words) <= line.confidence) {
+            return false;
+        }
+        ++statistics.replaced;
+        line.children = std::move(words);
+        return true;
+    }
+
+    bool replaced = false;
+    std::vector<ResultNode> refined;
+    refined.reserve(line.children.size());
+    for (auto& word : line.children) {
+        std::vector<ResultNode> words;
+        if (word.confidence < threshold) {
+            ++statistics.candidates;
+            if (!interruption.interrupted() && refiner.recognize(word, words)) {
+                ++statistics.recognized;
+            }
+        }
+        // A word may come back split in several
+        if (!words.empty() && meanConfidence(words) > word.confidence) {
+            ++statistics.replaced;
+            replaced = true;
+            std::move(words.begin(), words.end(), std::back_inserter(refined));
+        } else {
+            refined.push_back(std::move(word));
+        }
+    }
+    line.children = std::move(refined);
+    return replaced;
+}
+
+} // namespace
+
+bool refineLowConfidence(Pix* pix,
+                         const EngineConfig& accurateConfig,
+                         const CascadeOptions& options,
+                         std::vector<ResultNode>& blocks,
+                         CascadeStatistics& statistics) {
+    statistics = CascadeStatistics();
+    if (!pix) {
+        return false;
+    }
+    const auto start = Clock::now();
+
+    std::unique_ptr<Engine> engine;
+    tesseract::PageSegMode pageSegMode = tesseract::PSM_SINGLE_BLOCK;
+    Interruption interruption(options);
+    std::unique_ptr<Refiner> refiner;
+    for (auto& block : blocks) {
+        bool blockChanged = false;
+        for (auto& paragraph : block.children) {
+            bool paragraphChanged = false;
+            for (auto& line : paragraph.children) {
+                if (!refiner) {
+                    // Pages the fast engine got right don't need the accurate one
+                    const bool needed = std::any_of(line.children.begin(), line.children.end(), [&](const ResultNode& word) {
+                        return word.confidence < options.confidenceThreshold;
+                    }) || (options.regionLevel == tesseract::RIL_TEXTLINE && line.confidence < options.confidenceThreshold);
+                    if (!needed) {
+                        continue;
+                    }
+                    engine = EnginePool::shared().acquire(accurateConfig);
+                    if (!engine) {
+                        engine = Engine::create(accurateConfig);
+                    }
+                    if (!engine) {
+                        return false;
+                    }
+                    pageSegMode = engine->api()->GetPageSegMode();
+                    refiner = std::make_unique<Refiner>(*engine->api(), pix, options, interruption);
+                }
+                if (refineLine(line, *refiner, interruption, options, statistics)) {
+                    summarize(line);
+                    paragraphChanged = true;
+                }
+            }
+            if (paragraphChanged) {
+                summarize(paragraph);
+                blockChanged = true;
+            }
+        }
+        if (blockChanged) {
+            summarize(block);
+        }
+    }
+
+    if (engine) {
+        tesseract::TessBaseAPI* api = engine->api();
+        api->Clear();
+        api->SetPageSegMode(pageSegMode);
+        EnginePool::shared().release(std::move(engine));
+    }
+    statistics.interrupted = interruption.interrupted() && statistics.recognized < statistics.candidates;
+    statistics.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return true;
+}
+
+} // namespace g8
@@ -0,0 +1,148 @@
+#ifndef G8ConcurrencyGovernor_h
+#define G8ConcurrencyGovernor_h
+
+#import <Foundation/Foundation.h>
+
+#include <mutex>
+
+namespace g8 {
+
+/**
+ * Counters of a ConcurrencyGovernor.
+ */
+struct ConcurrencyStatistics {
+    size_t coresInUse = 0;     ///< Threads granted to the leases held now
+    size_t leases = 0;         ///< Recognitions running now
+    size_t pending = 0;        ///< Recognitions queued and not started
+    size_t wideLeases = 0;     ///< Leases granted more than one thread so far
+    size_t narrowLeases = 0;   ///< Leases that asked for more than one thread and got one
+};
+
+/**
+ * Shares a budget of cores between engines in flight (outer parallelism)
+ * and the threads each of them recognizes a page with (inner parallelism),
+ * so that several queues each splitting their pages don't oversubscribe the
+ * processor.
+ *
+ * Every recognition holds a Lease while it runs. A recognition that can
+ * split its page asks for several threads and gets a fair share of the
+ * budget: all free cores when it runs alone, a single thread when other
+ * recognitions run or are queued. With many pages in flight the pages
+ * are recognized by many narrow engines, with a single page by one wide one.
+ * Queues report the work they hold back with `addPending`, so that an
+ * early lease doesn't take the cores later ones need.
+ *
+ * Leases never block; the budget only shapes the width of new leases.
+ *
+ * Usage example:
+ * @code
+ * g8::ConcurrencyGovernor::Lease lease = g8::ConcurrencyGovernor::shared().acquire(8);
+ * if (lease.width() > 1) {
+ *     options.concurrency = lease.width();
+ *     g8::recognizeInParallel(api, config, options, result);
+ * } else {
+ *     api.Recognize(monitor.get());
+ * }
+ * @endcode
+ */
+class ConcurrencyGovernor final {
+public:
+    /**
+     * Threads granted to one recognition, returned to the governor when the
+     * lease goes away.
+     */
+    class Lease final {
+    public:
+        Lease() = default;
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        /**
+         * Number of threads the recognition may use, at least 1 for an
+         * acquired lease.
+         */
+        size_t width() const noexcept { return width_; }
+
+    private:
+        friend class ConcurrencyGovernor;
+        Lease(ConcurrencyGovernor* governor, size_t width) noexcept : governor_(governor), width_(width) {}
+
+        ConcurrencyGovernor* governor_ = nullptr;
+        size_t width_ = 0;
+    };
+
+    /**
+     * The shared governor instance.
+     */
+    static ConcurrencyGovernor& shared();
+
+    /**
+     * @param coreBudget Threads all recognitions may use together, 0 for
+     *                   one per processor core
+     */
+    explicit ConcurrencyGovernor(size_t coreBudget = 0);
+
+    ConcurrencyGovernor(const ConcurrencyGovernor&) = delete;
+    ConcurrencyGovernor& operator=(const ConcurrencyGovernor&) = delete;
+
+    /**
+     * Sets the budget for new leases. 0 for one thread per processor core.
+     */
+    void setCoreBudget(size_t coreBudget);
+
+    /**
+     * The budget in threads.
+     */
+    size_t coreBudget() const;
+
+    /**
+     * Starts a recognition.
+     * @param maximumWidth Threads the recognition could use, 1 if it can't
+     *                     split its page
+     * @return The lease, between 1 and maximumWidth threads wide
+     */
+    Lease acquire(size_t maximumWidth);
+
+    /**
+     * Reports recognitions queued for later, which reserve their share of
+     * the budget.
+     */
+    void addPending(size_t count = 1) noexcept;
+
+    /**
+     * Reports queued recognitions as started or dropped.
+     */
+    void removePending(size_t count = 1) noexcept;
+
+    /**
+     * Current load and counters.
+     */
+    ConcurrencyStatistics statistics() const;
+
+    /**
+     * Threads in use plus recognitions pending, per thread of the budget;
+     * above 1 once work waits for cores.
+     */
+    double load() const;
+
+    /**
+     * Resets the wide and narrow lease counters.
+     */
+    void resetStatistics();
+
+private:
+    void release(size_t width) noexcept;
+
+    mutable std::mutex mutex_;
+    size_t coreBudget_ = 0;
+    ConcurrencyStatistics statistics_;
+};
+
+} // namespace g8
+
+#endif /* G8ConcurrencyGovernor_h */
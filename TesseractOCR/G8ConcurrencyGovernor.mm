@@ -0,0 +1,109 @@
+#import "G8ConcurrencyGovernor.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace g8 {
+
+namespace {
+
+size_t defaultCoreBudget() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+} // namespace
+
+ConcurrencyGovernor::Lease::~Lease() {
+    if (governor_) {
+        governor_->release(width_);
+    }
+}
+
+ConcurrencyGovernor::Lease::Lease(Lease&& other) noexcept : governor_(other.governor_), width_(other.width_) {
+    other.governor_ = nullptr;
+    other.width_ = 0;
+}
+
+ConcurrencyGovernor::Lease& ConcurrencyGovernor::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (governor_) {
+            governor_->release(width_);
+        }
+        governor_ = other.governor_;
+        width_ = other.width_;
+        other.governor_ = nullptr;
+        other.width_ = 0;
+    }
+    return *this;
+}
+
+ConcurrencyGovernor& ConcurrencyGovernor::shared() {
+    static ConcurrencyGovernor governor;
+    return governor;
+}
+
+ConcurrencyGovernor::ConcurrencyGovernor(size_t coreBudget)
+    : coreBudget_(coreBudget > 0 ? coreBudget : defaultCoreBudget()) {
+}
+
+void ConcurrencyGovernor::setCoreBudget(size_t coreBudget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    coreBudget_ = coreBudget > 0 ? coreBudget : defaultCoreBudget();
+}
+
+size_t ConcurrencyGovernor::coreBudget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coreBudget_;
+}
+
+ConcurrencyGovernor::Lease ConcurrencyGovernor::acquire(size_t maximumWidth) {
+    maximumWidth = std::max<size_t>(maximumWidth, 1);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Split the budget evenly over everything running or waiting, and never
+    // hand out cores other leases already hold
+    const size_t freeCores = coreBudget_ > statistics_.coresInUse ? coreBudget_ - statistics_.coresInUse : 0;
+    const size_t fairShare = coreBudget_ / (statistics_.leases + statistics_.pending + 1);
+    const size_t width = std::clamp<size_t>(std::min(freeCores, fairShare), 1, maximumWidth);
+
+    if (maximumWidth > 1) {
+        ++(width > 1 ? statistics_.wideLeases : statistics_.narrowLeases);
+    }
+    statistics_.coresInUse += width;
+    ++statistics_.leases;
+    return Lease(this, width);
+}
+
+void ConcurrencyGovernor::addPending(size_t count) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.pending += count;
+}
+
+void ConcurrencyGovernor::removePending(size_t count) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.pending -= std::min(count, statistics_.pending);
+}
+
+ConcurrencyStatistics ConcurrencyGovernor::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+double ConcurrencyGovernor::load() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<double>(statistics_.coresInUse + statistics_.pending) / static_cast<double>(coreBudget_);
+}
+
+void ConcurrencyGovernor::resetStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.wideLeases = 0;
+    statistics_.narrowLeases = 0;
+}
+
+void ConcurrencyGovernor::release(size_t width) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.coresInUse -= std::min(width, statistics_.coresInUse);
+    statistics_.leases -= std::min<size_t>(1, statistics_.leases);
+}
+
+} // namespace g8
@@ -184,4 +184,135 @@ typedef NS_ENUM(NSUInteger, G8TextlineOrder) {
     G8TextlineOrderTopToBottom,
 };
 
+/**
+ *  Kinds of memory accounted for by the memory budget of `G8Tesseract`.
+ */
+typedef NS_ENUM(NSUInteger, G8MemoryKind) {
+    /**
+     *  An initialized, currently unused engine.
+     */
+    G8MemoryKindEngine,
+    /**
+     *  Raw traineddata bytes kept for fast engine initialization, see
+     *  `cachesTrainedData`.
+     */
+    G8MemoryKindModel,
+};
+
+/**
+ *  Severity of a memory pressure signal.
+ */
+typedef NS_ENUM(NSUInteger, G8MemoryPressureLevel) {
+    /**
+     *  Release about half of the cached memory, least recently used first.
+     */
+    G8MemoryPressureLevelModerate,
+    /**
+     *  Release all cached memory, including Tesseract's dictionary cache.
+     */
+    G8MemoryPressureLevelCritical,
+};
+
+/**
+ *  How `G8Tesseract` splits a page for recognition on several threads.
+ */
+typedef NS_ENUM(NSUInteger, G8ParallelRecognitionMode) {
+    /**
+     *  Recognize the page with a single engine.
+     */
+    G8ParallelRecognitionModeNone,
+    /**
+     *  Recognize each text block found by layout analysis with its own engine.
+     */
+    G8ParallelRecognitionModeBlocks,
+    /**
+     *  Recognize each paragraph found by layout analysis with its own engine.
+     *  Finer grained than blocks, so it keeps more threads busy on pages
+     *  with few large blocks.
+     */
+    G8ParallelRecognitionModeParagraphs,
+    /**
+     *  Recognize each text line found by layout analysis with its own engine.
+     *  Keeps threads busy even on single column pages, where splitting by
+     *  blocks gives no parallelism. Blocks and paragraphs are taken from
+     *  layout analysis.
+     */
+    G8ParallelRecognitionModeTextlines,
+};
+
+/**
+ *  The order in which `G8Tesseract` recognizes the regions of a page, so
+ *  that the most valuable text is done first when `maximumRecognitionTime`
+ *  runs out.
+ */
+typedef NS_ENUM(NSUInteger, G8RegionPriority) {
+    /**
+     *  Reading order of the layout.
+     */
+    G8RegionPriorityReadingOrder,
+    /**
+     *  Regions nearest to the center of the page first, e.g. for a document
+     *  framed by the camera.
+     */
+    G8RegionPriorityCenterFirst,
+    /**
+     *  Largest regions first, where most of the text usually is.
+     */
+    G8RegionPriorityLargestFirst,
+};
+
+/**
+ *  Priority classes of `G8RecognitionScheduler`, most urgent first.
+ */
+typedef NS_ENUM(NSUInteger, G8RecognitionPriority) {
+    /**
+     *  A user is waiting for the result, e.g. a single field scan.
+     */
+    G8RecognitionPriorityInteractive,
+    /**
+     *  Regular recognitions.
+     */
+    G8RecognitionPriorityDefault,
+    /**
+     *  Bulk work, e.g. document batches. Runs only while no more urgent
+     *  recognition is waiting.
+     */
+    G8RecognitionPriorityBackground,
+};
+
+/**
+ *  What `G8RecognitionScheduler` does with a recognition that is expected to
+ *  miss its deadline.
+ */
+typedef NS_ENUM(NSUInteger, G8OverloadPolicy) {
+    /**
+     *  Don't run the recognition.
+     */
+    G8OverloadPolicyReject,
+    /**
+     *  Run the recognition with `maximumRecognitionTime` cut down to the
+     *  time left before the deadline, which may give partial results.
+     */
+    G8OverloadPolicyDegrade,
+};
+
+/**
+ *  How a recognition scheduled by `G8RecognitionScheduler` ended.
+ */
+typedef NS_ENUM(NSUInteger, G8SchedulingOutcome) {
+    /**
+     *  The recognition ran in full.
+     */
+    G8SchedulingOutcomeCompleted,
+    /**
+     *  The recognition ran with a shortened time limit, see
+     *  `G8OverloadPolicyDegrade`.
+     */
+    G8SchedulingOutcomeDegraded,
+    /**
+     *  The recognition didn't run since it couldn't make its deadline.
+     */
+    G8SchedulingOutcomeRejected,
+};
+
 #endif
@@ -0,0 +1,258 @@
+#ifndef G8Coroutine_h
+#define G8Coroutine_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8TaskPool.h"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace g8 {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * Promise state common to all tasks: the coroutine awaiting the task is
+ * resumed directly when the task finishes, without going through a queue.
+ */
+class TaskPromiseBase {
+public:
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+            return handle.promise().continuation_;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void setContinuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+protected:
+    void rethrowIfFailed() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+    std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename Value>
+    void return_value(Value&& value) {
+        value_.emplace(std::forward<Value>(value));
+    }
+
+    T result() {
+        rethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void result() const { rethrowIfFailed(); }
+};
+
+/**
+ * Fire-and-forget coroutine that starts right away and frees itself at the
+ * end; used to start a task from ordinary code.
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+} // namespace detail
+
+/**
+ * A lazily started coroutine producing a T. The task runs when it's awaited
+ * and resumes its awaiter on whatever thread it finishes on; nothing blocks
+ * in between, so a few threads can keep many tasks in flight.
+ *
+ * Tasks are move-only and destroy their coroutine when they go away, so a
+ * task must be awaited, passed to `spawn` or `blockingWait`, or dropped
+ * before it starts. Exceptions thrown by the coroutine are rethrown to the
+ * awaiter.
+ *
+ * @note Reference parameters of a coroutine are kept as references: the
+ *       referenced objects have to outlive the task, which they do when the
+ *       task is awaited right away.
+ *
+ * Usage example:
+ * @code
+ * g8::Task<int> answer(g8::TaskPool& pool) {
+ *     co_await g8::resumeOn(pool);
+ *     co_return 42;
+ * }
+ *
+ * g8::Task<> printAnswer(g8::TaskPool& pool) {
+ *     printf("%d\n", co_await answer(pool));
+ * }
+ * @endcode
+ */
+template <typename T>
+class [[nodiscard]] Task final {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    explicit Task(Handle handle) noexcept : handle_(handle) {}
+
+    ~Task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+        handle_.promise().setContinuation(awaiter);
+        return handle_;
+    }
+
+    T await_resume() { return handle_.promise().result(); }
+
+private:
+    Handle handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+template <typename T, typename Completion>
+DetachedTask runDetached(Task<T> task, Completion completion) {
+    if constexpr (std::is_void_v<T>) {
+        co_await std::move(task);
+        completion();
+    } else {
+        completion(co_await std::move(task));
+    }
+}
+
+} // namespace detail
+
+/**
+ * Awaitable moving the awaiting coroutine onto a worker of pool. Awaiting it
+ * on one of pool's workers continues right away.
+ */
+class ResumeOn final {
+public:
+    explicit ResumeOn(TaskPool& pool) noexcept : pool_(pool) {}
+
+    bool await_ready() const noexcept { return pool_.workerIndex() != TaskPool::npos; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        pool_.submit([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    TaskPool& pool_;
+};
+
+/**
+ * Continues the awaiting coroutine on a worker of pool.
+ */
+inline ResumeOn resumeOn(TaskPool& pool) noexcept {
+    return ResumeOn(pool);
+}
+
+/**
+ * Starts task and calls completion with its result on the thread it
+ * finishes on. The task must not throw.
+ */
+template <typename T, typename Completion>
+void spawn(Task<T> task, Completion completion) {
+    detail::runDetached(std::move(task), std::move(completion));
+}
+
+/**
+ * Starts task and blocks until it has finished, e.g. in tests or tools.
+ * Must not be called from a worker of a pool the task needs.
+ * @return The task's result; its exception is rethrown
+ */
+template <typename T>
+T blockingWait(Task<T> task) {
+    // Shared, so that the promise outlives set_value even if get returns first
+    auto promise = std::make_shared<std::promise<T>>();
+    std::future<T> future = promise->get_future();
+    auto wrapper = [](Task<T> task, std::shared_ptr<std::promise<T>> promise) -> detail::DetachedTask {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                co_await std::move(task);
+                promise->set_value();
+            } else {
+                promise->set_value(co_await std::move(task));
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+    wrapper(std::move(task), promise);
+    return future.get();
+}
+
+} // namespace g8
+
+#endif /* G8Coroutine_h */
@@ -0,0 +1,245 @@
+#ifndef G8Engine_h
+#define G8Engine_h
+
+#import <Foundation/Foundation.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Tesseract internals
+namespace tesseract {
+class TessBaseAPI;
+}
+
+namespace g8 {
+
+/**
+ * Everything needed to bring a TessBaseAPI into a given state.
+ * Two engines created from equal configurations are interchangeable.
+ */
+struct EngineConfig {
+    std::string dataPath;                             ///< tessdata folder (trailing slash)
+    std::string language;                             ///< e.g. "eng" or "eng+deu"
+    int engineMode = 3;                               ///< tesseract::OcrEngineMode, OEM_DEFAULT
+    std::vector<std::string> configFiles;             ///< tessconfigs/configs file names
+    std::map<std::string, std::string> initVariables; ///< init-only variables
+    std::map<std::string, std::string> variables;     ///< runtime variables
+
+    bool operator==(const EngineConfig& other) const;
+    bool operator!=(const EngineConfig& other) const { return !(*this == other); }
+
+    /**
+     * A stable string identifying this configuration, usable as a map key.
+     */
+    std::string key() const;
+
+    /**
+     * Paths of the traineddata files Tesseract loads for this configuration;
+     * languages excluded with a "~" prefix are skipped.
+     */
+    std::vector<std::string> trainedDataPaths() const;
+};
+
+/**
+ * A timed step of engine initialization.
+ */
+struct StartupPhase {
+    std::string name;    ///< One of the kStartupPhase names
+    double seconds = 0;  ///< Wall time spent in this phase
+    size_t bytes = 0;    ///< Bytes read from storage during this phase
+};
+
+/// Reading traineddata, from storage or from TrainedDataCache
+extern const char* const kStartupPhaseRead;
+/// Reading the component table of each traineddata file
+extern const char* const kStartupPhaseIndex;
+/// Tesseract's Init apart from reading: config files, unicharsets,
+/// dictionaries, classifier templates and LSTM deserialization
+extern const char* const kStartupPhaseModel;
+/// Applying runtime variables
+extern const char* const kStartupPhaseVariables;
+
+/**
+ * Where the time of one engine initialization went.
+ *
+ * @note Tesseract parses all components inside Init without hooks, so their
+ *       deserialization is reported as a single phase; `componentBytes`
+ *       tells which components it had to deal with.
+ */
+struct StartupProfile {
+    std::vector<StartupPhase> phases;  ///< In execution order
+    std::vector<size_t> componentBytes; ///< Per TrainedDataComponent, summed over languages
+    size_t cachedBytes = 0;            ///< Traineddata bytes served from TrainedDataCache
+
+    /**
+     * Sum of all phase durations.
+     */
+    double totalSeconds() const;
+
+    /**
+     * Bytes read from storage in all phases.
+     */
+    size_t bytesRead() const;
+};
+
+/**
+ * Process-wide cache of raw traineddata bytes keyed by absolute path.
+ * Tesseract reads traineddata through `readFile`; while the cache is
+ * enabled, every engine after the first one for a language skips the file
+ * system entirely. It is disabled by default and `readFile` then reads
+ * straight from storage.
+ *
+ * @note Tesseract deserializes its own copy of each component, so the cache
+ *       saves I/O, not the per-engine model memory or the time Init spends
+ *       deserializing, and it costs a resident copy of every file it holds.
+ *       Dictionaries are shared between engines by Tesseract's own dawg
+ *       cache. The cached bytes count against the MemoryGovernor budget and
+ *       are evicted least recently used first.
+ */
+class TrainedDataCache final {
+public:
+    using Buffer = std::shared_ptr<const std::vector<char>>;
+
+    /**
+     * The shared cache instance.
+     */
+    static TrainedDataCache& shared();
+
+    /**
+     * Enables or disables caching. Disabling drops all cached files.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Whether files read through `load` and `readFile` are kept.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Returns the bytes of the file at path, reading it on first use.
+     * The bytes are kept only while the cache is enabled.
+     * @param path Absolute file path
+     * @param cached If not nullptr, set to whether the file was already cached
+     * @return The file contents or nullptr if the file can't be read
+     */
+    Buffer load(const std::string& path, bool* cached = nullptr);
+
+    /**
+     * Drops the cached bytes of a single file.
+     * @return Number of bytes released
+     */
+    size_t evict(const std::string& path);
+
+    /**
+     * Drops all cached files.
+     */
+    void clear();
+
+    /**
+     * Total number of cached bytes.
+     */
+    size_t byteCount() const;
+
+    /**
+     * Tesseract FileReader serving files from the shared cache, or from
+     * storage while it is disabled.
+     */
+    static bool readFile(const char* filename, std::vector<char>* data);
+
+    TrainedDataCache(const TrainedDataCache&) = delete;
+    TrainedDataCache& operator=(const TrainedDataCache&) = delete;
+
+private:
+    TrainedDataCache() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Buffer> buffers_;
+    bool enabled_ = false;
+};
+
+/**
+ * Initializes api with config, reading traineddata through TrainedDataCache.
+ * @param profile If not nullptr, receives the timing of each phase
+ * @return Tesseract's Init return code, 0 on success
+ */
+int initializeAPI(tesseract::TessBaseAPI& api, const EngineConfig& config, StartupProfile* profile = nullptr);
+
+/**
+ * An initialized TessBaseAPI together with the configuration it was built
+ * from. Engines are not thread-safe; use one engine per thread.
+ *
+ * Usage example:
+ * @code
+ * auto first = g8::Engine::create(config);
+ * std::vector<std::unique_ptr<g8::Engine>> workers;
+ * for (int i = 0; i < 8; ++i) {
+ *     workers.push_back(first->recreate());
+ * }
+ * @endcode
+ */
+class Engine final {
+public:
+    /**
+     * Creates and initializes a new engine.
+     * @param config Engine configuration
+     * @return The engine or nullptr if Tesseract failed to initialize
+     */
+    static std::unique_ptr<Engine> create(const EngineConfig& config);
+
+    ~Engine();
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    /**
+     * Initializes a new engine from this one's configuration, including
+     * runtime variables set after initialization. Nothing is shared with
+     * this engine: Init runs in full, only the traineddata is read from
+     * TrainedDataCache rather than from storage while the cache is enabled.
+     * @return The new engine or nullptr if initialization failed
+     */
+    std::unique_ptr<Engine> recreate() const;
+
+    /**
+     * Sets a runtime variable and remembers it for `recreate`.
+     * @return true if Tesseract accepted the variable
+     */
+    bool setVariable(const std::string& name, const std::string& value);
+
+    /**
+     * Access the underlying TessBaseAPI.
+     * @return Raw TessBaseAPI pointer (never nullptr)
+     */
+    tesseract::TessBaseAPI* api() const noexcept;
+
+    /**
+     * Hands the underlying TessBaseAPI over to the caller, e.g. to adopt a
+     * pooled engine. The engine must not be used afterwards.
+     * @return The TessBaseAPI, owned by the caller
+     */
+    std::unique_ptr<tesseract::TessBaseAPI> releaseAPI() noexcept;
+
+    /**
+     * The configuration this engine currently reflects.
+     */
+    const EngineConfig& config() const noexcept;
+
+    /**
+     * How long it took to initialize this engine.
+     */
+    const StartupProfile& startupProfile() const noexcept;
+
+private:
+    explicit Engine(const EngineConfig& config);
+
+    EngineConfig config_;
+    std::unique_ptr<tesseract::TessBaseAPI> api_;
+    StartupProfile startupProfile_;
+};
+
+} // namespace g8
+
+#endif /* G8Engine_h */
@@ -0,0 +1,386 @@
+#import "G8Engine.h"
+#import "G8MemoryGovernor.h"
+#import "G8TrainedData.h"
+#import <Tesseract/baseapi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace g8 {
+
+#pragma mark - EngineConfig
+
+bool EngineConfig::operator==(const EngineConfig& other) const {
+    return dataPath == other.dataPath &&
+           language == other.language &&
+           engineMode == other.engineMode &&
+           configFiles == other.configFiles &&
+           initVariables == other.initVariables &&
+           variables == other.variables;
+}
+
+std::string EngineConfig::key() const {
+    std::ostringstream stream;
+    stream << dataPath << '\x1f' << language << '\x1f' << engineMode;
+    for (const auto& file : configFiles) {
+        stream << '\x1f' << file;
+    }
+    stream << '\x1e';
+    for (const auto& pair : initVariables) {
+        stream << pair.first << '=' << pair.second << '\x1f';
+    }
+    stream << '\x1e';
+    for (const auto& pair : variables) {
+        stream << pair.first << '=' << pair.second << '\x1f';
+    }
+    return stream.str();
+}
+
+std::vector<std::string> EngineConfig::trainedDataPaths() const {
+    std::vector<std::string> paths;
+    std::istringstream stream(language);
+    std::string part;
+    while (std::getline(stream, part, '+')) {
+        if (!part.empty() && part[0] != '~') {
+            paths.push_back(dataPath + part + ".traineddata");
+        }
+    }
+    return paths;
+}
+
+#pragma mark - StartupProfile
+
+const char* const kStartupPhaseRead = "read";
+const char* const kStartupPhaseIndex = "index";
+const char* const kStartupPhaseModel = "model";
+const char* const kStartupPhaseVariables = "variables";
+
+double StartupProfile::totalSeconds() const {
+    double total = 0;
+    for (const auto& phase : phases) {
+        total += phase.seconds;
+    }
+    return total;
+}
+
+size_t StartupProfile::bytesRead() const {
+    size_t total = 0;
+    for (const auto& phase : phases) {
+        total += phase.bytes;
+    }
+    return total;
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Profile of the initialization running on this thread, if any. Tesseract
+// calls the file reader synchronously from Init, so this reaches readFile.
+thread_local StartupProfile* currentProfile = nullptr;
+
+/**
+ * Publishes a profile to readFile for the lifetime of the scope.
+ */
+class ProfileScope final {
+public:
+    explicit ProfileScope(StartupProfile& profile) { currentProfile = &profile; }
+    ~ProfileScope() { currentProfile = nullptr; }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+StartupPhase& phaseNamed(StartupProfile& profile, const char* name) {
+    for (auto& phase : profile.phases) {
+        if (phase.name == name) {
+            return phase;
+        }
+    }
+    profile.phases.push_back(StartupPhase{name});
+    return profile.phases.back();
+}
+
+} // namespace
+
+#pragma mark - TrainedDataCache
+
+TrainedDataCache& TrainedDataCache::shared() {
+    static TrainedDataCache cache;
+    return cache;
+}
+
+namespace {
+std::string memoryKeyForPath(const std::string& path) {
+    return "model:" + path;
+}
+
+bool readWholeFile(const std::string& path, std::vector<char>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamsize size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return size == 0 || static_cast<bool>(file.read(data.data(), size));
+}
+}
+
+void TrainedDataCache::setEnabled(bool enabled) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enabled_ = enabled;
+    }
+    if (!enabled) {
+        clear();
+    }
+}
+
+bool TrainedDataCache::isEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return enabled_;
+}
+
+TrainedDataCache::Buffer TrainedDataCache::load(const std::string& path, bool* cached) {
+    bool enabled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        enabled = enabled_;
+        auto it = buffers_.find(path);
+        if (it != buffers_.end()) {
+            MemoryGovernor::shared().touch(memoryKeyForPath(path));
+            if (cached) {
+                *cached = true;
+            }
+            return it->second;
+        }
+    }
+    if (cached) {
+        *cached = false;
+    }
+
+    // Read outside the lock so that loading one language doesn't block others
+    auto bytes = std::make_shared<std::vector<char>>();
+    if (!readWholeFile(path, *bytes)) {
+        return nullptr;
+    }
+    if (!enabled) {
+        return bytes;
+    }
+
+    Buffer buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_) {
+            return bytes;
+        }
+        // Another thread may have won the race; keep the first buffer
+        buffer = buffers_.emplace(path, std::move(bytes)).first->second;
+    }
+
+    // Track outside of our lock, since the governor may call back into evict
+    MemoryGovernor::shared().track(memoryKeyForPath(path), MemoryKind::Model, buffer->size(), [path] {
+        return TrainedDataCache::shared().evict(path);
+    });
+    return buffer;
+}
+
+size_t TrainedDataCache::evict(const std::string& path) {
+    size_t size = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = buffers_.find(path);
+        if (it == buffers_.end()) {
+            return 0;
+        }
+        size = it->second->size();
+        buffers_.erase(it);
+    }
+    MemoryGovernor::shared().untrack(memoryKeyForPath(path));
+    return size;
+}
+
+void TrainedDataCache::clear() {
+    std::map<std::string, Buffer> buffers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers.swap(buffers_);
+    }
+    for (const auto& pair : buffers) {
+        MemoryGovernor::shared().untrack(memoryKeyForPath(pair.first));
+    }
+}
+
+size_t TrainedDataCache::byteCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& pair : buffers_) {
+        total += pair.second->size();
+    }
+    return total;
+}
+
+bool TrainedDataCache::readFile(const char* filename, std::vector<char>* data) {
+    if (!filename || !data) {
+        return false;
+    }
+    StartupProfile* profile = currentProfile;
+    auto start = Clock::now();
+
+    // Tesseract keeps its own vector, so without the cache read straight
+    // into it rather than into a buffer that is copied and dropped
+    bool cached = false;
+    if (shared().isEnabled()) {
+        Buffer buffer = shared().load(filename, &cached);
+        if (!buffer) {
+            return false;
+        }
+        data->assign(buffer->begin(), buffer->end());
+    } else if (!readWholeFile(filename, *data)) {
+        return false;
+    }
+    if (!profile) {
+        return true;
+    }
+
+    StartupPhase& read = phaseNamed(*profile, kStartupPhaseRead);
+    read.seconds += secondsSince(start);
+    if (cached) {
+        profile->cachedBytes += data->size();
+    } else {
+        read.bytes += data->size();
+    }
+
+    start = Clock::now();
+    std::vector<size_t> sizes;
+    if (TrainedData::index(data->data(), data->size(), sizes)) {
+        profile->componentBytes.resize(sizes.size());
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            profile->componentBytes[i] += sizes[i];
+        }
+    }
+    phaseNamed(*profile, kStartupPhaseIndex).seconds += secondsSince(start);
+    return true;
+}
+
+#pragma mark - Initialization
+
+int initializeAPI(tesseract::TessBaseAPI& api, const EngineConfig& config, StartupProfile* profile) {
+    StartupProfile localProfile;
+    StartupProfile& startup = profile ? *profile : localProfile;
+    startup = StartupProfile();
+    for (const char* name : {kStartupPhaseRead, kStartupPhaseIndex, kStartupPhaseModel, kStartupPhaseVariables}) {
+        startup.phases.push_back(StartupPhase{name});
+    }
+
+    std::vector<std::string> varsVec;
+    std::vector<std::string> varsValues;
+    varsVec.reserve(config.initVariables.size());
+    varsValues.reserve(config.initVariables.size());
+    for (const auto& pair : config.initVariables) {
+        varsVec.push_back(pair.first);
+        varsValues.push_back(pair.second);
+    }
+
+    // Tesseract wants mutable C strings for the config file names
+    std::vector<std::unique_ptr<char[]>> configPtrs;
+    std::vector<char*> configs;
+    configPtrs.reserve(config.configFiles.size());
+    configs.reserve(config.configFiles.size());
+    for (const auto& file : config.configFiles) {
+        auto ptr = std::make_unique<char[]>(file.size() + 1);
+        std::memcpy(ptr.get(), file.c_str(), file.size() + 1);
+        configs.push_back(ptr.get());
+        configPtrs.push_back(std::move(ptr));
+    }
+
+    // A zero data size makes Tesseract treat `data` as the datapath and load
+    // every traineddata file through the reader, i.e. through our cache.
+    auto start = Clock::now();
+    int returnCode;
+    {
+        ProfileScope scope(startup);
+        returnCode = api.Init(config.dataPath.c_str(),
+                              0,
+                              config.language.c_str(),
+                              static_cast<tesseract::OcrEngineMode>(config.engineMode),
+                              configs.empty() ? nullptr : configs.data(),
+                              static_cast<int>(configs.size()),
+                              varsVec.empty() ? nullptr : &varsVec,
+                              varsValues.empty() ? nullptr : &varsValues,
+                              false,
+                              &TrainedDataCache::readFile);
+    }
+    double initSeconds = secondsSince(start);
+
+    // Reading and indexing happened inside Init; the rest is Tesseract's own
+    const StartupPhase& read = phaseNamed(startup, kStartupPhaseRead);
+    const StartupPhase& index = phaseNamed(startup, kStartupPhaseIndex);
+    phaseNamed(startup, kStartupPhaseModel).seconds = std::max(0.0, initSeconds - read.seconds - index.seconds);
+    if (returnCode != 0) {
+        return returnCode;
+    }
+
+    start = Clock::now();
+    for (const auto& pair : config.variables) {
+        api.SetVariable(pair.first.c_str(), pair.second.c_str());
+    }
+    phaseNamed(startup, kStartupPhaseVariables).seconds = secondsSince(start);
+    return 0;
+}
+
+#pragma mark - Engine
+
+Engine::Engine(const EngineConfig& config)
+    : config_(config), api_(std::make_unique<tesseract::TessBaseAPI>()) {
+}
+
+Engine::~Engine() = default;
+
+std::unique_ptr<Engine> Engine::create(const EngineConfig& config) {
+    std::unique_ptr<Engine> engine(new Engine(config));
+    if (initializeAPI(*engine->api_, engine->config_, &engine->startupProfile_) != 0) {
+        return nullptr;
+    }
+    return engine;
+}
+
+std::unique_ptr<Engine> Engine::recreate() const {
+    return create(config_);
+}
+
+bool Engine::setVariable(const std::string& name, const std::string& value) {
+    if (!api_->SetVariable(name.c_str(), value.c_str())) {
+        return false;
+    }
+    config_.variables[name] = value;
+    return true;
+}
+
+tesseract::TessBaseAPI* Engine::api() const noexcept {
+    return api_.get();
+}
+
+const StartupProfile& Engine::startupProfile() const noexcept {
+    return startupProfile_;
+}
+
+std::unique_ptr<tesseract::TessBaseAPI> Engine::releaseAPI() noexcept {
+    return std::move(api_);
+}
+
+const EngineConfig& Engine::config() const noexcept {
+    return config_;
+}
+
+} // namespace g8
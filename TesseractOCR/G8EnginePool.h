@@ -0,0 +1,103 @@
+#ifndef G8EnginePool_h
+#define G8EnginePool_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Engine.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * Process-wide pool of idle, initialized engines keyed by their configuration.
+ *
+ * Idle engines are accounted for by the MemoryGovernor as MemoryKind::Engine
+ * and may be evicted under memory pressure, so `acquire` can always miss.
+ *
+ * Usage example:
+ * @code
+ * g8::EnginePool::shared().prewarm(config);   // e.g. at launch, off the main thread
+ * ...
+ * auto engine = g8::EnginePool::shared().acquire(config);
+ * if (!engine) {
+ *     engine = g8::Engine::create(config);
+ * }
+ * @endcode
+ */
+class EnginePool final {
+public:
+    /**
+     * The shared pool instance.
+     */
+    static EnginePool& shared();
+
+    /**
+     * Takes an idle engine created from config out of the pool.
+     * @return The engine or nullptr if none is available
+     */
+    std::unique_ptr<Engine> acquire(const EngineConfig& config);
+
+    /**
+     * Puts an engine back into the pool. Its results, adaptive classifier
+     * and page segmentation mode are reset and its configuration's runtime
+     * variables applied again, so that whoever acquires it, e.g. a
+     * G8Tesseract adopting it, gets a freshly created engine's state.
+     * Variables set on the TessBaseAPI directly, bypassing
+     * `Engine::setVariable`, aren't undone.
+     */
+    void release(std::unique_ptr<Engine> engine);
+
+    /**
+     * Brings everything an engine for config needs into memory and leaves
+     * one initialized engine in the pool: reads the traineddata files,
+     * initializes an engine and recognizes a small synthetic image, so that
+     * lazily built structures are in place before the first real request.
+     * Blocks the calling thread.
+     * @return false if the engine couldn't be initialized
+     */
+    bool prewarm(const EngineConfig& config);
+
+    /**
+     * Number of idle engines for config.
+     */
+    size_t idleCount(const EngineConfig& config) const;
+
+    /**
+     * Destroys all idle engines.
+     */
+    void clear();
+
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+private:
+    struct Slot {
+        uint64_t identifier;
+        size_t bytes;
+        std::unique_ptr<Engine> engine;
+    };
+
+    EnginePool() = default;
+
+    /**
+     * Destroys a single idle engine; used as the governor's evictor. An
+     * engine that is tracked but not idle yet is destroyed by `release`.
+     * @return Number of bytes released
+     */
+    size_t evict(const std::string& key, uint64_t identifier);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::vector<Slot>> idle_;
+    std::map<uint64_t, bool> releasing_;  ///< Tracked but not idle yet, and whether evicted meanwhile
+    uint64_t nextIdentifier_ = 0;
+};
+
+} // namespace g8
+
+#endif /* G8EnginePool_h */
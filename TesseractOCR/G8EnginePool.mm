@@ -0,0 +1,194 @@
+#import "G8EnginePool.h"
+#import "G8MemoryGovernor.h"
+#import "G8PixWrapper.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+
+namespace g8 {
+
+namespace {
+
+// Size of the synthetic page recognized while prewarming
+constexpr int kPrewarmImageWidth = 160;
+constexpr int kPrewarmImageHeight = 48;
+constexpr int kPrewarmGlyphCount = 6;
+
+/**
+ * Deserialized models take roughly as much memory as their traineddata,
+ * which is good enough for budgeting. Init already counted the traineddata
+ * it read, so no file is touched here.
+ */
+size_t estimatedEngineBytes(const Engine& engine) {
+    const StartupProfile& profile = engine.startupProfile();
+    return profile.bytesRead() + profile.cachedBytes;
+}
+
+/**
+ * Brings an engine back to the state Engine::create leaves it in: engines
+ * come back from every kind of recognition, with their own page
+ * segmentation mode, and what the adaptive classifier learned from pages
+ * the next user never saw.
+ */
+void resetEngine(Engine& engine) {
+    tesseract::TessBaseAPI* api = engine.api();
+    api->Clear();
+    api->ClearAdaptiveClassifier();
+    api->SetPageSegMode(tesseract::PSM_SINGLE_BLOCK);
+    for (const auto& pair : engine.config().variables) {
+        api->SetVariable(pair.first.c_str(), pair.second.c_str());
+    }
+}
+
+std::string memoryKey(const EngineConfig& config, uint64_t identifier) {
+    return "engine:" + config.language + "/" + std::to_string(config.engineMode) +
+           "#" + std::to_string(identifier);
+}
+
+/**
+ * A white page with a row of dark glyph-sized boxes: enough for layout
+ * analysis, the classifiers and the dictionaries to run.
+ */
+PixWrapper makePrewarmImage() {
+    PixWrapper pix(pixCreate(kPrewarmImageWidth, kPrewarmImageHeight, 8));
+    if (!pix.get()) {
+        return pix;
+    }
+    pixSetAll(pix.get());
+    for (int i = 0; i < kPrewarmGlyphCount; ++i) {
+        BOX* box = boxCreate(16 + i * 22, 12, 12, 24);
+        pixClearInRect(pix.get(), box);
+        boxDestroy(&box);
+    }
+    pixSetResolution(pix.get(), 300, 300);
+    return pix;
+}
+
+} // namespace
+
+EnginePool& EnginePool::shared() {
+    static EnginePool pool;
+    return pool;
+}
+
+std::unique_ptr<Engine> EnginePool::acquire(const EngineConfig& config) {
+    Slot slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = idle_.find(config.key());
+        if (it == idle_.end() || it->second.empty()) {
+            return nullptr;
+        }
+        slot = std::move(it->second.back());
+        it->second.pop_back();
+        if (it->second.empty()) {
+            idle_.erase(it);
+        }
+    }
+    MemoryGovernor::shared().untrack(memoryKey(config, slot.identifier));
+    return std::move(slot.engine);
+}
+
+void EnginePool::release(std::unique_ptr<Engine> engine) {
+    if (!engine) {
+        return;
+    }
+    resetEngine(*engine);
+    const EngineConfig config = engine->config();
+    const std::string key = config.key();
+    const size_t bytes = estimatedEngineBytes(*engine);
+
+    uint64_t identifier = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        identifier = ++nextIdentifier_;
+        releasing_[identifier] = false;
+    }
+
+    // Track before the engine becomes idle, so that an acquire can't take it
+    // before there is an entry to untrack. Track outside of our lock, since
+    // the governor may call back into evict.
+    MemoryGovernor::shared().track(memoryKey(config, identifier), MemoryKind::Engine, bytes, [key, identifier] {
+        return EnginePool::shared().evict(key, identifier);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = releasing_.find(identifier);
+        const bool evicted = it->second;
+        releasing_.erase(it);
+        if (!evicted) {
+            idle_[key].push_back(Slot{identifier, bytes, std::move(engine)});
+        }
+    }
+    // An engine evicted meanwhile is destroyed here, outside of the lock
+}
+
+bool EnginePool::prewarm(const EngineConfig& config) {
+    std::unique_ptr<Engine> engine = Engine::create(config);
+    if (!engine) {
+        return false;
+    }
+
+    PixWrapper pix = makePrewarmImage();
+    if (pix.get()) {
+        tesseract::TessBaseAPI* api = engine->api();
+        api->SetImage(pix.get());
+        api->Recognize(nullptr);
+    }
+
+    // Releasing keeps the synthetic glyphs from biasing the first real page
+    release(std::move(engine));
+    return true;
+}
+
+size_t EnginePool::idleCount(const EngineConfig& config) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = idle_.find(config.key());
+    return it == idle_.end() ? 0 : it->second.size();
+}
+
+void EnginePool::clear() {
+    std::map<std::string, std::vector<Slot>> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle.swap(idle_);
+    }
+    for (const auto& pair : idle) {
+        for (const auto& slot : pair.second) {
+            MemoryGovernor::shared().untrack(memoryKey(slot.engine->config(), slot.identifier));
+        }
+    }
+}
+
+size_t EnginePool::evict(const std::string& key, uint64_t identifier) {
+    std::unique_ptr<Engine> engine;
+    size_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto releasing = releasing_.find(identifier);
+        if (releasing != releasing_.end()) {
+            releasing->second = true;
+            return 0;
+        }
+        auto it = idle_.find(key);
+        if (it == idle_.end()) {
+            return 0;
+        }
+        auto& slots = it->second;
+        for (auto slot = slots.begin(); slot != slots.end(); ++slot) {
+            if (slot->identifier == identifier) {
+                engine = std::move(slot->engine);
+                bytes = slot->bytes;
+                slots.erase(slot);
+                break;
+            }
+        }
+        if (slots.empty()) {
+            idle_.erase(it);
+        }
+    }
+    // The engine is destroyed here, outside of the lock
+    return bytes;
+}
+
+} // namespace g8
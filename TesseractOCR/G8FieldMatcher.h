@@ -0,0 +1,89 @@
+#ifndef G8FieldMatcher_h
+#define G8FieldMatcher_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8ResultNode.h"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * A token a recognition looks for, e.g. the total of a receipt.
+ */
+struct FieldTarget {
+    std::string name;
+    std::function<bool(const std::string& text)> matches;  ///< Whether a word or line is the field
+    int level = 3;                ///< tesseract::PageIteratorLevel tested, RIL_WORD or RIL_TEXTLINE
+    float minimumConfidence = 0;  ///< Confidence a match needs to count as found, 0-100
+};
+
+/**
+ * The best word or line found for a target.
+ */
+struct FieldMatch {
+    std::string name;        ///< The target's name
+    ResultNode node;         ///< The word or line, in page coordinates
+    bool confident = false;  ///< Whether it has the target's minimum confidence
+};
+
+/**
+ * Looks for target fields in results as they come in, so that recognition
+ * can stop as soon as all of them are found. Lines are tested without their
+ * line break. A target keeps its most confident match; it's found once a
+ * match has its minimum confidence.
+ *
+ * Thread-safe.
+ *
+ * Usage example:
+ * @code
+ * std::regex amount("^\\d+[.,]\\d\\d$");
+ * g8::FieldTarget total;
+ * total.name = "total";
+ * total.matches = [&](const std::string& text) { return std::regex_search(text, amount); };
+ * total.minimumConfidence = 80;
+ * g8::FieldMatcher matcher({total});
+ * options.regionRecognized = [&](const std::vector<g8::ResultNode>& blocks) {
+ *     return matcher.inspect(blocks);
+ * };
+ * @endcode
+ */
+class FieldMatcher final {
+public:
+    explicit FieldMatcher(std::vector<FieldTarget> targets);
+
+    FieldMatcher(const FieldMatcher&) = delete;
+    FieldMatcher& operator=(const FieldMatcher&) = delete;
+
+    /**
+     * Tests the words and lines of new results against the targets.
+     * @return true once every target is found
+     */
+    bool inspect(const std::vector<ResultNode>& blocks);
+
+    /**
+     * Whether every target is found.
+     */
+    bool complete() const;
+
+    /**
+     * The best match of each target that has one, in target order.
+     */
+    std::vector<FieldMatch> matches() const;
+
+private:
+    void inspect(const ResultNode& node);
+
+    const std::vector<FieldTarget> targets_;
+    mutable std::mutex mutex_;
+    std::vector<FieldMatch> matches_;  ///< Per target, confidence -1 while unmatched
+    size_t found_ = 0;
+};
+
+} // namespace g8
+
+#endif /* G8FieldMatcher_h */
@@ -0,0 +1,61 @@
+#import "G8FieldMatcher.h"
+
+namespace g8 {
+
+FieldMatcher::FieldMatcher(std::vector<FieldTarget> targets)
+    : targets_(std::move(targets)), matches_(targets_.size()) {
+    for (size_t i = 0; i < targets_.size(); ++i) {
+        matches_[i].name = targets_[i].name;
+        matches_[i].node.confidence = -1;
+    }
+}
+
+bool FieldMatcher::inspect(const std::vector<ResultNode>& blocks) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& block : blocks) {
+        inspect(block);
+    }
+    return found_ == targets_.size();
+}
+
+void FieldMatcher::inspect(const ResultNode& node) {
+    for (size_t i = 0; i < targets_.size(); ++i) {
+        const FieldTarget& target = targets_[i];
+        FieldMatch& match = matches_[i];
+        if (node.level != target.level || match.confident || node.confidence <= match.node.confidence) {
+            continue;
+        }
+        std::string text = node.text;
+        while (!text.empty() && text.back() == '\n') {
+            text.pop_back();
+        }
+        if (!target.matches || !target.matches(text)) {
+            continue;
+        }
+        match.node = node;
+        match.node.children.clear();
+        match.confident = node.confidence >= target.minimumConfidence;
+        found_ += match.confident ? 1 : 0;
+    }
+    for (const auto& child : node.children) {
+        inspect(child);
+    }
+}
+
+bool FieldMatcher::complete() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return found_ == targets_.size();
+}
+
+std::vector<FieldMatch> FieldMatcher::matches() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<FieldMatch> result;
+    for (const auto& match : matches_) {
+        if (match.node.confidence >= 0) {
+            result.push_back(match);
+        }
+    }
+    return result;
+}
+
+} // namespace g8
@@ -0,0 +1,81 @@
+//
+//  G8FieldTarget.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <TesseractOCR/G8Constants.h>
+
+/**
+ *  The type of a block function telling whether the text of a recognized
+ *  word or line is the field looked for.
+ *
+ *  @param text The text, without a line break.
+ *
+ *  @return YES if the text is the field.
+ */
+typedef BOOL(^G8FieldPredicate)(NSString * _Nonnull text);
+
+/**
+ *  `G8FieldTarget` is a token a recognition looks for, such as the total
+ *  of a receipt or the number of an ID document. See `targetFields` in
+ *  G8Tesseract.h.
+ */
+@interface G8FieldTarget : NSObject <NSCopying>
+
+/**
+ *  The name the field is reported by in `recognizedFields`.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSString *name;
+
+/**
+ *  Whether words, `G8PageIteratorLevelWord`, or whole lines,
+ *  `G8PageIteratorLevelTextline`, are tested.
+ */
+@property (nonatomic, assign, readonly) G8PageIteratorLevel level;
+
+/**
+ *  The confidence (between 0 and 100) a match needs to count as found.
+ */
+@property (nonatomic, assign, readonly) CGFloat minimumConfidence;
+
+/**
+ *  The test of a word or line.
+ */
+@property (nonatomic, copy, readonly, nonnull) G8FieldPredicate predicate;
+
+/**
+ *  Initialize a target matching the words in which a regular expression
+ *  finds a match; anchor the expression to match whole words.
+ *
+ *  @param name              The name of the field.
+ *  @param regularExpression The expression.
+ *  @param minimumConfidence The confidence a match needs.
+ *
+ *  @return The initialized target.
+ */
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                   regularExpression:(nonnull NSRegularExpression *)regularExpression
+                   minimumConfidence:(CGFloat)minimumConfidence;
+
+/**
+ *  Initialize a target.
+ *
+ *  @param name              The name of the field.
+ *  @param level             `G8PageIteratorLevelWord` to test words,
+ *                           `G8PageIteratorLevelTextline` to test lines.
+ *  @param minimumConfidence The confidence a match needs.
+ *  @param predicate         The test of a word or line, called on the
+ *                           recognition threads.
+ *
+ *  @return The initialized target.
+ */
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                               level:(G8PageIteratorLevel)level
+                   minimumConfidence:(CGFloat)minimumConfidence
+                           predicate:(nonnull G8FieldPredicate)predicate NS_DESIGNATED_INITIALIZER;
+
+@end
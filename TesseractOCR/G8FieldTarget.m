@@ -0,0 +1,52 @@
+//
+//  G8FieldTarget.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8FieldTarget.h"
+
+@implementation G8FieldTarget
+
+- (instancetype)initWithName:(NSString *)name
+           regularExpression:(NSRegularExpression *)regularExpression
+           minimumConfidence:(CGFloat)minimumConfidence
+{
+    return [self initWithName:name
+                        level:G8PageIteratorLevelWord
+            minimumConfidence:minimumConfidence
+                    predicate:^BOOL(NSString *text) {
+        return [regularExpression firstMatchInString:text options:0 range:NSMakeRange(0, text.length)] != nil;
+    }];
+}
+
+- (instancetype)initWithName:(NSString *)name
+                       level:(G8PageIteratorLevel)level
+           minimumConfidence:(CGFloat)minimumConfidence
+                   predicate:(G8FieldPredicate)predicate
+{
+    self = [super init];
+    if (self != nil) {
+        _name = [name copy];
+        _level = level == G8PageIteratorLevelTextline ? G8PageIteratorLevelTextline : G8PageIteratorLevelWord;
+        _minimumConfidence = minimumConfidence;
+        _predicate = [predicate copy];
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@: %@ with confidence %.0f",
+            self.name, self.level == G8PageIteratorLevelTextline ? @"line" : @"word", self.minimumConfidence];
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+//  G8MemoryEntry.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <TesseractOCR/G8Constants.h>
+
+/**
+ *  `G8MemoryEntry` describes a piece of memory held by the library's caches,
+ *  or one that has been evicted from them. See `cachedMemoryEntries` and
+ *  `evictedMemoryEntries` in G8Tesseract.h.
+ */
+@interface G8MemoryEntry : NSObject <NSCopying>
+
+/**
+ *  Identifier of the cached resource, for example "model:" followed by the
+ *  path of a traineddata file.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSString *key;
+
+/**
+ *  The kind of the cached resource. See `G8MemoryKind` in G8Constants.h.
+ */
+@property (nonatomic, assign, readonly) G8MemoryKind kind;
+
+/**
+ *  Number of bytes the resource occupies.
+ */
+@property (nonatomic, assign, readonly) NSUInteger bytes;
+
+/**
+ *  The time of the last use for cached entries, or the time of eviction for
+ *  evicted ones.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSDate *date;
+
+/**
+ *  Initialize a memory entry with the data it will contain.
+ *
+ *  @param key   Identifier of the cached resource.
+ *  @param kind  The kind of the cached resource.
+ *  @param bytes Number of bytes the resource occupies.
+ *  @param date  Time of the last use or of the eviction.
+ *
+ *  @return The initialized memory entry.
+ */
+- (nonnull instancetype)initWithKey:(nonnull NSString *)key
+                               kind:(G8MemoryKind)kind
+                              bytes:(NSUInteger)bytes
+                               date:(nonnull NSDate *)date;
+
+@end
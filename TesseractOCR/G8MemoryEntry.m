@@ -0,0 +1,39 @@
+//
+//  G8MemoryEntry.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8MemoryEntry.h"
+
+@implementation G8MemoryEntry
+
+- (instancetype)initWithKey:(NSString *)key
+                       kind:(G8MemoryKind)kind
+                      bytes:(NSUInteger)bytes
+                       date:(NSDate *)date
+{
+    self = [super init];
+    if (self != nil) {
+        _key = [key copy];
+        _kind = kind;
+        _bytes = bytes;
+        _date = [date copy];
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@ (%lu bytes)", self.key, (unsigned long)self.bytes];
+}
+
+@end
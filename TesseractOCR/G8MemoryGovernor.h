@@ -0,0 +1,163 @@
+#ifndef G8MemoryGovernor_h
+#define G8MemoryGovernor_h
+
+#import <Foundation/Foundation.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * Kinds of memory the governor accounts for.
+ * Values match `G8MemoryKind` in G8Constants.h.
+ */
+enum class MemoryKind : int {
+    Engine = 0,
+    Model = 1,
+};
+
+/**
+ * Memory pressure signals, from mild to severe.
+ * Values match `G8MemoryPressureLevel` in G8Constants.h.
+ */
+enum class MemoryPressure : int {
+    Moderate = 0,
+    Critical = 1,
+};
+
+/**
+ * A tracked allocation as reported by the governor.
+ */
+struct MemoryEntry {
+    std::string key;
+    MemoryKind kind;
+    size_t bytes;
+    std::chrono::system_clock::time_point date; ///< Last use, or eviction time
+};
+
+/**
+ * Byte-budgeted LRU accounting of the caches kept by the library.
+ *
+ * Owners register each evictable resource with `track`, passing a callback
+ * that releases it. Whenever the tracked total exceeds the budget, or when
+ * pressure is signalled, the least recently used entries are evicted.
+ *
+ * Usage example:
+ * @code
+ * g8::MemoryGovernor::shared().track("model:/path/eng.traineddata",
+ *                                    g8::MemoryKind::Model, size,
+ *                                    [path] { return cache.evict(path); });
+ * @endcode
+ *
+ * @note Evictors are called without the governor's lock held, so they may
+ *       call back into the governor.
+ */
+class MemoryGovernor final {
+public:
+    /**
+     * Callback releasing a tracked resource.
+     * @return Number of bytes actually released
+     */
+    using Evictor = std::function<size_t()>;
+
+    /**
+     * The shared governor instance.
+     */
+    static MemoryGovernor& shared();
+
+    /**
+     * The budget the governor starts with: an eighth of the physical
+     * memory, between 64 MB and 512 MB.
+     */
+    static size_t defaultBudget();
+
+    /**
+     * Sets the byte budget and evicts down to it. Zero means no limit.
+     */
+    void setBudget(size_t bytes);
+
+    /**
+     * The byte budget, zero if unlimited.
+     */
+    size_t budget() const;
+
+    /**
+     * Starts tracking a resource, or updates its size, and marks it as most
+     * recently used. Evicts other entries if the budget is exceeded.
+     */
+    void track(const std::string& key, MemoryKind kind, size_t bytes, Evictor evictor);
+
+    /**
+     * Marks a resource as most recently used.
+     */
+    void touch(const std::string& key);
+
+    /**
+     * Stops tracking a resource without evicting it.
+     */
+    void untrack(const std::string& key);
+
+    /**
+     * Reacts to memory pressure. Moderate pressure halves the tracked usage,
+     * critical pressure evicts everything.
+     */
+    void handlePressure(MemoryPressure pressure);
+
+    /**
+     * Total number of tracked bytes.
+     */
+    size_t usage() const;
+
+    /**
+     * Tracked entries, least recently used first.
+     */
+    std::vector<MemoryEntry> entries() const;
+
+    /**
+     * The most recent evictions, oldest first.
+     */
+    std::vector<MemoryEntry> evictions() const;
+
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+private:
+    struct Record {
+        MemoryKind kind;
+        size_t bytes;
+        uint64_t tick;
+        std::chrono::system_clock::time_point date;
+        Evictor evictor;
+    };
+
+    MemoryGovernor();
+
+    /**
+     * Removes LRU records, except keep, until usage is at most target.
+     * Must be called with mutex_ held. Returns the removed evictors.
+     */
+    std::vector<Evictor> collectVictims(size_t target, const std::string* keep = nullptr);
+
+    /**
+     * Runs evictors collected by collectVictims outside of the lock.
+     */
+    static void runEvictors(const std::vector<Evictor>& evictors);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Record> records_;
+    std::deque<MemoryEntry> evictions_;
+    size_t budget_;
+    size_t usage_ = 0;
+    uint64_t tick_ = 0;
+};
+
+} // namespace g8
+
+#endif /* G8MemoryGovernor_h */
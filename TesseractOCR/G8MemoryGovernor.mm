@@ -0,0 +1,170 @@
+#import "G8MemoryGovernor.h"
+
+#include <algorithm>
+
+#include <unistd.h>
+
+namespace g8 {
+
+namespace {
+// Number of eviction records kept for reporting
+constexpr size_t kMaxEvictionRecords = 64;
+
+// Bounds of the default budget
+constexpr size_t kMinDefaultBudget = size_t(64) << 20;
+constexpr size_t kMaxDefaultBudget = size_t(512) << 20;
+}
+
+MemoryGovernor::MemoryGovernor() : budget_(defaultBudget()) {
+}
+
+size_t MemoryGovernor::defaultBudget() {
+    const long pages = sysconf(_SC_PHYS_PAGES);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return kMaxDefaultBudget / 2;
+    }
+    const size_t physical = static_cast<size_t>(pages) * static_cast<size_t>(pageSize);
+    return std::clamp(physical / 8, kMinDefaultBudget, kMaxDefaultBudget);
+}
+
+MemoryGovernor& MemoryGovernor::shared() {
+    static MemoryGovernor governor;
+    return governor;
+}
+
+void MemoryGovernor::setBudget(size_t bytes) {
+    std::vector<Evictor> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budget_ = bytes;
+        if (budget_ > 0) {
+            victims = collectVictims(budget_);
+        }
+    }
+    runEvictors(victims);
+}
+
+size_t MemoryGovernor::budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+void MemoryGovernor::track(const std::string& key, MemoryKind kind, size_t bytes, Evictor evictor) {
+    std::vector<Evictor> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = records_.find(key);
+        if (it != records_.end()) {
+            usage_ -= it->second.bytes;
+            records_.erase(it);
+        }
+        records_[key] = Record{kind, bytes, ++tick_, std::chrono::system_clock::now(), std::move(evictor)};
+        usage_ += bytes;
+
+        if (budget_ > 0 && usage_ > budget_) {
+            // Never evict the entry that is being added
+            victims = collectVictims(budget_, &key);
+        }
+    }
+    runEvictors(victims);
+}
+
+void MemoryGovernor::touch(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(key);
+    if (it != records_.end()) {
+        it->second.tick = ++tick_;
+        it->second.date = std::chrono::system_clock::now();
+    }
+}
+
+void MemoryGovernor::untrack(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = records_.find(key);
+    if (it != records_.end()) {
+        usage_ -= it->second.bytes;
+        records_.erase(it);
+    }
+}
+
+void MemoryGovernor::handlePressure(MemoryPressure pressure) {
+    std::vector<Evictor> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t target = pressure == MemoryPressure::Critical ? 0 : usage_ / 2;
+        victims = collectVictims(target);
+    }
+    runEvictors(victims);
+}
+
+size_t MemoryGovernor::usage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+}
+
+std::vector<MemoryEntry> MemoryGovernor::entries() const {
+    std::vector<std::pair<uint64_t, MemoryEntry>> ordered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ordered.reserve(records_.size());
+        for (const auto& pair : records_) {
+            const Record& record = pair.second;
+            ordered.push_back({record.tick, MemoryEntry{pair.first, record.kind, record.bytes, record.date}});
+        }
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    std::vector<MemoryEntry> result;
+    result.reserve(ordered.size());
+    for (auto& pair : ordered) {
+        result.push_back(std::move(pair.second));
+    }
+    return result;
+}
+
+std::vector<MemoryEntry> MemoryGovernor::evictions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::vector<MemoryEntry>(evictions_.begin(), evictions_.end());
+}
+
+std::vector<MemoryGovernor::Evictor> MemoryGovernor::collectVictims(size_t target, const std::string* keep) {
+    std::vector<Evictor> victims;
+    auto now = std::chrono::system_clock::now();
+    while (usage_ > target) {
+        auto oldest = records_.end();
+        for (auto it = records_.begin(); it != records_.end(); ++it) {
+            if (keep && it->first == *keep) {
+                continue;
+            }
+            if (oldest == records_.end() || it->second.tick < oldest->second.tick) {
+                oldest = it;
+            }
+        }
+        if (oldest == records_.end()) {
+            break;
+        }
+
+        evictions_.push_back(MemoryEntry{oldest->first, oldest->second.kind, oldest->second.bytes, now});
+        if (evictions_.size() > kMaxEvictionRecords) {
+            evictions_.pop_front();
+        }
+
+        usage_ -= oldest->second.bytes;
+        if (oldest->second.evictor) {
+            victims.push_back(std::move(oldest->second.evictor));
+        }
+        records_.erase(oldest);
+    }
+    return victims;
+}
+
+void MemoryGovernor::runEvictors(const std::vector<Evictor>& evictors) {
+    for (const auto& evictor : evictors) {
+        evictor();
+    }
+}
+
+} // namespace g8
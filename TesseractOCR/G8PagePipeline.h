@@ -0,0 +1,104 @@
+#ifndef G8PagePipeline_h
+#define G8PagePipeline_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8PixWrapper.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * A page on its way through a PagePipeline.
+ */
+struct PipelinePage {
+    size_t index = 0;             ///< Position of the page in the document
+    PixWrapper pix;               ///< The page image, once a stage has produced it
+    std::shared_ptr<void> data;   ///< State handed from one stage to the next, e.g. decoded pixels
+    bool skipped = false;         ///< Set by a stage to pass the page through the later stages untouched
+};
+
+/**
+ * One stage of a PagePipeline.
+ */
+struct PipelineStage {
+    std::string name;                              ///< e.g. "decode"
+    size_t threads = 1;                            ///< Threads running this stage
+    bool ordered = false;                          ///< Whether pages must arrive in document order
+    std::function<bool(PipelinePage&)> process;    ///< Returns false to stop the whole document
+};
+
+/**
+ * How busy a stage was during a run.
+ */
+struct PipelineStageReport {
+    std::string name;
+    size_t pages = 0;            ///< Pages processed, excluding those skipped before or by the stage
+    double busySeconds = 0;      ///< Time spent in `process`, summed over the stage's threads
+    double utilization = 0;      ///< busySeconds over the run's wall time and the stage's threads, 0-1
+    size_t maxQueueDepth = 0;    ///< Most pages waiting in front of the stage at once
+};
+
+/**
+ * Results of a PagePipeline run.
+ */
+struct PipelineReport {
+    std::vector<PipelineStageReport> stages;  ///< In pipeline order
+    double seconds = 0;                       ///< Wall time of the run
+    size_t maxPagesInFlight = 0;              ///< Most pages admitted and not finished at once
+    bool completed = false;                   ///< false if a stage stopped the document
+};
+
+/**
+ * Moves the pages of a document through a fixed sequence of stages, each
+ * with its own threads, so that e.g. page N + 1 is decoded while page N is
+ * being recognized.
+ *
+ * Stages are connected by bounded queues, and at most `maxPagesInFlight`
+ * pages are between the first stage and the end of the last one, which caps
+ * the memory held by decoded pages. Pages reach an ordered stage in
+ * document order, one at a time if it has a single thread; use this for
+ * stages with per-document state such as an engine or a renderer.
+ *
+ * Usage example:
+ * @code
+ * g8::PagePipeline pipeline({
+ *     {"decode", 2, false, [&](g8::PipelinePage& page) { page.pix.reset(pixRead(paths[page.index].c_str())); return true; }},
+ *     {"recognize", 1, true, [&](g8::PipelinePage& page) { return recognize(page.pix.get()); }},
+ * }, 4);
+ * g8::PipelineReport report = pipeline.run(paths.size());
+ * @endcode
+ */
+class PagePipeline final {
+public:
+    /**
+     * @param stages           Stages in processing order
+     * @param maxPagesInFlight Pages allowed in the pipeline at once, at least 1
+     * @param queueCapacity    Pages allowed to wait in front of each stage, 0
+     *                         for maxPagesInFlight
+     */
+    PagePipeline(std::vector<PipelineStage> stages, size_t maxPagesInFlight, size_t queueCapacity = 0);
+
+    PagePipeline(const PagePipeline&) = delete;
+    PagePipeline& operator=(const PagePipeline&) = delete;
+
+    /**
+     * Runs pages 0 to pageCount - 1 through all stages and blocks until
+     * they are done or a stage stops the document. Stages are run on
+     * threads started for this call.
+     */
+    PipelineReport run(size_t pageCount);
+
+private:
+    const std::vector<PipelineStage> stages_;
+    const size_t maxPagesInFlight_;
+    const size_t queueCapacity_;
+};
+
+} // namespace g8
+
+#endif /* G8PagePipeline_h */
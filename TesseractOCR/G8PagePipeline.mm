@@ -0,0 +1,219 @@
+#import "G8PagePipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace g8 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Bounded queue in front of a stage. An ordered queue only hands out the
+ * page it waits for, and always accepts it, so that a full queue of later
+ * pages can't block the page everyone waits for.
+ */
+class PageQueue final {
+public:
+    PageQueue(size_t capacity, bool ordered) : capacity_(capacity), ordered_(ordered) {}
+
+    /**
+     * Blocks while the queue is full. Drops the page if the queue is closed.
+     */
+    void push(PipelinePage page) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] {
+            return closed_ || pages_.size() < capacity_ || (ordered_ && page.index == next_);
+        });
+        if (closed_) {
+            return;
+        }
+        const size_t index = page.index;
+        pages_.emplace(index, std::move(page));
+        maxDepth_ = std::max(maxDepth_, pages_.size());
+        available_.notify_all();
+    }
+
+    /**
+     * Blocks until a page is ready.
+     * @return false once the queue is closed
+     */
+    bool pop(PipelinePage& page) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [&] { return closed_ || ready(); });
+        if (closed_) {
+            return false;
+        }
+        auto first = pages_.begin();
+        page = std::move(first->second);
+        pages_.erase(first);
+        if (ordered_) {
+            ++next_;
+            available_.notify_all();
+        }
+        notFull_.notify_all();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        available_.notify_all();
+        notFull_.notify_all();
+    }
+
+    size_t maxDepth() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return maxDepth_;
+    }
+
+private:
+    bool ready() const {
+        return !pages_.empty() && (!ordered_ || pages_.begin()->first == next_);
+    }
+
+    const size_t capacity_;
+    const bool ordered_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::condition_variable notFull_;
+    std::map<size_t, PipelinePage> pages_;  ///< By index, so the lowest goes first
+    size_t next_ = 0;                       ///< Next index of an ordered queue
+    size_t maxDepth_ = 0;
+    bool closed_ = false;
+};
+
+/**
+ * Counters of one stage, updated by its threads.
+ */
+struct StageCounters {
+    std::mutex mutex;
+    size_t pages = 0;
+    double busySeconds = 0;
+};
+
+} // namespace
+
+PagePipeline::PagePipeline(std::vector<PipelineStage> stages, size_t maxPagesInFlight, size_t queueCapacity)
+    : stages_(std::move(stages)),
+      maxPagesInFlight_(std::max<size_t>(maxPagesInFlight, 1)),
+      queueCapacity_(queueCapacity > 0 ? queueCapacity : std::max<size_t>(maxPagesInFlight, 1)) {
+}
+
+PipelineReport PagePipeline::run(size_t pageCount) {
+    PipelineReport report;
+    const auto start = Clock::now();
+
+    std::vector<std::unique_ptr<PageQueue>> queues;
+    std::vector<std::unique_ptr<StageCounters>> counters;
+    for (const auto& stage : stages_) {
+        queues.push_back(std::make_unique<PageQueue>(queueCapacity_, stage.ordered));
+        counters.push_back(std::make_unique<StageCounters>());
+    }
+
+    // Admission and completion of pages
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t inFlight = 0;
+    size_t finished = 0;
+    bool stopped = false;
+
+    auto stop = [&] {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        changed.notify_all();
+        for (auto& queue : queues) {
+            queue->close();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t s = 0; s < stages_.size(); ++s) {
+        const size_t threadCount = std::max<size_t>(stages_[s].threads, 1);
+        for (size_t t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, s] {
+                const PipelineStage& stage = stages_[s];
+                PipelinePage page;
+                while (queues[s]->pop(page)) {
+                    if (!page.skipped) {
+                        const auto begin = Clock::now();
+                        const bool proceed = !stage.process || stage.process(page);
+                        const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+                        {
+                            std::lock_guard<std::mutex> lock(counters[s]->mutex);
+                            counters[s]->pages += page.skipped ? 0 : 1;
+                            counters[s]->busySeconds += seconds;
+                        }
+                        if (!proceed) {
+                            stop();
+                            break;
+                        }
+                    }
+
+                    if (s + 1 < stages_.size()) {
+                        queues[s + 1]->push(std::move(page));
+                    } else {
+                        page = PipelinePage();  // Free the page before admitting the next one
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            --inFlight;
+                            ++finished;
+                        }
+                        changed.notify_all();
+                    }
+                }
+            });
+        }
+    }
+
+    for (size_t i = 0; i < pageCount && !stages_.empty(); ++i) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return stopped || inFlight < maxPagesInFlight_; });
+            if (stopped) {
+                break;
+            }
+            ++inFlight;
+            report.maxPagesInFlight = std::max(report.maxPagesInFlight, inFlight);
+        }
+        PipelinePage page;
+        page.index = i;
+        queues.front()->push(std::move(page));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return stopped || finished == pageCount || stages_.empty(); });
+        report.completed = !stopped;
+    }
+    for (auto& queue : queues) {
+        queue->close();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (size_t s = 0; s < stages_.size(); ++s) {
+        PipelineStageReport stageReport;
+        stageReport.name = stages_[s].name;
+        stageReport.pages = counters[s]->pages;
+        stageReport.busySeconds = counters[s]->busySeconds;
+        if (report.seconds > 0) {
+            const double threadCount = static_cast<double>(std::max<size_t>(stages_[s].threads, 1));
+            stageReport.utilization = std::min(1.0, stageReport.busySeconds / (report.seconds * threadCount));
+        }
+        stageReport.maxQueueDepth = queues[s]->maxDepth();
+        report.stages.push_back(std::move(stageReport));
+    }
+    return report;
+}
+
+} // namespace g8
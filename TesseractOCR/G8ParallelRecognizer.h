@@ -0,0 +1,130 @@
+#ifndef G8ParallelRecognizer_h
+#define G8ParallelRecognizer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Cancellation.h"
+#import "G8ResultNode.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Tesseract internals
+namespace tesseract {
+class TessBaseAPI;
+}
+
+namespace g8 {
+
+struct EngineConfig;
+
+/**
+ * The order in which `recognizeInParallel` starts the regions of a page.
+ * With a deadline, the regions started first are the likeliest to be done.
+ */
+enum class RegionOrder : int {
+    Reading = 0,   ///< Reading order of the layout
+    CenterFirst,   ///< Nearest to the center of the page first, e.g. for a framed document
+    LargestFirst,  ///< Largest area first, where most of the text is
+};
+
+/**
+ * How `recognizeInParallel` splits and processes a page.
+ */
+struct ParallelRecognitionOptions {
+    int regionLevel = 0;          ///< tesseract::PageIteratorLevel to split at, RIL_BLOCK to RIL_TEXTLINE
+    size_t concurrency = 0;       ///< Worker threads, 0 for one per processor core
+    int padding = 10;             ///< Margin kept around each region, in pixels
+    int sourceResolution = 0;     ///< Resolution given to the region engines, 0 to use the image's
+    int deadlineMsecs = 0;        ///< Time limit for the whole page, layout analysis included, 0 for none
+    bool partialOnDeadline = false;            ///< Whether the deadline returns the regions done instead of failing
+    RegionOrder order = RegionOrder::Reading;  ///< Order the regions are started in
+    CancellationToken cancellation;      ///< Cancels the page, checked by every region engine
+    std::function<bool()> shouldCancel;  ///< Polled during recognition if set; calls are serialized
+    std::function<void(int)> progress;   ///< Percentage of regions done; calls are serialized
+    /// Called with the results of each region once it's done, in page
+    /// coordinates; returning true finishes the page early with the regions
+    /// done so far. Calls are serialized
+    std::function<bool(const std::vector<ResultNode>& blocks)> regionRecognized;
+};
+
+/**
+ * Results of a page recognized region by region.
+ */
+struct ParallelPageResult {
+    std::vector<ResultNode> blocks;  ///< In reading order, in page coordinates
+    size_t regionCount = 0;          ///< Number of regions the page was split into
+    bool cancelled = false;          ///< Whether recognition was cancelled or timed out
+    bool finishedEarly = false;      ///< Whether regionRecognized finished the page before every region was done
+    bool partial = false;            ///< Whether the deadline hit before every region was done
+    size_t regionsRecognized = 0;    ///< Number of regions whose results are in blocks
+    double coverage = 0;             ///< Share of the regions' area recognized, 0-1
+
+    /**
+     * The page text, formatted like TessBaseAPI::GetUTF8Text.
+     */
+    std::string text() const;
+};
+
+/**
+ * Recognizes a page by running layout analysis once on api, then
+ * recognizing each text region with its own engine on a pool of threads.
+ *
+ * Region engines come from EnginePool and are created from config when the
+ * pool is empty; they're returned to the pool afterwards. Blocks and
+ * paragraphs are recognized as single blocks, text lines as single lines;
+ * the results are moved back to page coordinates and merged in the reading
+ * order of the layout. Paragraph and line regions are grouped into the
+ * paragraphs and blocks they came from.
+ *
+ * With `regionRecognized` set, the results of each region are handed over
+ * as soon as it's done, so that the caller can finish the page once it has
+ * what it needs, e.g. a few target fields; the regions still running are
+ * cancelled and those not started are skipped.
+ *
+ * With `partialOnDeadline` set, recognition is anytime: when the deadline
+ * hits, the regions still running are cancelled and dropped, those not
+ * started are skipped, and the regions done so far are returned as a
+ * well-formed result marked `partial`. `order` decides which regions get
+ * done first; the results are merged in reading order whatever the order.
+ * Layout analysis can't be interrupted, so a deadline that passes during it
+ * returns an empty partial result.
+ *
+ * @param api     Engine holding the page image; its recognition results are
+ *                cleared by layout analysis
+ * @param config  Configuration of the region engines, usually api's
+ * @param options Split level, thread count, cancellation and progress
+ * @param result  Receives the merged results
+ * @return false if layout analysis failed, an engine couldn't be created or
+ *         recognition was cancelled, or timed out without partialOnDeadline
+ */
+bool recognizeInParallel(tesseract::TessBaseAPI& api,
+                         const EngineConfig& config,
+                         const ParallelRecognitionOptions& options,
+                         ParallelPageResult& result);
+
+/**
+ * Copies the results of a page whose recognition on a single engine hit the
+ * monitor's deadline, as a result marked `partial`. Tesseract gives the
+ * words it didn't get to a result of blanks; text lines with such a word
+ * are left out, so the result holds the lines done in time. The lines are
+ * counted as the regions of the page and coverage is their share of its
+ * text line area.
+ *
+ * @code
+ * if (api.Recognize(monitor.get()) != 0 && monitor.deadlineExceeded()) {
+ *     g8::ParallelPageResult result;
+ *     g8::collectPartialResult(api, result);
+ * }
+ * @endcode
+ *
+ * @param api    Engine that recognized the page
+ * @param result Receives the lines done in time
+ * @return false if the engine has no results
+ */
+bool collectPartialResult(tesseract::TessBaseAPI& api, ParallelPageResult& result);
+
+} // namespace g8
+
+#endif /* G8ParallelRecognizer_h */
@@ -0,0 +1,545 @@
+#import "G8ParallelRecognizer.h"
+#import "G8Engine.h"
+#import "G8EnginePool.h"
+#import "G8PixWrapper.h"
+#import "G8TaskPool.h"
+#import "G8TextMonitor.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+#import <Tesseract/ocrclass.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <mutex>
+
+namespace g8 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * A text region found by layout analysis, cropped out of the page.
+ */
+struct Region {
+    PixWrapper image;
+    int originX = 0;
+    int originY = 0;
+    int blockId = 0;
+    int paragraphId = 0;             ///< Within the block
+    double area = 0;                 ///< Of the layout box, without padding
+    double centerDistance = 0;       ///< From the center of the layout box to that of the page
+    bool recognized = false;
+    std::vector<ResultNode> blocks;  ///< Results in page coordinates
+};
+
+/**
+ * State shared by the workers of one page: cancellation, the deadline,
+ * progress and the engines in use.
+ */
+class PageState final {
+public:
+    PageState(const EngineConfig& config, const ParallelRecognitionOptions& options, size_t regionCount,
+              Clock::time_point deadline)
+        : config_(config), options_(options), regionCount_(regionCount), deadline_(deadline) {}
+
+    ~PageState() {
+        for (auto& engine : engines_) {
+            EnginePool::shared().release(std::move(engine));
+        }
+    }
+
+    /**
+     * Whether recognition should stop, because the page was cancelled,
+     * timed out or finished early; latches once it returns true.
+     */
+    bool shouldStop() {
+        if (stopped_ || finishedEarly_) {
+            return true;
+        }
+        if (options_.cancellation.isCancelled()) {
+            stopped_ = true;
+        } else if (deadline_ != Clock::time_point() && Clock::now() >= deadline_) {
+            timedOut_ = true;
+            stopped_ = true;
+        } else if (options_.shouldCancel) {
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            if (options_.shouldCancel()) {
+                stopped_ = true;
+            }
+        }
+        return stopped_;
+    }
+
+    /**
+     * Whether the page was cancelled or timed out.
+     */
+    bool stopped() const noexcept {
+        return stopped_;
+    }
+
+    /**
+     * Whether the page was stopped by the deadline.
+     */
+    bool timedOut() const noexcept {
+        return timedOut_;
+    }
+
+    bool finishedEarly() const noexcept {
+        return finishedEarly_;
+    }
+
+    /**
+     * Hands the results of a region to regionRecognized, unless the page
+     * already finished early.
+     */
+    void regionRecognized(const std::vector<ResultNode>& blocks) {
+        if (!options_.regionRecognized) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        if (!finishedEarly_ && options_.regionRecognized(blocks)) {
+            finishedEarly_ = true;
+        }
+    }
+
+    /**
+     * Milliseconds until the deadline, 0 if there's none.
+     */
+    int remainingMsecs() const {
+        if (deadline_ == Clock::time_point()) {
+            return 0;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now());
+        return std::max(1, static_cast<int>(remaining.count()));
+    }
+
+    void regionDone() {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        ++completedRegions_;
+        if (options_.progress) {
+            options_.progress(static_cast<int>(completedRegions_ * 100 / regionCount_));
+        }
+    }
+
+    /**
+     * An engine for a worker: one left by a previous region, a pooled one
+     * or a new one.
+     */
+    std::unique_ptr<Engine> acquireEngine() {
+        {
+            std::lock_guard<std::mutex> lock(enginesMutex_);
+            if (!engines_.empty()) {
+                std::unique_ptr<Engine> engine = std::move(engines_.back());
+                engines_.pop_back();
+                return engine;
+            }
+        }
+        std::unique_ptr<Engine> engine = EnginePool::shared().acquire(config_);
+        return engine ? std::move(engine) : Engine::create(config_);
+    }
+
+    void releaseEngine(std::unique_ptr<Engine> engine) {
+        std::lock_guard<std::mutex> lock(enginesMutex_);
+        engines_.push_back(std::move(engine));
+    }
+
+    std::atomic<bool> failed{false};
+
+private:
+    const EngineConfig& config_;
+    const ParallelRecognitionOptions& options_;
+    const size_t regionCount_;
+    const Clock::time_point deadline_;
+    std::atomic<bool> timedOut_{false};
+    std::atomic<bool> stopped_{false};
+    std::atomic<bool> finishedEarly_{false};
+
+    std::mutex callbackMutex_;
+    size_t completedRegions_ = 0;
+
+    std::mutex enginesMutex_;
+    std::vector<std::unique_ptr<Engine>> engines_;
+};
+
+bool cancelCallback(void* state, int words) {
+    return static_cast<PageState*>(state)->shouldStop();
+}
+
+/**
+ * Crops every region layout analysis finds at the requested level.
+ */
+bool findRegions(tesseract::TessBaseAPI& api, const ParallelRecognitionOptions& options, std::vector<Region>& regions) {
+    Pix* page = api.GetInputImage();
+    if (!page) {
+        return false;
+    }
+
+    int* blockIds = nullptr;
+    int* paragraphIds = nullptr;
+    Boxa* boxes = api.GetComponentImages(static_cast<tesseract::PageIteratorLevel>(options.regionLevel),
+                                         true, false, 0, nullptr, &blockIds, &paragraphIds);
+    if (!boxes) {
+        delete[] blockIds;
+        delete[] paragraphIds;
+        return false;
+    }
+
+    const int pageWidth = pixGetWidth(page);
+    const int pageHeight = pixGetHeight(page);
+    const int count = boxaGetCount(boxes);
+    regions.resize(count);
+    for (int i = 0; i < count; ++i) {
+        int x, y, width, height;
+        boxaGetBoxGeometry(boxes, i, &x, &y, &width, &height);
+        regions[i].blockId = blockIds ? blockIds[i] : i;
+        regions[i].paragraphId = paragraphIds ? paragraphIds[i] : 0;
+        regions[i].area = static_cast<double>(width) * height;
+        regions[i].centerDistance = std::hypot(x + width / 2.0 - pageWidth / 2.0, y + height / 2.0 - pageHeight / 2.0);
+
+        if (options.regionLevel == tesseract::RIL_TEXTLINE) {
+            // A margin taken from the page would catch parts of the
+            // neighbouring lines, so add a blank one instead
+            BOX* clip = boxCreate(x, y, width, height);
+            PixWrapper line(pixClipRectangle(page, clip, nullptr));
+            boxDestroy(&clip);
+            if (line) {
+                regions[i].image = PixWrapper(pixAddBlackOrWhiteBorder(line.get(), options.padding, options.padding,
+                                                                       options.padding, options.padding,
+                                                                       L_GET_WHITE_VAL));
+            }
+            regions[i].originX = x - options.padding;
+            regions[i].originY = y - options.padding;
+            continue;
+        }
+
+        int left = std::max(0, x - options.padding);
+        int top = std::max(0, y - options.padding);
+        int right = std::min(pageWidth, x + width + options.padding);
+        int bottom = std::min(pageHeight, y + height + options.padding);
+
+        BOX* clip = boxCreate(left, top, right - left, bottom - top);
+        regions[i].image = PixWrapper(pixClipRectangle(page, clip, nullptr));
+        boxDestroy(&clip);
+        regions[i].originX = left;
+        regions[i].originY = top;
+    }
+
+    delete[] blockIds;
+    delete[] paragraphIds;
+    boxaDestroy(&boxes);
+    return true;
+}
+
+void recognizeRegion(Region& region, PageState& state, const ParallelRecognitionOptions& options) {
+    if (state.stopped() || state.finishedEarly() || state.failed || !region.image) {
+        return;
+    }
+    std::unique_ptr<Engine> engine = state.acquireEngine();
+    if (!engine) {
+        state.failed = true;
+        return;
+    }
+
+    tesseract::TessBaseAPI* api = engine->api();
+    const tesseract::PageSegMode pageSegMode = api->GetPageSegMode();
+    api->SetPageSegMode(options.regionLevel == tesseract::RIL_TEXTLINE ? tesseract::PSM_SINGLE_LINE
+                                                                       : tesseract::PSM_SINGLE_BLOCK);
+    api->SetImage(region.image.get());
+    if (options.sourceResolution > 0) {
+        api->SetSourceResolution(options.sourceResolution);
+    }
+
+    TextMonitor monitor(cancelCallback, &state);
+    if (options.deadlineMsecs > 0) {
+        monitor.setDeadline(state.remainingMsecs());
+    }
+
+    // A region cut short because the page finished early is dropped
+    if (api->Recognize(monitor.get()) == 0 && !state.stopped() && !state.finishedEarly()) {
+        std::unique_ptr<tesseract::ResultIterator> iterator(api->GetIterator());
+        if (iterator) {
+            region.blocks = buildResultTree(*iterator);
+            for (auto& block : region.blocks) {
+                block.offset(region.originX, region.originY);
+            }
+        }
+        region.recognized = true;
+        state.regionRecognized(region.blocks);
+    } else if (!state.shouldStop()) {
+        state.failed = true;
+    }
+
+    api->Clear();
+    api->SetPageSegMode(pageSegMode);
+    state.releaseEngine(std::move(engine));
+    state.regionDone();
+}
+
+/**
+ * Moves the nodes of a level out of a result tree, in order.
+ */
+void takeNodes(std::vector<ResultNode>& nodes, int level, std::vector<ResultNode>& result) {
+    for (auto& node : nodes) {
+        if (node.level == level) {
+            result.push_back(std::move(node));
+        } else if (node.level < level) {
+            takeNodes(node.children, level, result);
+        }
+    }
+}
+
+/**
+ * Adds child to parent's children, growing parent's box to include it.
+ */
+void appendChild(ResultNode& parent, ResultNode child) {
+    if (parent.children.empty()) {
+        parent.left = child.left;
+        parent.top = child.top;
+        parent.right = child.right;
+        parent.bottom = child.bottom;
+    } else {
+        parent.left = std::min(parent.left, child.left);
+        parent.top = std::min(parent.top, child.top);
+        parent.right = std::max(parent.right, child.right);
+        parent.bottom = std::max(parent.bottom, child.bottom);
+    }
+    parent.children.push_back(std::move(child));
+}
+
+/**
+ * Fills in the text and confidence of a node rebuilt from its children.
+ * The lines of a paragraph are separated as ResultIterator would, since
+ * they may come from regions recognized on their own.
+ */
+void summarize(ResultNode& node) {
+    if (node.level == tesseract::RIL_PARA) {
+        separateLines(node);
+    } else {
+        node.text.clear();
+        for (const auto& child : node.children) {
+            node.text += child.text;
+        }
+    }
+    float confidence = 0;
+    for (const auto& child : node.children) {
+        confidence += child.confidence;
+    }
+    node.confidence = node.children.empty() ? 0 : confidence / node.children.size();
+}
+
+/**
+ * Rebuilds the page hierarchy above the region level: paragraph and line
+ * regions are grouped by the paragraph and block layout analysis found
+ * them in.
+ */
+void mergeRegions(std::vector<Region>& regions, int regionLevel, std::vector<ResultNode>& blocks) {
+    int currentBlockId = -1;
+    int currentParagraphId = -1;
+    for (auto& region : regions) {
+        std::vector<ResultNode> nodes;
+        takeNodes(region.blocks, regionLevel, nodes);
+        for (auto& node : nodes) {
+            if (blocks.empty() || region.blockId != currentBlockId) {
+                blocks.emplace_back();
+                blocks.back().level = tesseract::RIL_BLOCK;
+                currentBlockId = region.blockId;
+                currentParagraphId = -1;
+            }
+            ResultNode& block = blocks.back();
+            if (regionLevel == tesseract::RIL_PARA) {
+                appendChild(block, std::move(node));
+                continue;
+            }
+
+            if (block.children.empty() || region.paragraphId != currentParagraphId) {
+                block.children.emplace_back();
+                block.children.back().level = tesseract::RIL_PARA;
+                currentParagraphId = region.paragraphId;
+            }
+            appendChild(block.children.back(), std::move(node));
+        }
+    }
+
+    for (auto& block : blocks) {
+        for (auto& paragraph : block.children) {
+            if (regionLevel == tesseract::RIL_TEXTLINE) {
+                summarize(paragraph);
+            } else {
+                // A paragraph region's last line ended its own page
+                separateLines(paragraph);
+            }
+        }
+        // Grow the block around its rebuilt paragraphs
+        std::vector<ResultNode> children;
+        children.swap(block.children);
+        for (auto& child : children) {
+            appendChild(block, std::move(child));
+        }
+        summarize(block);
+    }
+}
+
+/**
+ * Whether Tesseract got to a word before its deadline; the words it didn't
+ * get to are given a fake result of blanks.
+ */
+bool isRecognized(const ResultNode& word) {
+    return std::any_of(word.text.begin(), word.text.end(), [](char c) {
+        return !std::isspace(static_cast<unsigned char>(c));
+    });
+}
+
+double boxArea(const ResultNode& node) {
+    return static_cast<double>(std::max(node.right - node.left, 0)) * std::max(node.bottom - node.top, 0);
+}
+
+/**
+ * The indices of the regions in the order they're started in; ties keep
+ * reading order.
+ */
+std::vector<size_t> startOrder(const std::vector<Region>& regions, RegionOrder order) {
+    std::vector<size_t> indices(regions.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;
+    }
+    if (order == RegionOrder::CenterFirst) {
+        std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+            return regions[a].centerDistance < regions[b].centerDistance;
+        });
+    } else if (order == RegionOrder::LargestFirst) {
+        std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+            return regions[a].area > regions[b].area;
+        });
+    }
+    return indices;
+}
+
+} // namespace
+
+std::string ParallelPageResult::text() const {
+    return resultText(blocks);
+}
+
+bool recognizeInParallel(tesseract::TessBaseAPI& api,
+                         const EngineConfig& config,
+                         const ParallelRecognitionOptions& options,
+                         ParallelPageResult& result) {
+    result = ParallelPageResult();
+
+    // Layout analysis counts against the deadline
+    Clock::time_point deadline;
+    if (options.deadlineMsecs > 0) {
+        deadline = Clock::now() + std::chrono::milliseconds(options.deadlineMsecs);
+    }
+
+    std::vector<Region> regions;
+    if (!findRegions(api, options, regions)) {
+        return false;
+    }
+    result.regionCount = regions.size();
+    if (regions.empty()) {
+        result.coverage = 1;
+        return true;
+    }
+
+    PageState state(config, options, regions.size(), deadline);
+    {
+        // Workers take the regions one at a time, so they start in order
+        const std::vector<size_t> order = startOrder(regions, options.order);
+        std::atomic<size_t> next{0};
+        size_t threadCount = options.concurrency > 0 ? options.concurrency : std::thread::hardware_concurrency();
+        TaskPool pool(std::min(std::max<size_t>(threadCount, 1), regions.size()));
+        for (size_t i = 0; i < pool.threadCount(); ++i) {
+            pool.submit([&regions, &order, &next, &state, &options] {
+                for (size_t index = next++; index < order.size(); index = next++) {
+                    recognizeRegion(regions[order[index]], state, options);
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    const bool partial = state.stopped() && state.timedOut() && options.partialOnDeadline;
+    if ((state.stopped() && !partial) || state.failed) {
+        result.cancelled = state.stopped();
+        return false;
+    }
+    result.finishedEarly = state.finishedEarly();
+    result.partial = partial;
+
+    double area = 0;
+    double recognizedArea = 0;
+    for (const auto& region : regions) {
+        area += region.area;
+        if (region.recognized) {
+            ++result.regionsRecognized;
+            recognizedArea += region.area;
+        }
+    }
+    result.coverage = area > 0 ? recognizedArea / area : static_cast<double>(result.regionsRecognized) / regions.size();
+
+    if (options.regionLevel == tesseract::RIL_PARA || options.regionLevel == tesseract::RIL_TEXTLINE) {
+        mergeRegions(regions, options.regionLevel, result.blocks);
+    } else {
+        for (auto& region : regions) {
+            std::move(region.blocks.begin(), region.blocks.end(), std::back_inserter(result.blocks));
+        }
+    }
+    return true;
+}
+
+bool collectPartialResult(tesseract::TessBaseAPI& api, ParallelPageResult& result) {
+    result = ParallelPageResult();
+    std::unique_ptr<tesseract::ResultIterator> iterator(api.GetIterator());
+    if (!iterator) {
+        return false;
+    }
+    result.partial = true;
+
+    // Lines are kept whole, like the regions of a page split by lines
+    double area = 0;
+    double recognizedArea = 0;
+    for (auto& block : buildResultTree(*iterator)) {
+        ResultNode keptBlock;
+        keptBlock.level = block.level;
+        for (auto& paragraph : block.children) {
+            ResultNode keptParagraph;
+            keptParagraph.level = paragraph.level;
+            for (auto& line : paragraph.children) {
+                ++result.regionCount;
+                area += boxArea(line);
+                if (line.children.empty() || !std::all_of(line.children.begin(), line.children.end(), isRecognized)) {
+                    continue;
+                }
+                ++result.regionsRecognized;
+                recognizedArea += boxArea(line);
+                appendChild(keptParagraph, std::move(line));
+            }
+            if (!keptParagraph.children.empty()) {
+                summarize(keptParagraph);
+                appendChild(keptBlock, std::move(keptParagraph));
+            }
+        }
+        if (!keptBlock.children.empty()) {
+            summarize(keptBlock);
+            result.blocks.push_back(std::move(keptBlock));
+        }
+    }
+
+    if (result.regionCount == 0) {
+        result.coverage = 1;
+    } else if (area > 0) {
+        result.coverage = recognizedArea / area;
+    } else {
+        result.coverage = static_cast<double>(result.regionsRecognized) / result.regionCount;
+    }
+    return true;
+}
+
+} // namespace g8
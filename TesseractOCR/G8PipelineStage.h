@@ -0,0 +1,64 @@
+//
+//  G8PipelineStage.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Converting the images to raw pixels.
+ */
+extern NSString *const kG8PipelineStageDecode;
+
+/**
+ *  Copying the pixels into Tesseract's image format in upright orientation.
+ */
+extern NSString *const kG8PipelineStagePreprocess;
+
+/**
+ *  Recognizing each page and rendering it into the document.
+ */
+extern NSString *const kG8PipelineStageRecognize;
+
+/**
+ *  `G8PipelineStage` tells how busy one stage of a multi-page recognition
+ *  was. See `pipelineStages` in G8Tesseract.h.
+ */
+@interface G8PipelineStage : NSObject
+
+/**
+ *  The name of the stage, one of the kG8PipelineStage constants.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSString *name;
+
+/**
+ *  Number of pages the stage processed.
+ */
+@property (nonatomic, assign, readonly) NSUInteger pageCount;
+
+/**
+ *  Time the stage spent processing pages, summed over its threads.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval busyTime;
+
+/**
+ *  Fraction of the total time the stage's threads were busy, from `0` to
+ *  `1`. The stage with the highest utilization limits the throughput.
+ */
+@property (nonatomic, assign, readonly) double utilization;
+
+/**
+ *  Most pages waiting for the stage at once.
+ */
+@property (nonatomic, assign, readonly) NSUInteger maximumQueueDepth;
+
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                           pageCount:(NSUInteger)pageCount
+                            busyTime:(NSTimeInterval)busyTime
+                         utilization:(double)utilization
+                   maximumQueueDepth:(NSUInteger)maximumQueueDepth;
+
+@end
@@ -0,0 +1,42 @@
+//
+//  G8PipelineStage.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8PipelineStage.h"
+
+// Must match the stage names used in G8Tesseract.mm
+NSString *const kG8PipelineStageDecode = @"decode";
+NSString *const kG8PipelineStagePreprocess = @"preprocess";
+NSString *const kG8PipelineStageRecognize = @"recognize";
+
+@implementation G8PipelineStage
+
+- (instancetype)initWithName:(NSString *)name
+                   pageCount:(NSUInteger)pageCount
+                    busyTime:(NSTimeInterval)busyTime
+                 utilization:(double)utilization
+           maximumQueueDepth:(NSUInteger)maximumQueueDepth
+{
+    self = [super init];
+    if (self != nil) {
+        _name = [name copy];
+        _pageCount = pageCount;
+        _busyTime = busyTime;
+        _utilization = utilization;
+        _maximumQueueDepth = maximumQueueDepth;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@: %lu pages, %.3fs busy, %.0f%% utilization, queue up to %lu",
+            self.name, (unsigned long)self.pageCount, self.busyTime, self.utilization * 100,
+            (unsigned long)self.maximumQueueDepth];
+}
+
+@end
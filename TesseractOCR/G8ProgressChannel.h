@@ -0,0 +1,89 @@
+#ifndef G8ProgressChannel_h
+#define G8ProgressChannel_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8TextMonitor.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace g8 {
+
+/**
+ * A progress report derived from samples of a recognition.
+ */
+struct ProgressEvent {
+    int progress = 0;               ///< Percentage, 0-100
+    size_t words = 0;               ///< Words recognized so far
+    double elapsedSeconds = 0;      ///< Time since the channel started
+    double wordsPerSecond = 0;      ///< Mean recognition rate so far
+    double remainingSeconds = -1;   ///< Estimated time left, -1 while unknown
+    bool finished = false;          ///< Last event of the recognition
+    bool completed = false;         ///< Whether the recognition finished successfully
+};
+
+/**
+ * Turns progress samples taken at any rate into a few events: a sample
+ * becomes an event only if enough time passed and progress moved far enough
+ * since the last event. The final event is always delivered, once.
+ *
+ * Usage example:
+ * @code
+ * g8::ProgressChannel channel(0.1, 1);
+ * // On a timer:
+ * g8::ProgressEvent event;
+ * if (channel.sample(monitor.sample(), event)) {
+ *     deliver(event);
+ * }
+ * // When recognition returns:
+ * if (channel.finish(monitor.sample(), completed, event)) {
+ *     deliver(event);
+ * }
+ * @endcode
+ */
+class ProgressChannel final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Starts the clock used for rates and estimates.
+     * @param minimumInterval Minimum seconds between two events
+     * @param minimumDelta    Minimum increase of the percentage between two
+     *                        events, 0 to report every interval
+     */
+    ProgressChannel(double minimumInterval, int minimumDelta);
+
+    ProgressChannel(const ProgressChannel&) = delete;
+    ProgressChannel& operator=(const ProgressChannel&) = delete;
+
+    /**
+     * Considers a sample; thread-safe.
+     * @return true if the sample makes an event, false if it's coalesced
+     *         into a later one or the channel is finished
+     */
+    bool sample(const ProgressSample& sample, ProgressEvent& event);
+
+    /**
+     * Makes the final event; later samples are ignored. Thread-safe.
+     * @param completed Whether the recognition finished successfully
+     * @return false if the channel was already finished
+     */
+    bool finish(const ProgressSample& sample, bool completed, ProgressEvent& event);
+
+private:
+    ProgressEvent makeEvent(const ProgressSample& sample, Clock::time_point now) const;
+
+    const double minimumInterval_;
+    const int minimumDelta_;
+    const Clock::time_point start_;
+
+    std::mutex mutex_;
+    Clock::time_point lastEvent_;
+    int lastProgress_ = 0;
+    bool finished_ = false;
+};
+
+} // namespace g8
+
+#endif /* G8ProgressChannel_h */
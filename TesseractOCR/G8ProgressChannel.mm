@@ -0,0 +1,55 @@
+#import "G8ProgressChannel.h"
+
+namespace g8 {
+
+ProgressChannel::ProgressChannel(double minimumInterval, int minimumDelta)
+    : minimumInterval_(minimumInterval), minimumDelta_(minimumDelta), start_(Clock::now()), lastEvent_(start_) {
+}
+
+bool ProgressChannel::sample(const ProgressSample& sample, ProgressEvent& event) {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_
+        || std::chrono::duration<double>(now - lastEvent_).count() < minimumInterval_
+        || sample.progress - lastProgress_ < minimumDelta_) {
+        return false;
+    }
+    lastEvent_ = now;
+    lastProgress_ = sample.progress;
+    event = makeEvent(sample, now);
+    return true;
+}
+
+bool ProgressChannel::finish(const ProgressSample& sample, bool completed, ProgressEvent& event) {
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (finished_) {
+        return false;
+    }
+    finished_ = true;
+    event = makeEvent(sample, now);
+    event.finished = true;
+    event.completed = completed;
+    if (completed) {
+        event.progress = 100;
+        event.remainingSeconds = 0;
+    }
+    return true;
+}
+
+ProgressEvent ProgressChannel::makeEvent(const ProgressSample& sample, Clock::time_point now) const {
+    ProgressEvent event;
+    event.progress = sample.progress;
+    event.words = sample.words;
+    event.elapsedSeconds = std::chrono::duration<double>(now - start_).count();
+    if (event.elapsedSeconds > 0) {
+        event.wordsPerSecond = sample.words / event.elapsedSeconds;
+    }
+    // Assumes the rest of the page goes at the pace of what's done
+    if (sample.progress > 0) {
+        event.remainingSeconds = event.elapsedSeconds * (100 - sample.progress) / sample.progress;
+    }
+    return event;
+}
+
+} // namespace g8
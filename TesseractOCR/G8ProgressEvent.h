@@ -0,0 +1,77 @@
+//
+//  G8ProgressEvent.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  `G8ProgressEvent` reports the progress of a recognition. Events are
+ *  sampled at `progressEventInterval`, see `progressEventBlock` in
+ *  G8Tesseract.h.
+ */
+@interface G8ProgressEvent : NSObject <NSCopying>
+
+/**
+ *  The percentage of progress (between 0 and 100).
+ */
+@property (nonatomic, assign, readonly) NSUInteger progress;
+
+/**
+ *  Number of words recognized so far. `0` for parallel recognition, whose
+ *  progress is counted in regions.
+ */
+@property (nonatomic, assign, readonly) NSUInteger wordCount;
+
+/**
+ *  Time since the recognition started.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval elapsedTime;
+
+/**
+ *  Mean number of words recognized per second so far.
+ */
+@property (nonatomic, assign, readonly) CGFloat wordsPerSecond;
+
+/**
+ *  Estimated time until the recognition is done, or a negative value while
+ *  there is not enough progress to tell.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval estimatedTimeRemaining;
+
+/**
+ *  Whether this is the last event of the recognition.
+ */
+@property (nonatomic, assign, readonly, getter=isFinished) BOOL finished;
+
+/**
+ *  Whether the recognition finished successfully; only meaningful for the
+ *  last event.
+ */
+@property (nonatomic, assign, readonly, getter=isCompleted) BOOL completed;
+
+/**
+ *  Initialize a progress event with the data it will contain.
+ *
+ *  @param progress               The percentage of progress.
+ *  @param wordCount              Words recognized so far.
+ *  @param elapsedTime            Time since the recognition started.
+ *  @param wordsPerSecond         Mean recognition rate.
+ *  @param estimatedTimeRemaining Estimated time left, negative if unknown.
+ *  @param finished               Whether this is the last event.
+ *  @param completed              Whether the recognition succeeded.
+ *
+ *  @return The initialized progress event.
+ */
+- (nonnull instancetype)initWithProgress:(NSUInteger)progress
+                               wordCount:(NSUInteger)wordCount
+                             elapsedTime:(NSTimeInterval)elapsedTime
+                          wordsPerSecond:(CGFloat)wordsPerSecond
+                  estimatedTimeRemaining:(NSTimeInterval)estimatedTimeRemaining
+                                finished:(BOOL)finished
+                               completed:(BOOL)completed;
+
+@end
@@ -0,0 +1,47 @@
+//
+//  G8ProgressEvent.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8ProgressEvent.h"
+
+@implementation G8ProgressEvent
+
+- (instancetype)initWithProgress:(NSUInteger)progress
+                       wordCount:(NSUInteger)wordCount
+                     elapsedTime:(NSTimeInterval)elapsedTime
+                  wordsPerSecond:(CGFloat)wordsPerSecond
+          estimatedTimeRemaining:(NSTimeInterval)estimatedTimeRemaining
+                        finished:(BOOL)finished
+                       completed:(BOOL)completed
+{
+    self = [super init];
+    if (self != nil) {
+        _progress = progress;
+        _wordCount = wordCount;
+        _elapsedTime = elapsedTime;
+        _wordsPerSecond = wordsPerSecond;
+        _estimatedTimeRemaining = estimatedTimeRemaining;
+        _finished = finished;
+        _completed = completed;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%lu%% (%lu words, %.1f words/s, %.2fs left)%@",
+            (unsigned long)self.progress, (unsigned long)self.wordCount, self.wordsPerSecond,
+            self.estimatedTimeRemaining, self.isFinished ? @" finished" : @""];
+}
+
+@end
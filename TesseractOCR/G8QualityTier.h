@@ -0,0 +1,71 @@
+//
+//  G8QualityTier.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <TesseractOCR/G8Constants.h>
+
+/**
+ *  `G8QualityTier` is a level of quality a `G8RecognitionScheduler` steps
+ *  recognitions down to under load, trading accuracy for time. Each setting
+ *  left unset keeps the one of the recognized `G8Tesseract` object, so an
+ *  empty tier is full quality. See `qualityTiers` in
+ *  G8RecognitionScheduler.h.
+ */
+@interface G8QualityTier : NSObject <NSCopying>
+
+/**
+ *  The language used instead of the recognition's, typically a faster
+ *  model of the same language installed in the same tessdata folder, or
+ *  `nil` to keep it.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *language;
+
+/**
+ *  The page segmentation mode used instead of the recognition's, as a
+ *  `G8PageSegmentationMode` value, or `nil` to keep it. A restricted mode
+ *  such as `G8PageSegmentationModeSingleBlock` skips most of the layout
+ *  analysis.
+ */
+@property (nonatomic, strong, readonly, nullable) NSNumber *pageSegmentationMode;
+
+/**
+ *  The factor the image is scaled by before recognition, between `0` and
+ *  `1`. Recognized boxes are scaled back to the coordinates of the image.
+ *
+ *  @default Default value is 1
+ */
+@property (nonatomic, assign, readonly) CGFloat imageScale;
+
+/**
+ *  Whether the tier keeps every setting of the recognition.
+ */
+@property (nonatomic, assign, readonly, getter=isFullQuality) BOOL fullQuality;
+
+/**
+ *  Initialize a tier that keeps every setting of the recognition.
+ *
+ *  @return The initialized tier.
+ */
+- (nonnull instancetype)init;
+
+/**
+ *  Initialize a tier.
+ *
+ *  @param language             The language used instead, or `nil`.
+ *  @param pageSegmentationMode A `G8PageSegmentationMode` used instead, or
+ *                              `nil`.
+ *  @param imageScale           The factor the image is scaled by, `1` to
+ *                              keep its size.
+ *
+ *  @return The initialized tier.
+ */
+- (nonnull instancetype)initWithLanguage:(nullable NSString *)language
+                    pageSegmentationMode:(nullable NSNumber *)pageSegmentationMode
+                              imageScale:(CGFloat)imageScale NS_DESIGNATED_INITIALIZER;
+
+@end
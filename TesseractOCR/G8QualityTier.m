@@ -0,0 +1,51 @@
+//
+//  G8QualityTier.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8QualityTier.h"
+
+@implementation G8QualityTier
+
+- (instancetype)init
+{
+    return [self initWithLanguage:nil pageSegmentationMode:nil imageScale:1];
+}
+
+- (instancetype)initWithLanguage:(NSString *)language
+            pageSegmentationMode:(NSNumber *)pageSegmentationMode
+                      imageScale:(CGFloat)imageScale
+{
+    self = [super init];
+    if (self != nil) {
+        _language = [language copy];
+        _pageSegmentationMode = pageSegmentationMode;
+        _imageScale = imageScale > 0 && imageScale < 1 ? imageScale : 1;
+    }
+    return self;
+}
+
+- (BOOL)isFullQuality
+{
+    return self.language == nil && self.pageSegmentationMode == nil && self.imageScale >= 1;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (NSString *)description
+{
+    if (self.isFullQuality) {
+        return @"full quality";
+    }
+    return [NSString stringWithFormat:@"language %@, page segmentation mode %@, scale %.2f",
+            self.language ?: @"kept", self.pageSegmentationMode ?: @"kept", self.imageScale];
+}
+
+@end
@@ -0,0 +1,168 @@
+#ifndef G8QualityTiers_h
+#define G8QualityTiers_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Cancellation.h"
+#import "G8ResultNode.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Leptonica internals
+struct Pix;
+
+namespace g8 {
+
+struct EngineConfig;
+
+/**
+ * A level of quality recognitions can be stepped down to under load. Every
+ * setting left at its default keeps the one of the recognition.
+ */
+struct QualityTier {
+    std::string language;      ///< Model used instead, e.g. a fast one; empty to keep
+    int engineMode = -1;       ///< tesseract::OcrEngineMode used instead, -1 to keep
+    int pageSegMode = -1;      ///< tesseract::PageSegMode used instead, -1 to keep
+    double scale = 1;          ///< Factor the image is scaled by before recognition, in (0, 1]
+    std::map<std::string, std::string> variables;  ///< Runtime variables set on top
+
+    /**
+     * Whether the tier changes nothing, so that the recognition can run as
+     * configured.
+     */
+    bool isFull() const;
+
+    /**
+     * config with the tier's model and variables.
+     */
+    EngineConfig apply(const EngineConfig& config) const;
+};
+
+/**
+ * When a QualityController steps between tiers.
+ */
+struct QualityPolicy {
+    size_t tierCount = 1;              ///< Tiers to choose from, the full quality one included
+    double stepDownWaitSeconds = 1;    ///< Mean queue wait above which quality steps down
+    double stepUpWaitSeconds = 0.25;   ///< Mean queue wait below which quality may step up
+    double stepDownLoad = 2;           ///< ConcurrencyGovernor::load above which quality steps down
+    double stepUpLoad = 1;             ///< ConcurrencyGovernor::load below which quality may step up
+    double holdSeconds = 2;            ///< Least time between two steps, so that a step shows before the next
+};
+
+/**
+ * Steps a tier index up and down with load: 0 is the full quality tier,
+ * higher ones are cheaper. Quality steps down one tier when the mean queue
+ * wait or the processor load crosses its step down threshold, and back up
+ * once both are below their step up thresholds. Between two steps at least
+ * holdSeconds pass.
+ *
+ * Not thread-safe; the Scheduler calls it under its lock.
+ *
+ * Usage example:
+ * @code
+ * g8::QualityController controller(policy);
+ * size_t tier = controller.update(waitSeconds, g8::ConcurrencyGovernor::shared().load(), now);
+ * @endcode
+ */
+class QualityController final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit QualityController(const QualityPolicy& policy = QualityPolicy());
+
+    /**
+     * Replaces the policy; the tier is clamped to its tier count.
+     */
+    void setPolicy(const QualityPolicy& policy);
+
+    const QualityPolicy& policy() const noexcept { return policy_; }
+
+    /**
+     * Records the queue wait of a job about to start and the load, and
+     * steps if needed.
+     * @return The tier the job runs at
+     */
+    size_t update(double waitSeconds, double load, Clock::time_point now);
+
+    /**
+     * The current tier.
+     */
+    size_t tier() const noexcept { return tier_; }
+
+    /**
+     * The smoothed queue wait the decisions are based on.
+     */
+    double meanWaitSeconds() const noexcept { return meanWaitSeconds_; }
+
+private:
+    QualityPolicy policy_;
+    size_t tier_ = 0;
+    double meanWaitSeconds_ = 0;
+    Clock::time_point lastStep_;
+};
+
+/**
+ * How `recognizeAtTier` recognizes an image.
+ */
+struct TierRecognitionOptions {
+    int pageSegMode = -1;            ///< tesseract::PageSegMode unless the tier has one, -1 for the engine's
+    int left = 0;                    ///< Rectangle to recognize, in image pixels
+    int top = 0;
+    int width = 0;                   ///< 0 for the whole image
+    int height = 0;
+    int sourceResolution = 0;        ///< Resolution of the image, 0 to use the image's
+    int deadlineMsecs = 0;           ///< Time limit, 0 for none
+    CancellationToken cancellation;
+    std::function<bool()> shouldCancel;  ///< Polled during recognition if set
+};
+
+/**
+ * Results of a recognition at a reduced tier.
+ */
+struct TierResult {
+    std::vector<ResultNode> blocks;  ///< In the coordinates of the image as given
+    int meanConfidence = 0;          ///< TessBaseAPI::MeanTextConf, 0-100
+    bool cancelled = false;          ///< Whether recognition was cancelled or timed out
+
+    /**
+     * The page text, formatted like TessBaseAPI::GetUTF8Text.
+     */
+    std::string text() const;
+};
+
+/**
+ * Recognizes an image with the settings of a tier, on an engine from
+ * EnginePool created from the tier's configuration if the pool has none.
+ * A scaled down image is recognized at a proportionally lower resolution
+ * and the boxes are scaled back up.
+ *
+ * Usage example:
+ * @code
+ * g8::QualityTier fast;
+ * fast.language = "eng_fast";
+ * fast.scale = 0.5;
+ * g8::TierResult result;
+ * if (g8::recognizeAtTier(pix, config, fast, g8::TierRecognitionOptions(), result)) {
+ *     printf("%s", result.text().c_str());
+ * }
+ * @endcode
+ *
+ * @param pix     The image, not taken over
+ * @param config  Configuration of the recognition, adjusted by the tier
+ * @param tier    The tier
+ * @param options Rectangle, deadline and cancellation
+ * @param result  Receives the results
+ * @return false if the image couldn't be scaled, no engine could be created
+ *         or recognition was cancelled
+ */
+bool recognizeAtTier(Pix* pix, const EngineConfig& config, const QualityTier& tier,
+                     const TierRecognitionOptions& options, TierResult& result);
+
+} // namespace g8
+
+#endif /* G8QualityTiers_h */
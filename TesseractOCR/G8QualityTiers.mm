@@ -0,0 +1,181 @@
+#import "G8QualityTiers.h"
+#import "G8Engine.h"
+#import "G8EnginePool.h"
+#import "G8PixWrapper.h"
+#import "G8TextMonitor.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+#import <Tesseract/ocrclass.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace g8 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Weight of the latest queue wait in the mean the controller steps on
+constexpr double kWaitWeight = 0.25;
+
+/**
+ * Tells the monitor of a tiered recognition when to stop.
+ */
+class Interruption final {
+public:
+    explicit Interruption(const TierRecognitionOptions& options) : options_(options) {
+        if (options.deadlineMsecs > 0) {
+            deadline_ = Clock::now() + std::chrono::milliseconds(options.deadlineMsecs);
+        }
+    }
+
+    /**
+     * Whether recognition was cancelled or timed out; latches once it
+     * returns true.
+     */
+    bool interrupted() {
+        if (!interrupted_) {
+            interrupted_ = options_.cancellation.isCancelled() ||
+                           (deadline_ != Clock::time_point() && Clock::now() >= deadline_) ||
+                           (options_.shouldCancel && options_.shouldCancel());
+        }
+        return interrupted_;
+    }
+
+private:
+    const TierRecognitionOptions& options_;
+    Clock::time_point deadline_;
+    bool interrupted_ = false;
+};
+
+bool cancelCallback(void* interruption, int words) {
+    return static_cast<Interruption*>(interruption)->interrupted();
+}
+
+} // namespace
+
+bool QualityTier::isFull() const {
+    return language.empty() && engineMode < 0 && pageSegMode < 0 && !(scale > 0 && scale < 1) && variables.empty();
+}
+
+EngineConfig QualityTier::apply(const EngineConfig& config) const {
+    EngineConfig tiered = config;
+    if (!language.empty()) {
+        tiered.language = language;
+    }
+    if (engineMode >= 0) {
+        tiered.engineMode = engineMode;
+    }
+    for (const auto& variable : variables) {
+        tiered.variables[variable.first] = variable.second;
+    }
+    return tiered;
+}
+
+QualityController::QualityController(const QualityPolicy& policy) {
+    setPolicy(policy);
+}
+
+void QualityController::setPolicy(const QualityPolicy& policy) {
+    policy_ = policy;
+    policy_.tierCount = std::max<size_t>(policy.tierCount, 1);
+    tier_ = std::min(tier_, policy_.tierCount - 1);
+}
+
+size_t QualityController::update(double waitSeconds, double load, Clock::time_point now) {
+    meanWaitSeconds_ += kWaitWeight * (waitSeconds - meanWaitSeconds_);
+    if (lastStep_ != Clock::time_point() && now - lastStep_ < std::chrono::duration<double>(policy_.holdSeconds)) {
+        return tier_;
+    }
+
+    if ((meanWaitSeconds_ > policy_.stepDownWaitSeconds || load > policy_.stepDownLoad) &&
+        tier_ + 1 < policy_.tierCount) {
+        ++tier_;
+        lastStep_ = now;
+    } else if (meanWaitSeconds_ < policy_.stepUpWaitSeconds && load < policy_.stepUpLoad && tier_ > 0) {
+        --tier_;
+        lastStep_ = now;
+    }
+    return tier_;
+}
+
+std::string TierResult::text() const {
+    return resultText(blocks);
+}
+
+bool recognizeAtTier(Pix* pix, const EngineConfig& config, const QualityTier& tier,
+                     const TierRecognitionOptions& options, TierResult& result) {
+    result = TierResult();
+    if (!pix) {
+        return false;
+    }
+
+    const double scale = tier.scale > 0 && tier.scale < 1 ? tier.scale : 1;
+    PixWrapper scaled;
+    if (scale < 1) {
+        scaled.reset(pixScale(pix, static_cast<l_float32>(scale), static_cast<l_float32>(scale)));
+        if (!scaled) {
+            return false;
+        }
+    }
+
+    const EngineConfig tieredConfig = tier.apply(config);
+    std::unique_ptr<Engine> engine = EnginePool::shared().acquire(tieredConfig);
+    if (!engine) {
+        engine = Engine::create(tieredConfig);
+    }
+    if (!engine) {
+        return false;
+    }
+
+    tesseract::TessBaseAPI* api = engine->api();
+    const tesseract::PageSegMode pageSegMode = api->GetPageSegMode();
+    const int tieredPageSegMode = tier.pageSegMode >= 0 ? tier.pageSegMode : options.pageSegMode;
+    if (tieredPageSegMode >= 0) {
+        api->SetPageSegMode(static_cast<tesseract::PageSegMode>(tieredPageSegMode));
+    }
+    api->SetImage(scaled ? scaled.get() : pix);
+    if (options.width > 0 && options.height > 0) {
+        api->SetRectangle(static_cast<int>(std::floor(options.left * scale)),
+                          static_cast<int>(std::floor(options.top * scale)),
+                          std::max(1, static_cast<int>(std::lround(options.width * scale))),
+                          std::max(1, static_cast<int>(std::lround(options.height * scale))));
+    }
+    // A scaled image has fewer pixels per inch
+    const int resolution = options.sourceResolution > 0 ? options.sourceResolution : pixGetXRes(pix);
+    if (resolution > 0 && (options.sourceResolution > 0 || scale < 1)) {
+        api->SetSourceResolution(std::max(1, static_cast<int>(std::lround(resolution * scale))));
+    }
+
+    Interruption interruption(options);
+    TextMonitor monitor(cancelCallback, &interruption);
+    if (options.deadlineMsecs > 0) {
+        monitor.setDeadline(options.deadlineMsecs);
+    }
+
+    bool recognized = false;
+    if (api->Recognize(monitor.get()) == 0 && !interruption.interrupted()) {
+        recognized = true;
+        result.meanConfidence = api->MeanTextConf();
+        std::unique_ptr<tesseract::ResultIterator> iterator(api->GetIterator());
+        if (iterator) {
+            result.blocks = buildResultTree(*iterator);
+        }
+        if (scale < 1) {
+            for (auto& block : result.blocks) {
+                block.scale(1 / scale);
+            }
+        }
+    } else {
+        result.cancelled = interruption.interrupted();
+    }
+
+    api->Clear();
+    api->SetPageSegMode(pageSegMode);
+    EnginePool::shared().release(std::move(engine));
+    return recognized;
+}
+
+} // namespace g8
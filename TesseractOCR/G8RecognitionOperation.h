@@ -58,6 +58,18 @@ typedef void(^G8RecognitionOperationCallback)(G8Tesseract * _Nullable tesseract)
  */
 @property (nonatomic, copy, nullable) G8RecognitionOperationCallback progressCallbackBlock;
 
+/**
+ *  A `G8ProgressEventBlock` function that will be called with sampled
+ *  progress events, including words per second and the estimated time
+ *  remaining. Unlike `progressCallbackBlock`, it is rate limited and never
+ *  runs on the operation thread. Setting it sets `progressEventBlock` of
+ *  `tesseract`, see G8Tesseract.h for the sampling settings.
+ *
+ *  @note It will be called from main thread, unless `progressEventQueue`
+ *        of `tesseract` is changed.
+ */
+@property (nonatomic, copy, nullable) G8ProgressEventBlock progressEventBlock;
+
 /// The default initializer should not be used since the language Tesseract
 /// uses needs to be explicit.
 - (instancetype _Nonnull )init __attribute__((unavailable("Use initWithLanguage:language instead")));
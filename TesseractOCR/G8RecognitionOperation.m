@@ -59,6 +59,11 @@
 - (void)main
 {
     @autoreleasepool {
+        // Recognition stays on `tesseract` rather than g8::AsyncRecognizer:
+        // callers read every result from it, not just the text, and the
+        // delegate preprocesses the UIImage before it becomes a Pix.
+        // The operation queue already provides the worker thread.
+
         // Analyzing the layout must be performed before recognition
         [self.tesseract analyseLayout];
         
@@ -66,6 +71,31 @@
     }
 }
 
+- (G8ProgressEventBlock)progressEventBlock
+{
+    return self.tesseract.progressEventBlock;
+}
+
+- (void)setProgressEventBlock:(G8ProgressEventBlock)progressEventBlock
+{
+    self.tesseract.progressEventBlock = progressEventBlock;
+}
+
+- (void)cancel
+{
+    [super cancel];
+    [self.tesseract.cancellationToken cancel];
+}
+
+- (BOOL)respondsToSelector:(SEL)aSelector
+{
+    // Cancellation goes through the token, only poll a delegate that asks for it
+    if (aSelector == @selector(shouldCancelImageRecognitionForTesseract:)) {
+        return [self.delegate respondsToSelector:aSelector];
+    }
+    return [super respondsToSelector:aSelector];
+}
+
 - (void)progressImageRecognitionForTesseract:(G8Tesseract *)tesseract
 {
     self.progress = self.tesseract.progress / 100.0f;
@@ -0,0 +1,141 @@
+//
+//  G8RecognitionQueue.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+#import <TesseractOCR/G8Tesseract.h>
+
+@class G8RecognitionResult;
+
+/**
+ *  The type of a block function called when an image of a batch has been
+ *  recognized.
+ *
+ *  @param result The result of the image.
+ */
+typedef void(^G8RecognitionQueueItemCallback)(G8RecognitionResult * _Nonnull result);
+
+/**
+ *  The type of a block function called when a batch has been recognized.
+ *
+ *  @param results Array of `G8RecognitionResult` in batch order.
+ */
+typedef void(^G8RecognitionQueueCallback)(NSArray * _Nonnull results);
+
+/**
+ *  `G8RecognitionQueue` recognizes batches of images on a pool of threads,
+ *  each with its own engine. Idle threads take work from busy ones, so pages
+ *  of uneven complexity still keep all threads busy.
+ *
+ *  Unlike a `G8RecognitionOperation` per image, engines are created once per
+ *  thread and reused for every image of every batch. Engines are taken from
+ *  the prewarmed ones if available, see
+ *  `prewarmLanguages:engineModes:completion:` in G8Tesseract.h, and are
+ *  returned to them when the queue is deallocated.
+ */
+@interface G8RecognitionQueue : NSObject
+
+/**
+ *  The `G8Tesseract` object whose settings are used for every image, e.g.
+ *  `pageSegmentationMode`, `charWhitelist`, `sourceResolution` and
+ *  `maximumRecognitionTime`, which applies to each image. Its image, rect
+ *  and delegate are ignored.
+ */
+@property (nonatomic, strong, readonly, nonnull) G8Tesseract *tesseract;
+
+/**
+ *  The number of threads recognizing images.
+ */
+@property (nonatomic, assign, readonly) NSUInteger maximumConcurrency;
+
+/**
+ *  Whether requests for an image that is being recognized share its
+ *  recognition, e.g. the same frame submitted twice by a retry. Images are
+ *  matched by a hash of their pixels, and only with the same settings and
+ *  within the same batches between calls to `cancelAllRecognitions`; each
+ *  request still gets its own `G8RecognitionResult`. Results aren't cached,
+ *  an image submitted after its recognition is done is recognized again.
+ *
+ *  @default Default value is YES
+ */
+@property (atomic, assign) BOOL coalescesIdenticalImages;
+
+/**
+ *  The number of images answered with the recognition of an identical one,
+ *  see `coalescesIdenticalImages`.
+ */
+@property (nonatomic, assign, readonly) NSUInteger coalescedRequestCount;
+
+/// The default initializer should not be used since the language Tesseract
+/// uses needs to be explicit.
+- (instancetype _Nonnull)init __attribute__((unavailable("Use initWithLanguage:language instead")));
+
+/**
+ *  Initialize a G8RecognitionQueue with one thread per processor core.
+ *
+ *  @param language The language to use in recognition.
+ *
+ *  @return The initialized G8RecognitionQueue object, or `nil` if there
+ *          was an error.
+ */
+- (nullable instancetype)initWithLanguage:(nonnull NSString *)language;
+
+/**
+ *  Initialize a G8RecognitionQueue.
+ *
+ *  @param language           The language to use in recognition.
+ *  @param configDictionary   See the `G8Tesseract` initializer.
+ *  @param configFileNames    See the `G8Tesseract` initializer.
+ *  @param absoluteDataPath   See the `G8Tesseract` initializer.
+ *  @param engineMode         The engine mode to use in recognition.
+ *  @param maximumConcurrency The number of threads, `0` for one per
+ *                            processor core.
+ *
+ *  @return The initialized G8RecognitionQueue object, or `nil` if there
+ *          was an error.
+ */
+- (nullable instancetype)initWithLanguage:(nonnull NSString *)language
+                         configDictionary:(nullable NSDictionary *)configDictionary
+                          configFileNames:(nullable NSArray *)configFileNames
+                         absoluteDataPath:(nullable NSString *)absoluteDataPath
+                               engineMode:(G8OCREngineMode)engineMode
+                       maximumConcurrency:(NSUInteger)maximumConcurrency;
+
+/**
+ *  Recognize a batch of images and block until all of them are done.
+ *
+ *  @param images Array of `UIImage` objects, image file paths as `NSString`
+ *                or file `NSURL`s. Files are loaded on the recognition
+ *                threads.
+ *
+ *  @return Array of `G8RecognitionResult` in the order of `images`.
+ */
+- (nonnull NSArray *)recognizeImages:(nonnull NSArray *)images;
+
+/**
+ *  Recognize a batch of images in the background. Images of all batches
+ *  share the threads in the order they were submitted.
+ *
+ *  @param images         See `recognizeImages:`.
+ *  @param itemCompletion Called on the main queue as soon as an image is
+ *                        done, in completion order.
+ *  @param completion     Called on the main queue when the whole batch is
+ *                        done.
+ */
+- (void)recognizeImages:(nonnull NSArray *)images
+         itemCompletion:(nullable G8RecognitionQueueItemCallback)itemCompletion
+             completion:(nullable G8RecognitionQueueCallback)completion;
+
+/**
+ *  Cancel all batches submitted so far, whether running or waiting to start.
+ *  Their remaining images are reported as not recognized; batches submitted
+ *  afterwards are not affected.
+ */
+- (void)cancelAllRecognitions;
+
+@end
@@ -0,0 +1,223 @@
+//
+//  G8RecognitionQueue.mm
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8RecognitionQueue.h"
+
+#import "G8AsyncRecognizer.h"
+#import "G8RecognitionResult.h"
+#import "G8RequestCoalescer.h"
+#import "G8Tesseract+Internal.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+@interface G8RecognitionQueue () {
+    std::shared_ptr<g8::AsyncRecognizer> _recognizer;
+    g8::CancellationToken _cancellation;  // Shared by all batches since the last cancelAllRecognitions
+    std::shared_ptr<g8::RequestCoalescer> _coalescer;
+}
+
+@end
+
+@implementation G8RecognitionQueue
+
+- (instancetype)initWithLanguage:(NSString *)language
+{
+    return [self initWithLanguage:language
+                 configDictionary:nil
+                  configFileNames:nil
+                 absoluteDataPath:nil
+                       engineMode:G8OCREngineModeDefault
+               maximumConcurrency:0];
+}
+
+- (instancetype)initWithLanguage:(NSString *)language
+                configDictionary:(NSDictionary *)configDictionary
+                 configFileNames:(NSArray *)configFileNames
+                absoluteDataPath:(NSString *)absoluteDataPath
+                      engineMode:(G8OCREngineMode)engineMode
+              maximumConcurrency:(NSUInteger)maximumConcurrency
+{
+    self = [super init];
+    if (self != nil) {
+        _tesseract = [[G8Tesseract alloc] initWithLanguage:language
+                                          configDictionary:configDictionary
+                                           configFileNames:configFileNames
+                                          absoluteDataPath:absoluteDataPath
+                                                engineMode:engineMode];
+        if (!_tesseract.isEngineConfigured) {
+            return nil;
+        }
+        _maximumConcurrency = maximumConcurrency > 0
+            ? maximumConcurrency
+            : [NSProcessInfo processInfo].activeProcessorCount;
+        _coalescer = std::make_shared<g8::RequestCoalescer>();
+        _coalescesIdenticalImages = YES;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    // The recognizer finishes pending images when it's destroyed
+    _cancellation.cancel();
+}
+
+/**
+ * Returns the recognizer for the current settings, replacing it if they changed
+ */
+- (std::shared_ptr<g8::AsyncRecognizer>)recognizerForConfig:(const g8::EngineConfig &)config {
+    std::shared_ptr<g8::AsyncRecognizer> replaced;
+    std::shared_ptr<g8::AsyncRecognizer> recognizer;
+    @synchronized (self) {
+        if (!_recognizer || _recognizer->config() != config) {
+            replaced = std::move(_recognizer);
+            _recognizer = std::make_shared<g8::AsyncRecognizer>(config, self.maximumConcurrency);
+        }
+        recognizer = _recognizer;
+    }
+    // Waits for the images still queued on the old recognizer, so that its
+    // engines go back to the pool; outside the lock to let cancellation in
+    replaced.reset();
+    return recognizer;
+}
+
+/**
+ * Returns the recognition options for the current settings and cancellation
+ */
+- (g8::RecognitionOptions)recognitionOptions {
+    G8Tesseract *tesseract = self.tesseract;
+    g8::RecognitionOptions options;
+    options.pageSegMode = (int)tesseract.pageSegmentationMode;
+    options.sourceResolution = (int)tesseract.sourceResolution;
+    if (tesseract.maximumRecognitionTime > FLT_EPSILON) {
+        options.deadlineMsecs = static_cast<int>(tesseract.maximumRecognitionTime * 1000);
+    }
+    @synchronized (self) {
+        options.cancellation = _cancellation;
+    }
+    if (self.coalescesIdenticalImages) {
+        options.coalescer = _coalescer;
+    }
+    return options;
+}
+
+- (NSUInteger)coalescedRequestCount {
+    return _coalescer->statistics().coalesced;
+}
+
+/**
+ * Creates the loader of an image, which is converted on a worker thread.
+ * It doesn't retain the queue, so the recognizer is never destroyed by one
+ * of its own workers.
+ */
+- (g8::AsyncRecognizer::ImageLoader)loaderForImage:(id)source {
+    G8Tesseract *tesseract = self.tesseract;
+    return [tesseract, source]() -> Pix * {
+        @autoreleasepool {
+            UIImage *image = nil;
+            if ([source isKindOfClass:[UIImage class]]) {
+                image = source;
+            } else if ([source isKindOfClass:[NSString class]]) {
+                image = [UIImage imageWithContentsOfFile:source];
+            } else if ([source isKindOfClass:[NSURL class]] && [source isFileURL]) {
+                image = [UIImage imageWithContentsOfFile:[source path]];
+            }
+            if (!image) {
+                NSLog(@"ERROR: Can't load image %@", source);
+                return nullptr;
+            }
+            return [tesseract pixForImage:image];
+        }
+    };
+}
+
++ (G8RecognitionResult *)resultFromOutput:(const g8::RecognitionOutput &)output index:(NSUInteger)index {
+    NSString *text = output.recognized ? [NSString stringWithUTF8String:output.text.c_str()] : nil;
+    return [[G8RecognitionResult alloc] initWithIndex:index
+                                           recognized:output.recognized
+                                                 text:text
+                                           confidence:output.meanConfidence
+                                             duration:output.seconds];
+}
+
+- (NSArray *)recognizeImages:(NSArray *)images {
+    auto recognizer = [self recognizerForConfig:[self.tesseract engineConfig]];
+    g8::RecognitionOptions options = [self recognitionOptions];
+
+    std::vector<std::future<g8::RecognitionOutput>> outputs;
+    outputs.reserve(images.count);
+    for (id image in images) {
+        outputs.push_back(recognizer->submit([self loaderForImage:image], options));
+    }
+
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:outputs.size()];
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        [results addObject:[G8RecognitionQueue resultFromOutput:outputs[i].get() index:i]];
+    }
+    return [results copy];
+}
+
+- (void)recognizeImages:(NSArray *)images
+         itemCompletion:(G8RecognitionQueueItemCallback)itemCompletion
+             completion:(G8RecognitionQueueCallback)completion
+{
+    NSUInteger count = images.count;
+    if (count == 0) {
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(@[]);
+            });
+        }
+        return;
+    }
+
+    auto recognizer = [self recognizerForConfig:[self.tesseract engineConfig]];
+    g8::RecognitionOptions options = [self recognitionOptions];
+
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [results addObject:[NSNull null]];
+    }
+    auto pending = std::make_shared<std::atomic<NSUInteger>>(count);
+
+    for (NSUInteger i = 0; i < count; ++i) {
+        recognizer->submit([self loaderForImage:images[i]], options,
+                           [i, results, pending, itemCompletion, completion](g8::RecognitionOutput output) {
+            G8RecognitionResult *result = [G8RecognitionQueue resultFromOutput:output index:i];
+            if (itemCompletion) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    itemCompletion(result);
+                });
+            }
+            @synchronized (results) {
+                results[i] = result;
+            }
+            if (pending->fetch_sub(1) == 1 && completion) {
+                NSArray *batch = nil;
+                @synchronized (results) {
+                    batch = [results copy];
+                }
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    completion(batch);
+                });
+            }
+        });
+    }
+}
+
+- (void)cancelAllRecognitions {
+    @synchronized (self) {
+        _cancellation.cancel();
+        _cancellation = g8::CancellationToken();
+    }
+}
+
+@end
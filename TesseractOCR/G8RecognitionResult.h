@@ -0,0 +1,60 @@
+//
+//  G8RecognitionResult.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  `G8RecognitionResult` holds the outcome of recognizing one image of a
+ *  batch. See `G8RecognitionQueue`.
+ */
+@interface G8RecognitionResult : NSObject
+
+/**
+ *  The position of the image in the batch.
+ */
+@property (nonatomic, assign, readonly) NSUInteger index;
+
+/**
+ *  Whether the image was recognized. NO if it couldn't be loaded, if
+ *  recognition failed or if it was cancelled.
+ */
+@property (nonatomic, assign, readonly, getter=isRecognized) BOOL recognized;
+
+/**
+ *  The recognized text, nil if the image was not recognized.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *text;
+
+/**
+ *  The mean confidence of the recognized words (between 0 and 100).
+ */
+@property (nonatomic, assign, readonly) CGFloat confidence;
+
+/**
+ *  Time spent on loading and recognizing the image.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/**
+ *  Initialize a result with the data it will contain.
+ *
+ *  @param index      The position of the image in the batch.
+ *  @param recognized Whether the image was recognized.
+ *  @param text       The recognized text.
+ *  @param confidence The mean word confidence.
+ *  @param duration   Time spent on the image.
+ *
+ *  @return The initialized result.
+ */
+- (nonnull instancetype)initWithIndex:(NSUInteger)index
+                           recognized:(BOOL)recognized
+                                 text:(nullable NSString *)text
+                           confidence:(CGFloat)confidence
+                             duration:(NSTimeInterval)duration;
+
+@end
@@ -0,0 +1,37 @@
+//
+//  G8RecognitionResult.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8RecognitionResult.h"
+
+@implementation G8RecognitionResult
+
+- (instancetype)initWithIndex:(NSUInteger)index
+                   recognized:(BOOL)recognized
+                         text:(NSString *)text
+                   confidence:(CGFloat)confidence
+                     duration:(NSTimeInterval)duration
+{
+    self = [super init];
+    if (self != nil) {
+        _index = index;
+        _recognized = recognized;
+        _text = [text copy];
+        _confidence = confidence;
+        _duration = duration;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"#%lu %@ (%.0f%%, %.3fs)",
+            (unsigned long)self.index, self.isRecognized ? self.text : @"not recognized",
+            self.confidence, self.duration];
+}
+
+@end
@@ -0,0 +1,176 @@
+//
+//  G8RecognitionScheduler.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+#import <TesseractOCR/G8Constants.h>
+#import <TesseractOCR/G8Tesseract.h>
+
+@class G8QualityTier;
+@class G8SchedulerMetrics;
+
+/**
+ *  The type of a block function called when a scheduled recognition has
+ *  ended.
+ *
+ *  @param tesseract The `G8Tesseract` object that was scheduled.
+ *  @param outcome   Whether the recognition ran in full, degraded or not at
+ *                   all.
+ */
+typedef void(^G8RecognitionSchedulerCallback)(G8Tesseract * _Nonnull tesseract, G8SchedulingOutcome outcome);
+
+/**
+ *  `G8RecognitionScheduler` runs recognitions on a limited number of threads
+ *  by priority class, so that interactive scans don't wait behind bulk
+ *  document work. Within a class, the recognition with the earliest deadline
+ *  runs first; recognitions without a deadline run after those with one, in
+ *  scheduling order.
+ *
+ *  The run time of a recognition is estimated from the recent ones of its
+ *  class. A recognition that can't make its deadline, given the work queued
+ *  ahead of it, is rejected or degraded according to its
+ *  `G8OverloadPolicy`, either when it is scheduled or when it is about to
+ *  start.
+ *
+ *  With `qualityTiers` set, overload is met with lower quality first: while
+ *  recognitions wait too long for a thread or the processor is saturated,
+ *  recognitions start at cheaper tiers, and they step back up as the load
+ *  drops.
+ */
+@interface G8RecognitionScheduler : NSObject
+
+/**
+ *  The number of recognitions run at the same time.
+ */
+@property (nonatomic, assign, readonly) NSUInteger maximumConcurrency;
+
+/**
+ *  The `G8QualityTier` objects recognitions are stepped down through under
+ *  load, from full quality to the cheapest, e.g. a full quality tier, one
+ *  with a fast model and one that also halves the image and restricts the
+ *  page segmentation mode. The tier a recognition ran at is reported by
+ *  `recognizedQualityTier` of its `G8Tesseract` object.
+ *
+ *  @note Tiers that change the language recognize with an engine of their
+ *        own, created on first use; prewarm it to avoid the delay.
+ *
+ *  @default Default value is nil, every recognition runs at full quality.
+ */
+@property (nonatomic, copy, nullable) NSArray *qualityTiers;
+
+/**
+ *  The mean time recognitions wait for a thread above which quality steps
+ *  down one tier.
+ *
+ *  @default Default value is 1 second
+ */
+@property (nonatomic, assign) NSTimeInterval qualityStepDownWaitTime;
+
+/**
+ *  The mean time recognitions wait for a thread below which quality may
+ *  step up one tier.
+ *
+ *  @default Default value is 0.25 seconds
+ */
+@property (nonatomic, assign) NSTimeInterval qualityStepUpWaitTime;
+
+/**
+ *  The load above which quality steps down one tier: threads recognizing
+ *  plus recognitions waiting, per core of `coreBudget` in G8Tesseract.h.
+ *
+ *  @default Default value is 2
+ */
+@property (nonatomic, assign) double qualityStepDownLoad;
+
+/**
+ *  The load below which quality may step up one tier.
+ *
+ *  @default Default value is 1
+ */
+@property (nonatomic, assign) double qualityStepUpLoad;
+
+/**
+ *  The least time between two steps, so that the effect of a step shows
+ *  before the next one.
+ *
+ *  @default Default value is 2 seconds
+ */
+@property (nonatomic, assign) NSTimeInterval qualityStepInterval;
+
+/**
+ *  The index in `qualityTiers` of the tier recognitions start at now.
+ */
+@property (nonatomic, assign, readonly) NSUInteger currentQualityTier;
+
+/**
+ *  A scheduler shared by the whole app, with one thread per processor core.
+ *
+ *  @return The shared scheduler.
+ */
++ (nonnull instancetype)sharedScheduler;
+
+/**
+ *  Initialize a G8RecognitionScheduler with one thread per processor core.
+ *
+ *  @return The initialized G8RecognitionScheduler object.
+ */
+- (nonnull instancetype)init;
+
+/**
+ *  Initialize a G8RecognitionScheduler.
+ *
+ *  @param maximumConcurrency The number of recognitions run at the same
+ *                            time, `0` for one per processor core.
+ *
+ *  @return The initialized G8RecognitionScheduler object.
+ */
+- (nonnull instancetype)initWithMaximumConcurrency:(NSUInteger)maximumConcurrency NS_DESIGNATED_INITIALIZER;
+
+/**
+ *  Schedule `recognize` on a `G8Tesseract` object. The object must not be
+ *  used until the completion block is called.
+ *
+ *  @param tesseract  The `G8Tesseract` object with the image to recognize.
+ *  @param priority   The priority class of the recognition.
+ *  @param deadline   The time the recognition should be done by, or `nil`
+ *                    for none.
+ *  @param policy     What to do if the deadline can't be met.
+ *  @param completion Called on the main queue when the recognition has
+ *                    ended or has been rejected.
+ *
+ *  @return NO if the recognition was rejected right away, in which case the
+ *          completion block is still called.
+ */
+- (BOOL)scheduleRecognitionForTesseract:(nonnull G8Tesseract *)tesseract
+                               priority:(G8RecognitionPriority)priority
+                               deadline:(nullable NSDate *)deadline
+                         overloadPolicy:(G8OverloadPolicy)policy
+                             completion:(nullable G8RecognitionSchedulerCallback)completion;
+
+/**
+ *  Block until no scheduled recognition is waiting or running. Completion
+ *  blocks may still be pending on the main queue.
+ */
+- (void)waitUntilAllRecognitionsAreFinished;
+
+/**
+ *  Queue depth, wait times and outcome counts of a priority class.
+ *
+ *  @param priority The priority class.
+ *
+ *  @return A snapshot of the metrics.
+ */
+- (nonnull G8SchedulerMetrics *)metricsForPriority:(G8RecognitionPriority)priority;
+
+/**
+ *  Zero the counters, wait times and run time estimates of all priority
+ *  classes.
+ */
+- (void)resetMetrics;
+
+@end
@@ -0,0 +1,179 @@
+//
+//  G8RecognitionScheduler.mm
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8RecognitionScheduler.h"
+
+#import "G8QualityTier.h"
+#import "G8QualityTiers.h"
+#import "G8Scheduler.h"
+#import "G8SchedulerMetrics.h"
+#import "G8Tesseract+Internal.h"
+
+#include <chrono>
+#include <memory>
+
+@interface G8RecognitionScheduler () {
+    std::unique_ptr<g8::Scheduler> _scheduler;
+}
+
+@end
+
+@implementation G8RecognitionScheduler
+
++ (instancetype)sharedScheduler {
+    static G8RecognitionScheduler *sharedScheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[G8RecognitionScheduler alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (instancetype)init {
+    return [self initWithMaximumConcurrency:0];
+}
+
+- (instancetype)initWithMaximumConcurrency:(NSUInteger)maximumConcurrency {
+    self = [super init];
+    if (self != nil) {
+        _maximumConcurrency = maximumConcurrency > 0
+            ? maximumConcurrency
+            : [NSProcessInfo processInfo].activeProcessorCount;
+        _scheduler = std::make_unique<g8::Scheduler>(_maximumConcurrency);
+
+        g8::QualityPolicy policy;
+        _qualityStepDownWaitTime = policy.stepDownWaitSeconds;
+        _qualityStepUpWaitTime = policy.stepUpWaitSeconds;
+        _qualityStepDownLoad = policy.stepDownLoad;
+        _qualityStepUpLoad = policy.stepUpLoad;
+        _qualityStepInterval = policy.holdSeconds;
+    }
+    return self;
+}
+
+#pragma mark - Quality tiers
+
+- (void)setQualityTiers:(NSArray *)qualityTiers {
+    _qualityTiers = [qualityTiers copy];
+    [self updateQualityPolicy];
+}
+
+- (void)setQualityStepDownWaitTime:(NSTimeInterval)qualityStepDownWaitTime {
+    _qualityStepDownWaitTime = qualityStepDownWaitTime;
+    [self updateQualityPolicy];
+}
+
+- (void)setQualityStepUpWaitTime:(NSTimeInterval)qualityStepUpWaitTime {
+    _qualityStepUpWaitTime = qualityStepUpWaitTime;
+    [self updateQualityPolicy];
+}
+
+- (void)setQualityStepDownLoad:(double)qualityStepDownLoad {
+    _qualityStepDownLoad = qualityStepDownLoad;
+    [self updateQualityPolicy];
+}
+
+- (void)setQualityStepUpLoad:(double)qualityStepUpLoad {
+    _qualityStepUpLoad = qualityStepUpLoad;
+    [self updateQualityPolicy];
+}
+
+- (void)setQualityStepInterval:(NSTimeInterval)qualityStepInterval {
+    _qualityStepInterval = qualityStepInterval;
+    [self updateQualityPolicy];
+}
+
+- (void)updateQualityPolicy {
+    g8::QualityPolicy policy;
+    policy.tierCount = MAX(self.qualityTiers.count, (NSUInteger)1);
+    policy.stepDownWaitSeconds = self.qualityStepDownWaitTime;
+    policy.stepUpWaitSeconds = self.qualityStepUpWaitTime;
+    policy.stepDownLoad = self.qualityStepDownLoad;
+    policy.stepUpLoad = self.qualityStepUpLoad;
+    policy.holdSeconds = self.qualityStepInterval;
+    _scheduler->setQualityPolicy(policy);
+}
+
+- (NSUInteger)currentQualityTier {
+    return _scheduler->qualityTier();
+}
+
+#pragma mark - Scheduling
+
+- (BOOL)scheduleRecognitionForTesseract:(G8Tesseract *)tesseract
+                               priority:(G8RecognitionPriority)priority
+                               deadline:(NSDate *)deadline
+                         overloadPolicy:(G8OverloadPolicy)policy
+                             completion:(G8RecognitionSchedulerCallback)completion
+{
+    void (^finish)(G8SchedulingOutcome) = ^(G8SchedulingOutcome outcome) {
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(tesseract, outcome);
+            });
+        }
+    };
+
+    g8::Scheduler::Job job;
+    job.priority = static_cast<g8::Priority>(MIN(priority, G8RecognitionPriorityBackground));
+    job.policy = policy == G8OverloadPolicyDegrade ? g8::OverloadPolicy::Degrade : g8::OverloadPolicy::Reject;
+    if (deadline != nil) {
+        job.deadline = g8::Scheduler::Clock::now()
+            + std::chrono::duration_cast<g8::Scheduler::Clock::duration>(
+                std::chrono::duration<double>(MAX(deadline.timeIntervalSinceNow, 0)));
+    }
+
+    // Tiers as of scheduling, the index is only known when the job starts
+    NSArray *tiers = self.qualityTiers;
+    job.run = [tesseract, finish, tiers](const g8::Admission &admission) {
+        @autoreleasepool {
+            NSTimeInterval maximumRecognitionTime = tesseract.maximumRecognitionTime;
+            if (admission.degraded) {
+                NSTimeInterval remaining = admission.remainingMsecs / 1000.0;
+                if (maximumRecognitionTime <= FLT_EPSILON || remaining < maximumRecognitionTime) {
+                    tesseract.maximumRecognitionTime = remaining;
+                }
+            }
+            NSUInteger index = MIN(admission.tier, tiers.count > 0 ? tiers.count - 1 : 0);
+            G8QualityTier *tier = index < tiers.count ? tiers[index] : nil;
+            [tesseract recognizeAtQualityTier:tier index:index];
+            tesseract.maximumRecognitionTime = maximumRecognitionTime;
+
+            finish(admission.degraded ? G8SchedulingOutcomeDegraded : G8SchedulingOutcomeCompleted);
+        }
+    };
+    job.rejected = [finish]() {
+        finish(G8SchedulingOutcomeRejected);
+    };
+
+    return _scheduler->submit(std::move(job));
+}
+
+- (void)waitUntilAllRecognitionsAreFinished {
+    _scheduler->wait();
+}
+
+- (G8SchedulerMetrics *)metricsForPriority:(G8RecognitionPriority)priority {
+    g8::PriorityMetrics metrics = _scheduler->metrics(static_cast<g8::Priority>(MIN(priority, G8RecognitionPriorityBackground)));
+    return [[G8SchedulerMetrics alloc] initWithPriority:priority
+                                             queueDepth:metrics.queued
+                                           runningCount:metrics.running
+                                         completedCount:metrics.completed
+                                          degradedCount:metrics.degraded
+                                          rejectedCount:metrics.rejected
+                                    reducedQualityCount:metrics.reducedQuality
+                                        averageWaitTime:metrics.meanWaitSeconds
+                                        maximumWaitTime:metrics.maxWaitSeconds
+                               estimatedRecognitionTime:metrics.estimatedSeconds];
+}
+
+- (void)resetMetrics {
+    _scheduler->resetMetrics();
+}
+
+@end
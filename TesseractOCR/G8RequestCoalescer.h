@@ -0,0 +1,110 @@
+#ifndef G8RequestCoalescer_h
+#define G8RequestCoalescer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8AsyncRecognizer.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * Counters of a RequestCoalescer.
+ */
+struct CoalescingStatistics {
+    size_t requests = 0;    ///< Requests seen so far
+    size_t coalesced = 0;   ///< Requests answered with the result of one already in flight
+    size_t inFlight = 0;    ///< Distinct recognitions running now
+};
+
+/**
+ * Lets concurrent requests for the same recognition share one: the first
+ * request for a key leads and recognizes the image, requests for the same
+ * key arriving before it's done follow and receive a copy of its result.
+ *
+ * Keys combine a hash of the pixels with everything that affects the
+ * result: the engine configuration, the recognition options and the
+ * cancellation token, so that cancelling one batch never cancels the
+ * requests of another. A request only follows a leader whose image is
+ * pixel for pixel the same, so a hash collision costs a recognition, never
+ * a wrong result. Nothing is cached; once the leader is done, the next
+ * request for the key recognizes the image again.
+ *
+ * Usage example:
+ * @code
+ * std::string key = g8::RequestCoalescer::key(pix, config, options);
+ * if (!coalescer.join(key, pix, completion)) {
+ *     g8::RecognitionOutput output = recognize(pix, options);
+ *     coalescer.finish(key, pix, output);
+ *     completion(output);
+ * }
+ * @endcode
+ */
+class RequestCoalescer final {
+public:
+    RequestCoalescer() = default;
+
+    RequestCoalescer(const RequestCoalescer&) = delete;
+    RequestCoalescer& operator=(const RequestCoalescer&) = delete;
+
+    /**
+     * A 64-bit hash of the size, depth and pixels of an image.
+     */
+    static uint64_t contentHash(Pix* pix);
+
+    /**
+     * The key of a recognition request.
+     * @param pix     The image, hashed with `contentHash`
+     * @param config  Configuration of the engine recognizing it
+     * @param options Recognition settings and cancellation; the progress
+     *                callback isn't part of the key
+     */
+    static std::string key(Pix* pix, const EngineConfig& config, const RecognitionOptions& options);
+
+    /**
+     * Joins the recognition in flight for key and an equal image, or starts
+     * leading a new one.
+     * @param key        Key of the request
+     * @param pix        The image; a leader's image must stay alive until
+     *                   it calls `finish`
+     * @param completion Called with the leader's result if the request
+     *                   follows; not kept otherwise
+     * @return true if the request follows, false if the caller leads and
+     *         must call `finish`
+     */
+    bool join(const std::string& key, Pix* pix, const AsyncRecognizer::Completion& completion);
+
+    /**
+     * Ends the recognition led for key and pix and calls the completions of
+     * its followers with copies of output, marked as coalesced, on the
+     * calling thread.
+     */
+    void finish(const std::string& key, Pix* pix, const RecognitionOutput& output);
+
+    /**
+     * Current load and counters.
+     */
+    CoalescingStatistics statistics() const;
+
+private:
+    /**
+     * A recognition in flight.
+     */
+    struct Flight {
+        Pix* pix;  ///< The leader's image, not owned
+        std::vector<AsyncRecognizer::Completion> followers;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<Flight>> flights_;  ///< By key; more than one only on hash collisions
+    CoalescingStatistics statistics_;
+};
+
+} // namespace g8
+
+#endif /* G8RequestCoalescer_h */
@@ -0,0 +1,107 @@
+#import "G8RequestCoalescer.h"
+#import <Leptonica/allheaders.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace g8 {
+
+uint64_t RequestCoalescer::contentHash(Pix* pix) {
+    // FNV-1a over 32-bit words, which keeps up with the copy into the engine
+    constexpr uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    if (!pix) {
+        return hash;
+    }
+
+    const l_int32 width = pixGetWidth(pix);
+    const l_int32 height = pixGetHeight(pix);
+    const l_int32 depth = pixGetDepth(pix);
+    for (uint64_t value : {uint64_t(width), uint64_t(height), uint64_t(depth)}) {
+        hash = (hash ^ value) * prime;
+    }
+
+    // Only the bits of each row that hold pixels, the padding may be garbage
+    const l_int32 wordsPerLine = pixGetWpl(pix);
+    const uint64_t bitsPerLine = uint64_t(width) * uint64_t(depth);
+    const l_int32 fullWords = static_cast<l_int32>(bitsPerLine / 32);
+    const uint32_t lastBits = static_cast<uint32_t>(bitsPerLine % 32);
+    const uint32_t lastMask = lastBits ? ~uint32_t(0) << (32 - lastBits) : 0;
+
+    const l_uint32* line = pixGetData(pix);
+    for (l_int32 y = 0; y < height && line; ++y, line += wordsPerLine) {
+        for (l_int32 x = 0; x < fullWords; ++x) {
+            hash = (hash ^ line[x]) * prime;
+        }
+        if (lastMask) {
+            hash = (hash ^ (line[fullWords] & lastMask)) * prime;
+        }
+    }
+    return hash;
+}
+
+std::string RequestCoalescer::key(Pix* pix, const EngineConfig& config, const RecognitionOptions& options) {
+    std::ostringstream stream;
+    stream << std::hex << contentHash(pix) << std::dec << '\x1f'
+           << (pix ? pixGetWidth(pix) : 0) << 'x' << (pix ? pixGetHeight(pix) : 0) << 'x' << (pix ? pixGetDepth(pix) : 0)
+           << '\x1f' << options.pageSegMode << '\x1f' << options.sourceResolution << '\x1f' << options.deadlineMsecs
+           << '\x1f' << options.cancellation.flag() << '\x1e' << config.key();
+    return stream.str();
+}
+
+bool RequestCoalescer::join(const std::string& key, Pix* pix, const AsyncRecognizer::Completion& completion) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.requests;
+    std::vector<Flight>& flights = flights_[key];
+    for (auto& flight : flights) {
+        // Equal keys only say that the hashes match
+        l_int32 same = 0;
+        if (pixEqual(flight.pix, pix, &same) == 0 && same) {
+            flight.followers.push_back(completion);
+            ++statistics_.coalesced;
+            return true;
+        }
+    }
+    flights.push_back(Flight{pix, {}});
+    ++statistics_.inFlight;
+    return false;
+}
+
+void RequestCoalescer::finish(const std::string& key, Pix* pix, const RecognitionOutput& output) {
+    std::vector<AsyncRecognizer::Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = flights_.find(key);
+        if (it == flights_.end()) {
+            return;
+        }
+        std::vector<Flight>& flights = it->second;
+        auto flight = std::find_if(flights.begin(), flights.end(), [pix](const Flight& candidate) {
+            return candidate.pix == pix;
+        });
+        if (flight == flights.end()) {
+            return;
+        }
+        completions = std::move(flight->followers);
+        flights.erase(flight);
+        if (flights.empty()) {
+            flights_.erase(it);
+        }
+        --statistics_.inFlight;
+    }
+
+    for (const auto& completion : completions) {
+        RecognitionOutput copy = output;
+        copy.coalesced = true;
+        if (completion) {
+            completion(std::move(copy));
+        }
+    }
+}
+
+CoalescingStatistics RequestCoalescer::statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+} // namespace g8
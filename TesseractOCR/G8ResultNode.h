@@ -0,0 +1,104 @@
+#ifndef G8ResultNode_h
+#define G8ResultNode_h
+
+#import <Foundation/Foundation.h>
+
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Tesseract internals
+namespace tesseract {
+class ResultIterator;
+}
+
+namespace g8 {
+
+/**
+ * An alternative recognized for a symbol.
+ */
+struct ResultChoice {
+    std::string text;
+    float confidence = 0;
+};
+
+/**
+ * Recognition result for one element of the page hierarchy, detached from
+ * the engine that produced it, so it outlives the engine's page state.
+ *
+ * Levels and boxes are as reported by tesseract::ResultIterator: `level` is
+ * a tesseract::PageIteratorLevel, the box is in image pixels with an
+ * exclusive right and bottom edge.
+ */
+struct ResultNode {
+    int level = 0;
+    std::string text;
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+    float confidence = 0;
+
+    bool isBold = false;            ///< Words only
+    bool isItalic = false;          ///< Words only
+    bool isFromDictionary = false;  ///< Words only
+    bool isNumeric = false;         ///< Words only
+
+    std::vector<ResultChoice> choices;  ///< Symbols only
+    std::vector<ResultNode> children;   ///< Elements one level deeper
+
+    /**
+     * Moves this node and all of its descendants by dx, dy pixels.
+     */
+    void offset(int dx, int dy);
+
+    /**
+     * Scales the boxes of this node and all of its descendants by factor,
+     * rounding outwards.
+     */
+    void scale(double factor);
+};
+
+/**
+ * Copies the results of a recognized page, block by block down to symbols.
+ * @param iterator Iterator over the page; it's moved to the end
+ * @return The blocks in reading order
+ */
+std::vector<ResultNode> buildResultTree(tesseract::ResultIterator& iterator);
+
+/**
+ * The nodes of a given level within roots, in order.
+ * @param level tesseract::PageIteratorLevel to collect
+ */
+std::vector<const ResultNode*> collectResultNodes(const std::vector<ResultNode>& roots, int level);
+
+/**
+ * Ends the text of each line of a paragraph the way ResultIterator does: a
+ * newline after every line and, after the last one, the empty line that
+ * separates paragraphs. The paragraph's text becomes that of its lines.
+ * For paragraphs whose lines come from different recognitions or were
+ * recognized again.
+ */
+void separateLines(ResultNode& paragraph);
+
+/**
+ * The page text as TessBaseAPI::GetUTF8Text formats it: one line of text per
+ * text line and an empty line after each paragraph, the last one included.
+ * @param blocks Page blocks in reading order
+ */
+std::string resultText(const std::vector<ResultNode>& blocks);
+
+/**
+ * The page as hOCR markup, in the form TessBaseAPI::GetHOCRText gives it: an
+ * ocr_page element with the blocks, paragraphs, lines and words, without
+ * the document around it. Line baselines aren't kept by the nodes and are
+ * left out.
+ * @param blocks     Page blocks in reading order
+ * @param pageNumber 0-based, appears 1-based in element ids
+ * @param width      Width of the page image in pixels
+ * @param height     Height of the page image in pixels
+ */
+std::string resultHOCR(const std::vector<ResultNode>& blocks, int pageNumber, int width, int height);
+
+} // namespace g8
+
+#endif /* G8ResultNode_h */
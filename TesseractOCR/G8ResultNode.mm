@@ -0,0 +1,222 @@
+#import "G8ResultNode.h"
+#import <Tesseract/baseapi.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace g8 {
+
+namespace {
+
+constexpr int kLevelCount = tesseract::RIL_SYMBOL + 1;
+
+ResultNode makeNode(const tesseract::ResultIterator& iterator, tesseract::PageIteratorLevel level) {
+    ResultNode node;
+    node.level = level;
+
+    std::unique_ptr<char[]> text(iterator.GetUTF8Text(level));
+    if (text) {
+        node.text = text.get();
+    }
+    iterator.BoundingBox(level, &node.left, &node.top, &node.right, &node.bottom);
+    node.confidence = iterator.Confidence(level);
+
+    if (level == tesseract::RIL_WORD) {
+        bool isUnderlined = false, isMonospace = false, isSerif = false, isSmallcaps = false;
+        int pointsize = 0, fontId = 0;
+        iterator.WordFontAttributes(&node.isBold, &node.isItalic, &isUnderlined, &isMonospace,
+                                    &isSerif, &isSmallcaps, &pointsize, &fontId);
+        node.isFromDictionary = iterator.WordIsFromDictionary();
+        node.isNumeric = iterator.WordIsNumeric();
+    } else if (level == tesseract::RIL_SYMBOL) {
+        tesseract::ChoiceIterator choice(iterator);
+        do {
+            const char* choiceText = choice.GetUTF8Text();
+            if (choiceText) {
+                node.choices.push_back(ResultChoice{choiceText, choice.Confidence()});
+            }
+        } while (choice.Next());
+    }
+    return node;
+}
+
+void trimLineBreaks(std::string& text) {
+    while (!text.empty() && text.back() == '\n') {
+        text.pop_back();
+    }
+}
+
+void collect(const std::vector<ResultNode>& nodes, int level, std::vector<const ResultNode*>& result) {
+    for (const auto& node : nodes) {
+        if (node.level == level) {
+            result.push_back(&node);
+        } else if (node.level < level) {
+            collect(node.children, level, result);
+        }
+    }
+}
+
+/**
+ * The hOCR element of a level, as TessBaseAPI::GetHOCRText writes it.
+ */
+struct HOCRElement {
+    const char* tag;
+    const char* className;
+    const char* idPrefix;
+    const char* indent;
+};
+
+constexpr HOCRElement kHOCRElements[] = {
+    {"div", "ocr_carea", "block", "   "},
+    {"p", "ocr_par", "par", "    "},
+    {"span", "ocr_line", "line", "     "},
+    {"span", "ocrx_word", "word", "      "},
+};
+
+void appendEscaped(std::string& hocr, const std::string& text) {
+    for (char c : text) {
+        switch (c) {
+            case '&': hocr += "&amp;"; break;
+            case '<': hocr += "&lt;"; break;
+            case '>': hocr += "&gt;"; break;
+            case '"': hocr += "&quot;"; break;
+            case '\'': hocr += "&#39;"; break;
+            default: hocr += c; break;
+        }
+    }
+}
+
+void appendHOCR(std::string& hocr, const ResultNode& node, const std::string& page, int* counts) {
+    if (node.level < tesseract::RIL_BLOCK || node.level > tesseract::RIL_WORD) {
+        return;
+    }
+    const HOCRElement& element = kHOCRElements[node.level];
+    hocr += element.indent;
+    hocr += std::string("<") + element.tag + " class='" + element.className + "' id='" + element.idPrefix + '_' + page
+            + '_' + std::to_string(++counts[node.level]) + "' title='bbox " + std::to_string(node.left) + ' '
+            + std::to_string(node.top) + ' ' + std::to_string(node.right) + ' ' + std::to_string(node.bottom);
+    if (node.level != tesseract::RIL_WORD) {
+        hocr += "'>\n";
+        for (const auto& child : node.children) {
+            appendHOCR(hocr, child, page, counts);
+        }
+        hocr += std::string(element.indent) + "</" + element.tag + ">\n";
+        return;
+    }
+
+    hocr += "; x_wconf " + std::to_string(static_cast<int>(node.confidence)) + "'>";
+    if (node.isBold) {
+        hocr += "<strong>";
+    }
+    if (node.isItalic) {
+        hocr += "<em>";
+    }
+    appendEscaped(hocr, node.text);
+    if (node.isItalic) {
+        hocr += "</em>";
+    }
+    if (node.isBold) {
+        hocr += "</strong>";
+    }
+    hocr += "</span>\n";
+}
+
+} // namespace
+
+void ResultNode::offset(int dx, int dy) {
+    left += dx;
+    right += dx;
+    top += dy;
+    bottom += dy;
+    for (auto& child : children) {
+        child.offset(dx, dy);
+    }
+}
+
+void ResultNode::scale(double factor) {
+    left = static_cast<int>(std::floor(left * factor));
+    top = static_cast<int>(std::floor(top * factor));
+    right = static_cast<int>(std::ceil(right * factor));
+    bottom = static_cast<int>(std::ceil(bottom * factor));
+    for (auto& child : children) {
+        child.scale(factor);
+    }
+}
+
+std::vector<ResultNode> buildResultTree(tesseract::ResultIterator& iterator) {
+    std::vector<ResultNode> blocks;
+    if (iterator.Empty(tesseract::RIL_SYMBOL)) {
+        return blocks;
+    }
+
+    // The innermost open node of each level; pointers are only kept to the
+    // last element of each vector, which stays put until its parent changes
+    ResultNode* open[kLevelCount] = {};
+    do {
+        for (int level = tesseract::RIL_BLOCK; level < kLevelCount; ++level) {
+            auto pageLevel = static_cast<tesseract::PageIteratorLevel>(level);
+            if (open[level] && !iterator.IsAtBeginningOf(pageLevel)) {
+                continue;
+            }
+            std::vector<ResultNode>& siblings = level == tesseract::RIL_BLOCK ? blocks : open[level - 1]->children;
+            siblings.push_back(makeNode(iterator, pageLevel));
+            open[level] = &siblings.back();
+            for (int deeper = level + 1; deeper < kLevelCount; ++deeper) {
+                open[deeper] = nullptr;
+            }
+        }
+    } while (iterator.Next(tesseract::RIL_SYMBOL));
+    return blocks;
+}
+
+std::vector<const ResultNode*> collectResultNodes(const std::vector<ResultNode>& roots, int level) {
+    std::vector<const ResultNode*> result;
+    collect(roots, level, result);
+    return result;
+}
+
+void separateLines(ResultNode& paragraph) {
+    paragraph.text.clear();
+    for (size_t i = 0; i < paragraph.children.size(); ++i) {
+        std::string& text = paragraph.children[i].text;
+        trimLineBreaks(text);
+        text += '\n';
+        if (i + 1 == paragraph.children.size()) {
+            text += '\n';
+        }
+        paragraph.text += text;
+    }
+}
+
+std::string resultText(const std::vector<ResultNode>& blocks) {
+    std::string text;
+    for (const ResultNode* paragraph : collectResultNodes(blocks, tesseract::RIL_PARA)) {
+        if (paragraph->children.empty()) {
+            continue;
+        }
+        for (const auto& line : paragraph->children) {
+            std::string lineText = line.text;
+            trimLineBreaks(lineText);
+            text += lineText;
+            text += '\n';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+std::string resultHOCR(const std::vector<ResultNode>& blocks, int pageNumber, int width, int height) {
+    const std::string page = std::to_string(pageNumber + 1);
+    std::string hocr = "  <div class='ocr_page' id='page_" + page + "' title='image \"\"; bbox 0 0 "
+                       + std::to_string(width) + ' ' + std::to_string(height) + "; ppageno "
+                       + std::to_string(pageNumber) + "'>\n";
+    int counts[kLevelCount] = {};
+    for (const auto& block : blocks) {
+        appendHOCR(hocr, block, page, counts);
+    }
+    hocr += "  </div>\n";
+    return hocr;
+}
+
+} // namespace g8
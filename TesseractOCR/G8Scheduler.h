@@ -0,0 +1,205 @@
+#ifndef G8Scheduler_h
+#define G8Scheduler_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8QualityTiers.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * Priority classes of scheduled work, most urgent first. A job never runs
+ * while a job of a more urgent class is waiting.
+ */
+enum class Priority : int {
+    Interactive = 0,  ///< A user is waiting for the result, e.g. a single field scan
+    Default,          ///< Regular recognitions
+    Background,       ///< Bulk work, e.g. document batches
+};
+
+constexpr size_t kPriorityCount = 3;
+
+/**
+ * What to do with a job that is expected to miss its deadline.
+ */
+enum class OverloadPolicy : int {
+    Reject,   ///< Don't run it
+    Degrade,  ///< Run it with whatever time is left before the deadline
+};
+
+/**
+ * How a job was admitted when it started.
+ */
+struct Admission {
+    bool degraded = false;      ///< The job is expected to miss its deadline if run in full
+    int remainingMsecs = 0;     ///< Time left before the deadline, 0 if the job has none
+    double waitSeconds = 0;     ///< Time spent in the queue
+    size_t tier = 0;            ///< Quality tier to run at, 0 for full quality; see Scheduler::setQualityPolicy
+};
+
+/**
+ * Snapshot of the scheduler's state for one priority class.
+ */
+struct PriorityMetrics {
+    size_t queued = 0;            ///< Jobs waiting to start
+    size_t running = 0;           ///< Jobs running
+    size_t completed = 0;         ///< Jobs that ran, degraded ones included
+    size_t degraded = 0;          ///< Jobs that ran with a shortened time budget
+    size_t rejected = 0;          ///< Jobs that were not run
+    size_t reducedQuality = 0;    ///< Jobs that ran below the full quality tier
+    double meanWaitSeconds = 0;   ///< Mean time from submission to start of the jobs that ran
+    double maxWaitSeconds = 0;    ///< Longest time from submission to start
+    double estimatedSeconds = 0;  ///< Current estimate of a job's run time, 0 until one completed
+};
+
+/**
+ * Runs jobs on a fixed number of threads, most urgent priority class first
+ * and earliest deadline first within a class; jobs without a deadline run
+ * in submission order after those with one.
+ *
+ * The run time of a job is estimated from the recent jobs of its class. A
+ * job whose deadline can't be met anymore is rejected when submitted, if
+ * the work queued ahead of it already takes too long, or when it is about
+ * to start. With OverloadPolicy::Degrade it still runs as long as some time
+ * is left, and is told how much.
+ *
+ * Under a quality policy, jobs are also told a quality tier to run at,
+ * which steps down while the queue wait or the processor load is high and
+ * back up as it drops, so that overload costs quality before deadlines.
+ *
+ * Usage example:
+ * @code
+ * g8::Scheduler scheduler(2);
+ * g8::Scheduler::Job job;
+ * job.priority = g8::Priority::Interactive;
+ * job.deadline = g8::Scheduler::Clock::now() + std::chrono::milliseconds(500);
+ * job.run = [&](const g8::Admission& admission) {
+ *     engine->setDeadline(admission.remainingMsecs);
+ *     recognize(engine);
+ * };
+ * job.rejected = [] { showRetryButton(); };
+ * scheduler.submit(std::move(job));
+ * @endcode
+ */
+class Scheduler final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        Priority priority = Priority::Default;
+        Clock::time_point deadline = Clock::time_point::max();  ///< max() for none
+        OverloadPolicy policy = OverloadPolicy::Reject;
+        std::function<void(const Admission&)> run;  ///< Called on a scheduler thread
+        std::function<void()> rejected;             ///< Called instead of run, may be empty
+    };
+
+    /**
+     * Starts the scheduler threads.
+     * @param threadCount Number of jobs run at the same time, 0 for one per
+     *                    processor core
+     */
+    explicit Scheduler(size_t threadCount = 0);
+
+    /**
+     * Rejects the jobs still waiting and joins the threads once the running
+     * jobs are done.
+     */
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * Queues a job, or rejects it right away if it can't make its deadline.
+     * Rejection callbacks are called on the calling thread in that case.
+     * @return false if the job was rejected
+     */
+    bool submit(Job job);
+
+    /**
+     * Blocks until no job is waiting or running. Must not be called from a
+     * job.
+     */
+    void wait();
+
+    /**
+     * Number of jobs run at the same time.
+     */
+    size_t threadCount() const noexcept;
+
+    /**
+     * Current state of a priority class.
+     */
+    PriorityMetrics metrics(Priority priority) const;
+
+    /**
+     * Zeroes the counters, wait times and run time estimates.
+     */
+    void resetMetrics();
+
+    /**
+     * Sets when jobs step between quality tiers. With the default policy
+     * every job runs at full quality.
+     */
+    void setQualityPolicy(const QualityPolicy& policy);
+
+    /**
+     * The tier jobs start at now, 0 for full quality.
+     */
+    size_t qualityTier() const;
+
+private:
+    struct Entry {
+        Job job;
+        Clock::time_point submitted;
+        uint64_t sequence;
+    };
+
+    struct Slot {
+        bool busy = false;
+        Priority priority = Priority::Default;
+        Clock::time_point started;
+    };
+
+    struct ClassState {
+        size_t queued = 0;
+        size_t running = 0;
+        size_t completed = 0;
+        size_t degraded = 0;
+        size_t rejected = 0;
+        size_t reducedQuality = 0;
+        double totalWaitSeconds = 0;
+        double maxWaitSeconds = 0;
+        double estimatedSeconds = 0;
+    };
+
+    static bool runsBefore(const Entry& a, const Entry& b);
+    Clock::duration estimate(Priority priority) const;
+    Clock::duration backlogBefore(const Entry& entry, Clock::time_point now) const;
+    void run(size_t index);
+
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::condition_variable idle_;
+    std::vector<Entry> queue_;  ///< Heap ordered by runsBefore
+    std::vector<Slot> slots_;   ///< What each thread is running
+    std::array<ClassState, kPriorityCount> classes_;
+    QualityController quality_;
+    uint64_t nextSequence_ = 0;
+    size_t running_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace g8
+
+#endif /* G8Scheduler_h */
@@ -0,0 +1,246 @@
+#import "G8Scheduler.h"
+#import "G8ConcurrencyGovernor.h"
+
+#include <algorithm>
+
+namespace g8 {
+
+namespace {
+
+// Weight of the latest run time in the moving estimate of a class
+constexpr double kEstimateWeight = 0.25;
+
+double secondsBetween(Scheduler::Clock::time_point from, Scheduler::Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+} // namespace
+
+Scheduler::Scheduler(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    slots_.resize(threadCount);
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+Scheduler::~Scheduler() {
+    std::vector<Entry> waiting;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        waiting.swap(queue_);
+        for (const auto& entry : waiting) {
+            ClassState& state = classes_[static_cast<size_t>(entry.job.priority)];
+            --state.queued;
+            ++state.rejected;
+        }
+        ConcurrencyGovernor::shared().removePending(waiting.size());
+    }
+    available_.notify_all();
+    for (auto& entry : waiting) {
+        if (entry.job.rejected) {
+            entry.job.rejected();
+        }
+    }
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+bool Scheduler::runsBefore(const Entry& a, const Entry& b) {
+    if (a.job.priority != b.job.priority) {
+        return a.job.priority < b.job.priority;
+    }
+    if (a.job.deadline != b.job.deadline) {
+        return a.job.deadline < b.job.deadline;
+    }
+    return a.sequence < b.sequence;
+}
+
+Scheduler::Clock::duration Scheduler::estimate(Priority priority) const {
+    double seconds = classes_[static_cast<size_t>(priority)].estimatedSeconds;
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+}
+
+Scheduler::Clock::duration Scheduler::backlogBefore(const Entry& entry, Clock::time_point now) const {
+    Clock::duration work = Clock::duration::zero();
+    for (const auto& other : queue_) {
+        if (runsBefore(other, entry)) {
+            work += estimate(other.job.priority);
+        }
+    }
+    for (const auto& slot : slots_) {
+        if (slot.busy) {
+            work += std::max(Clock::duration::zero(), estimate(slot.priority) - (now - slot.started));
+        }
+    }
+    return work / static_cast<Clock::rep>(slots_.size());
+}
+
+bool Scheduler::submit(Job job) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Clock::time_point now = Clock::now();
+    Entry entry{std::move(job), now, nextSequence_++};
+
+    bool admitted = !stopping_;
+    if (admitted && entry.job.deadline != Clock::time_point::max()) {
+        Clock::time_point start = now + backlogBefore(entry, now);
+        if (entry.job.policy == OverloadPolicy::Reject) {
+            start += estimate(entry.job.priority);
+        }
+        admitted = start < entry.job.deadline;
+    }
+
+    ClassState& state = classes_[static_cast<size_t>(entry.job.priority)];
+    if (!admitted) {
+        ++state.rejected;
+        lock.unlock();
+        if (entry.job.rejected) {
+            entry.job.rejected();
+        }
+        return false;
+    }
+
+    ++state.queued;
+    ConcurrencyGovernor::shared().addPending();
+    queue_.push_back(std::move(entry));
+    std::push_heap(queue_.begin(), queue_.end(), [](const Entry& a, const Entry& b) {
+        return runsBefore(b, a);
+    });
+    lock.unlock();
+    available_.notify_one();
+    return true;
+}
+
+void Scheduler::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && running_ == 0; });
+}
+
+size_t Scheduler::threadCount() const noexcept {
+    return threads_.size();
+}
+
+PriorityMetrics Scheduler::metrics(Priority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const ClassState& state = classes_[static_cast<size_t>(priority)];
+
+    PriorityMetrics metrics;
+    metrics.queued = state.queued;
+    metrics.running = state.running;
+    metrics.completed = state.completed;
+    metrics.degraded = state.degraded;
+    metrics.rejected = state.rejected;
+    metrics.reducedQuality = state.reducedQuality;
+    size_t started = state.completed + state.running;
+    metrics.meanWaitSeconds = started > 0 ? state.totalWaitSeconds / started : 0;
+    metrics.maxWaitSeconds = state.maxWaitSeconds;
+    metrics.estimatedSeconds = state.estimatedSeconds;
+    return metrics;
+}
+
+void Scheduler::resetMetrics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& state : classes_) {
+        state.completed = 0;
+        state.degraded = 0;
+        state.rejected = 0;
+        state.reducedQuality = 0;
+        state.totalWaitSeconds = 0;
+        state.maxWaitSeconds = 0;
+        state.estimatedSeconds = 0;
+    }
+}
+
+void Scheduler::setQualityPolicy(const QualityPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    quality_.setPolicy(policy);
+}
+
+size_t Scheduler::qualityTier() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return quality_.tier();
+}
+
+void Scheduler::run(size_t index) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        available_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+
+        std::pop_heap(queue_.begin(), queue_.end(), [](const Entry& a, const Entry& b) {
+            return runsBefore(b, a);
+        });
+        Entry entry = std::move(queue_.back());
+        queue_.pop_back();
+
+        Clock::time_point now = Clock::now();
+        ClassState& state = classes_[static_cast<size_t>(entry.job.priority)];
+        --state.queued;
+        ConcurrencyGovernor::shared().removePending();
+
+        // Check the deadline again, the queue may have taken longer than expected
+        Admission admission;
+        bool admitted = true;
+        if (entry.job.deadline != Clock::time_point::max()) {
+            Clock::duration remaining = entry.job.deadline - now;
+            bool onTime = remaining > estimate(entry.job.priority);
+            admitted = remaining > Clock::duration::zero()
+                && (onTime || entry.job.policy == OverloadPolicy::Degrade);
+            admission.degraded = !onTime;
+            admission.remainingMsecs = static_cast<int>(std::max<Clock::rep>(1,
+                std::chrono::duration_cast<std::chrono::milliseconds>(remaining).count()));
+        }
+
+        if (!admitted) {
+            ++state.rejected;
+            lock.unlock();
+            if (entry.job.rejected) {
+                entry.job.rejected();
+            }
+            lock.lock();
+            if (queue_.empty() && running_ == 0) {
+                idle_.notify_all();
+            }
+            continue;
+        }
+
+        admission.waitSeconds = secondsBetween(entry.submitted, now);
+        admission.tier = quality_.update(admission.waitSeconds, ConcurrencyGovernor::shared().load(), now);
+        state.reducedQuality += admission.tier > 0 ? 1 : 0;
+        state.totalWaitSeconds += admission.waitSeconds;
+        state.maxWaitSeconds = std::max(state.maxWaitSeconds, admission.waitSeconds);
+        state.degraded += admission.degraded ? 1 : 0;
+        ++state.running;
+        ++running_;
+        slots_[index] = Slot{true, entry.job.priority, now};
+        lock.unlock();
+
+        entry.job.run(admission);
+        // Release the job's captures before reporting it done
+        entry.job = Job();
+
+        lock.lock();
+        // Degraded and cheaper jobs would bias the estimate of full ones
+        if (!admission.degraded && admission.tier == 0) {
+            double seconds = secondsBetween(now, Clock::now());
+            state.estimatedSeconds = state.estimatedSeconds > 0
+                ? state.estimatedSeconds + kEstimateWeight * (seconds - state.estimatedSeconds)
+                : seconds;
+        }
+        --state.running;
+        ++state.completed;
+        slots_[index].busy = false;
+        if (--running_ == 0 && queue_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+} // namespace g8
@@ -0,0 +1,97 @@
+//
+//  G8SchedulerMetrics.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <TesseractOCR/G8Constants.h>
+
+/**
+ *  `G8SchedulerMetrics` is a snapshot of the state of one priority class of
+ *  a `G8RecognitionScheduler`. See `metricsForPriority:`.
+ */
+@interface G8SchedulerMetrics : NSObject <NSCopying>
+
+/**
+ *  The priority class described.
+ */
+@property (nonatomic, assign, readonly) G8RecognitionPriority priority;
+
+/**
+ *  Number of recognitions waiting to start.
+ */
+@property (nonatomic, assign, readonly) NSUInteger queueDepth;
+
+/**
+ *  Number of recognitions running.
+ */
+@property (nonatomic, assign, readonly) NSUInteger runningCount;
+
+/**
+ *  Number of recognitions that ran, degraded ones included.
+ */
+@property (nonatomic, assign, readonly) NSUInteger completedCount;
+
+/**
+ *  Number of recognitions that ran with a shortened time limit.
+ */
+@property (nonatomic, assign, readonly) NSUInteger degradedCount;
+
+/**
+ *  Number of recognitions that were not run.
+ */
+@property (nonatomic, assign, readonly) NSUInteger rejectedCount;
+
+/**
+ *  Number of recognitions that ran below the full quality tier, see
+ *  `qualityTiers` in G8RecognitionScheduler.h.
+ */
+@property (nonatomic, assign, readonly) NSUInteger reducedQualityCount;
+
+/**
+ *  Mean time from scheduling to start of the recognitions that ran.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval averageWaitTime;
+
+/**
+ *  Longest time from scheduling to start.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval maximumWaitTime;
+
+/**
+ *  The run time the scheduler expects of a recognition of this class, used
+ *  to decide whether it can make its deadline. `0` until one completed.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval estimatedRecognitionTime;
+
+/**
+ *  Initialize metrics with the data they will contain.
+ *
+ *  @param priority                 The priority class described.
+ *  @param queueDepth               Recognitions waiting to start.
+ *  @param runningCount             Recognitions running.
+ *  @param completedCount           Recognitions that ran.
+ *  @param degradedCount            Recognitions that ran degraded.
+ *  @param rejectedCount            Recognitions that were not run.
+ *  @param reducedQualityCount      Recognitions that ran below full quality.
+ *  @param averageWaitTime          Mean wait before start.
+ *  @param maximumWaitTime          Longest wait before start.
+ *  @param estimatedRecognitionTime Expected run time of a recognition.
+ *
+ *  @return The initialized metrics.
+ */
+- (nonnull instancetype)initWithPriority:(G8RecognitionPriority)priority
+                              queueDepth:(NSUInteger)queueDepth
+                            runningCount:(NSUInteger)runningCount
+                          completedCount:(NSUInteger)completedCount
+                           degradedCount:(NSUInteger)degradedCount
+                           rejectedCount:(NSUInteger)rejectedCount
+                     reducedQualityCount:(NSUInteger)reducedQualityCount
+                         averageWaitTime:(NSTimeInterval)averageWaitTime
+                         maximumWaitTime:(NSTimeInterval)maximumWaitTime
+                estimatedRecognitionTime:(NSTimeInterval)estimatedRecognitionTime;
+
+@end
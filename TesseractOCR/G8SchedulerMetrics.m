@@ -0,0 +1,55 @@
+//
+//  G8SchedulerMetrics.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8SchedulerMetrics.h"
+
+@implementation G8SchedulerMetrics
+
+- (instancetype)initWithPriority:(G8RecognitionPriority)priority
+                      queueDepth:(NSUInteger)queueDepth
+                    runningCount:(NSUInteger)runningCount
+                  completedCount:(NSUInteger)completedCount
+                   degradedCount:(NSUInteger)degradedCount
+                   rejectedCount:(NSUInteger)rejectedCount
+             reducedQualityCount:(NSUInteger)reducedQualityCount
+                 averageWaitTime:(NSTimeInterval)averageWaitTime
+                 maximumWaitTime:(NSTimeInterval)maximumWaitTime
+        estimatedRecognitionTime:(NSTimeInterval)estimatedRecognitionTime
+{
+    self = [super init];
+    if (self != nil) {
+        _priority = priority;
+        _queueDepth = queueDepth;
+        _runningCount = runningCount;
+        _completedCount = completedCount;
+        _degradedCount = degradedCount;
+        _rejectedCount = rejectedCount;
+        _reducedQualityCount = reducedQualityCount;
+        _averageWaitTime = averageWaitTime;
+        _maximumWaitTime = maximumWaitTime;
+        _estimatedRecognitionTime = estimatedRecognitionTime;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"priority %lu: %lu queued, %lu running, %lu completed (%lu degraded, %lu at reduced quality), %lu rejected, wait %.3fs (max %.3fs)",
+            (unsigned long)self.priority, (unsigned long)self.queueDepth, (unsigned long)self.runningCount,
+            (unsigned long)self.completedCount, (unsigned long)self.degradedCount,
+            (unsigned long)self.reducedQualityCount, (unsigned long)self.rejectedCount,
+            self.averageWaitTime, self.maximumWaitTime];
+}
+
+@end
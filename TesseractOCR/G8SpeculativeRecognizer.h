@@ -0,0 +1,100 @@
+#ifndef G8SpeculativeRecognizer_h
+#define G8SpeculativeRecognizer_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8Cancellation.h"
+#import "G8ResultNode.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Leptonica internals
+struct Pix;
+
+namespace g8 {
+
+struct EngineConfig;
+
+/**
+ * How `recognizeSpeculatively` races page segmentation modes.
+ */
+struct SpeculativeRecognitionOptions {
+    std::vector<int> pageSegModes;   ///< tesseract::PageSegMode values to try, most likely first
+    int winningConfidence = 85;      ///< MeanTextConf at which a finished mode wins and the others are cancelled, above 100 to always wait for all
+    int left = 0;                    ///< Rectangle to recognize, in image pixels
+    int top = 0;
+    int width = 0;                   ///< 0 for the whole image
+    int height = 0;
+    int sourceResolution = 0;        ///< Resolution given to the engines, 0 to use the image's
+    int deadlineMsecs = 0;           ///< Time limit for the whole race, 0 for none
+    CancellationToken cancellation;  ///< Cancels every mode
+    std::function<bool()> shouldCancel;  ///< Polled during recognition if set; calls are serialized
+};
+
+/**
+ * How one page segmentation mode did in a race.
+ */
+struct SpeculativeAttempt {
+    int pageSegMode = 0;
+    bool recognized = false;   ///< Whether the mode finished
+    bool cancelled = false;    ///< Whether it was stopped or skipped because another mode won, or the race was cancelled
+    int meanConfidence = 0;    ///< TessBaseAPI::MeanTextConf of a finished mode, 0-100
+    double seconds = 0;        ///< Time spent recognizing with this mode
+};
+
+/**
+ * Results of a race, those of the winning mode.
+ */
+struct SpeculativeResult {
+    int pageSegMode = -1;                      ///< The winning mode, -1 if none finished
+    int meanConfidence = 0;                    ///< Its MeanTextConf
+    std::vector<ResultNode> blocks;            ///< Its results, in image coordinates
+    std::vector<SpeculativeAttempt> attempts;  ///< One per mode, in the order of the options
+    bool cancelled = false;                    ///< Whether the race was cancelled or timed out
+
+    /**
+     * The page text, formatted like TessBaseAPI::GetUTF8Text.
+     */
+    std::string text() const;
+};
+
+/**
+ * Recognizes an image with several page segmentation modes at once, each on
+ * its own engine, and keeps the result with the highest mean confidence.
+ *
+ * As soon as a mode finishes with at least `winningConfidence`, the modes
+ * still running are cancelled through their monitors and those not started
+ * are skipped, so the race takes about as long as the winning mode alone.
+ * Otherwise every mode finishes and the most confident one wins; ties go
+ * to the mode listed first.
+ *
+ * Engines come from EnginePool and are created from config when the pool is
+ * empty; they're returned to the pool afterwards. The modes run on as many
+ * threads as the ConcurrencyGovernor grants, in the order given.
+ *
+ * Usage example:
+ * @code
+ * g8::SpeculativeRecognitionOptions options;
+ * options.pageSegModes = {tesseract::PSM_SINGLE_LINE, tesseract::PSM_SINGLE_BLOCK, tesseract::PSM_SPARSE_TEXT};
+ * g8::SpeculativeResult result;
+ * if (g8::recognizeSpeculatively(pix, config, options, result)) {
+ *     printf("%d: %s", result.pageSegMode, result.text().c_str());
+ * }
+ * @endcode
+ *
+ * @param pix     The image, not taken over; each engine works on a copy
+ * @param config  Configuration of the engines
+ * @param options Modes, winning confidence, cancellation and deadline
+ * @param result  Receives the winning results and a report per mode
+ * @return false if no mode finished, e.g. because the race was cancelled
+ */
+bool recognizeSpeculatively(Pix* pix,
+                            const EngineConfig& config,
+                            const SpeculativeRecognitionOptions& options,
+                            SpeculativeResult& result);
+
+} // namespace g8
+
+#endif /* G8SpeculativeRecognizer_h */
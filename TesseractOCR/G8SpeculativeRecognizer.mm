@@ -0,0 +1,205 @@
+#import "G8SpeculativeRecognizer.h"
+#import "G8ConcurrencyGovernor.h"
+#import "G8Engine.h"
+#import "G8EnginePool.h"
+#import "G8PixWrapper.h"
+#import "G8TaskPool.h"
+#import "G8TextMonitor.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+#import <Tesseract/ocrclass.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace g8 {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * State shared by the modes of one race.
+ */
+class Race final {
+public:
+    explicit Race(const SpeculativeRecognitionOptions& options) : options_(options) {
+        if (options.deadlineMsecs > 0) {
+            deadline_ = Clock::now() + std::chrono::milliseconds(options.deadlineMsecs);
+        }
+    }
+
+    /**
+     * Whether the modes still running should stop: a mode has won, or the
+     * race was cancelled or timed out.
+     */
+    bool shouldStop() {
+        return won_ || interrupted();
+    }
+
+    /**
+     * Whether the race was cancelled or timed out; latches once it returns
+     * true.
+     */
+    bool interrupted() {
+        if (interrupted_) {
+            return true;
+        }
+        if (options_.cancellation.isCancelled()) {
+            interrupted_ = true;
+        } else if (deadline_ != Clock::time_point() && Clock::now() >= deadline_) {
+            interrupted_ = true;
+        } else if (options_.shouldCancel) {
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            if (options_.shouldCancel()) {
+                interrupted_ = true;
+            }
+        }
+        return interrupted_;
+    }
+
+    /**
+     * Milliseconds until the deadline, 0 if there's none.
+     */
+    int remainingMsecs() const {
+        if (deadline_ == Clock::time_point()) {
+            return 0;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline_ - Clock::now());
+        return std::max(1, static_cast<int>(remaining.count()));
+    }
+
+    void win() noexcept {
+        won_ = true;
+    }
+
+private:
+    const SpeculativeRecognitionOptions& options_;
+    Clock::time_point deadline_;
+    std::atomic<bool> won_{false};
+    std::atomic<bool> interrupted_{false};
+    std::mutex callbackMutex_;
+};
+
+bool cancelCallback(void* race, int words) {
+    return static_cast<Race*>(race)->shouldStop();
+}
+
+/**
+ * One mode of a race and the results it produced.
+ */
+struct Attempt {
+    PixWrapper image;                ///< The engine's own copy of the image
+    SpeculativeAttempt report;
+    std::vector<ResultNode> blocks;
+};
+
+void runAttempt(Attempt& attempt, Race& race, const EngineConfig& config, const SpeculativeRecognitionOptions& options) {
+    if (race.shouldStop() || !attempt.image) {
+        attempt.report.cancelled = race.shouldStop();
+        return;
+    }
+    std::unique_ptr<Engine> engine = EnginePool::shared().acquire(config);
+    if (!engine) {
+        engine = Engine::create(config);
+    }
+    if (!engine) {
+        return;
+    }
+
+    const auto start = Clock::now();
+    tesseract::TessBaseAPI* api = engine->api();
+    const tesseract::PageSegMode pageSegMode = api->GetPageSegMode();
+    api->SetPageSegMode(static_cast<tesseract::PageSegMode>(attempt.report.pageSegMode));
+    api->SetImage(attempt.image.get());
+    if (options.width > 0 && options.height > 0) {
+        api->SetRectangle(options.left, options.top, options.width, options.height);
+    }
+    if (options.sourceResolution > 0) {
+        api->SetSourceResolution(options.sourceResolution);
+    }
+
+    TextMonitor monitor(cancelCallback, &race);
+    if (options.deadlineMsecs > 0) {
+        monitor.setDeadline(race.remainingMsecs());
+    }
+
+    // A mode finishing after another one won is dropped like a cancelled one
+    if (api->Recognize(monitor.get()) == 0 && !race.shouldStop()) {
+        attempt.report.recognized = true;
+        attempt.report.meanConfidence = api->MeanTextConf();
+        std::unique_ptr<tesseract::ResultIterator> iterator(api->GetIterator());
+        if (iterator) {
+            attempt.blocks = buildResultTree(*iterator);
+        }
+        if (attempt.report.meanConfidence >= options.winningConfidence) {
+            race.win();
+        }
+    } else {
+        attempt.report.cancelled = race.shouldStop();
+    }
+
+    api->Clear();
+    api->SetPageSegMode(pageSegMode);
+    EnginePool::shared().release(std::move(engine));
+    attempt.image.reset();
+    attempt.report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+std::string SpeculativeResult::text() const {
+    return resultText(blocks);
+}
+
+bool recognizeSpeculatively(Pix* pix,
+                            const EngineConfig& config,
+                            const SpeculativeRecognitionOptions& options,
+                            SpeculativeResult& result) {
+    result = SpeculativeResult();
+    if (!pix || options.pageSegModes.empty()) {
+        return false;
+    }
+
+    // Leptonica's reference counts aren't atomic, so the engines don't share
+    // the image
+    std::vector<Attempt> attempts(options.pageSegModes.size());
+    for (size_t i = 0; i < attempts.size(); ++i) {
+        attempts[i].report.pageSegMode = options.pageSegModes[i];
+        attempts[i].image.reset(pixCopy(nullptr, pix));
+    }
+
+    Race race(options);
+    {
+        ConcurrencyGovernor::Lease lease = ConcurrencyGovernor::shared().acquire(attempts.size());
+        TaskPool pool(lease.width());
+        for (auto& attempt : attempts) {
+            pool.submit([&attempt, &race, &config, &options] {
+                runAttempt(attempt, race, config, options);
+            });
+        }
+        pool.wait();
+    }
+
+    Attempt* winner = nullptr;
+    for (auto& attempt : attempts) {
+        if (attempt.report.recognized && (!winner || attempt.report.meanConfidence > winner->report.meanConfidence)) {
+            winner = &attempt;
+        }
+        result.attempts.push_back(attempt.report);
+    }
+    if (!winner) {
+        result.cancelled = race.interrupted();
+        return false;
+    }
+
+    result.pageSegMode = winner->report.pageSegMode;
+    result.meanConfidence = winner->report.meanConfidence;
+    result.blocks = std::move(winner->blocks);
+    return true;
+}
+
+} // namespace g8
@@ -0,0 +1,107 @@
+//
+//  G8StartupProfile.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Reading traineddata files, from storage or from memory.
+ */
+extern NSString *const kG8StartupPhaseRead;
+
+/**
+ *  Reading the component tables of the traineddata files.
+ */
+extern NSString *const kG8StartupPhaseIndex;
+
+/**
+ *  Parsing config files, unicharsets, dictionaries and models.
+ */
+extern NSString *const kG8StartupPhaseModel;
+
+/**
+ *  Applying runtime variables.
+ */
+extern NSString *const kG8StartupPhaseVariables;
+
+/**
+ *  `G8StartupPhase` is a timed step of engine initialization.
+ */
+@interface G8StartupPhase : NSObject
+
+/**
+ *  The name of the phase, one of the kG8StartupPhase constants.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSString *name;
+
+/**
+ *  Wall time spent in this phase.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/**
+ *  Number of bytes read from storage during this phase.
+ */
+@property (nonatomic, assign, readonly) NSUInteger bytes;
+
+- (nonnull instancetype)initWithName:(nonnull NSString *)name
+                            duration:(NSTimeInterval)duration
+                               bytes:(NSUInteger)bytes;
+
+@end
+
+/**
+ *  `G8StartupProfile` shows where the time of an engine initialization went.
+ *  See `startupProfile` in G8Tesseract.h.
+ *
+ *  @note Tesseract parses unicharsets, dictionaries and models inside a single
+ *        call, so they are reported together as the kG8StartupPhaseModel
+ *        phase. `componentSizes` tells which components it had to parse.
+ */
+@interface G8StartupProfile : NSObject
+
+/**
+ *  The phases of the initialization, as `G8StartupPhase` objects in execution
+ *  order.
+ */
+@property (nonatomic, copy, readonly, nonnull) NSArray *phases;
+
+/**
+ *  Sizes of the traineddata components, summed over all languages, keyed by
+ *  component name (e.g. @"lstm" or @"inttemp" as used by combine_tessdata).
+ */
+@property (nonatomic, copy, readonly, nonnull) NSDictionary *componentSizes;
+
+/**
+ *  Number of traineddata bytes served from memory instead of storage.
+ */
+@property (nonatomic, assign, readonly) NSUInteger cachedBytes;
+
+/**
+ *  Total duration of all phases.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+/**
+ *  Total number of bytes read from storage.
+ */
+@property (nonatomic, assign, readonly) NSUInteger bytesRead;
+
+- (nonnull instancetype)initWithPhases:(nonnull NSArray *)phases
+                        componentSizes:(nonnull NSDictionary *)componentSizes
+                           cachedBytes:(NSUInteger)cachedBytes;
+
+/**
+ *  Returns the phase with the given name.
+ *
+ *  @param name One of the kG8StartupPhase constants.
+ *
+ *  @return The phase or nil if there is no such phase.
+ */
+- (nullable G8StartupPhase *)phaseNamed:(nonnull NSString *)name;
+
+@end
@@ -0,0 +1,88 @@
+//
+//  G8StartupProfile.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8StartupProfile.h"
+
+// Must match the phase names of the core in G8Engine.mm
+NSString *const kG8StartupPhaseRead = @"read";
+NSString *const kG8StartupPhaseIndex = @"index";
+NSString *const kG8StartupPhaseModel = @"model";
+NSString *const kG8StartupPhaseVariables = @"variables";
+
+@implementation G8StartupPhase
+
+- (instancetype)initWithName:(NSString *)name
+                    duration:(NSTimeInterval)duration
+                       bytes:(NSUInteger)bytes
+{
+    self = [super init];
+    if (self != nil) {
+        _name = [name copy];
+        _duration = duration;
+        _bytes = bytes;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%@: %.3fs, %lu bytes", self.name, self.duration, (unsigned long)self.bytes];
+}
+
+@end
+
+@implementation G8StartupProfile
+
+- (instancetype)initWithPhases:(NSArray *)phases
+                componentSizes:(NSDictionary *)componentSizes
+                   cachedBytes:(NSUInteger)cachedBytes
+{
+    self = [super init];
+    if (self != nil) {
+        _phases = [phases copy];
+        _componentSizes = [componentSizes copy];
+        _cachedBytes = cachedBytes;
+    }
+    return self;
+}
+
+- (NSTimeInterval)totalDuration
+{
+    NSTimeInterval total = 0;
+    for (G8StartupPhase *phase in self.phases) {
+        total += phase.duration;
+    }
+    return total;
+}
+
+- (NSUInteger)bytesRead
+{
+    NSUInteger total = 0;
+    for (G8StartupPhase *phase in self.phases) {
+        total += phase.bytes;
+    }
+    return total;
+}
+
+- (G8StartupPhase *)phaseNamed:(NSString *)name
+{
+    for (G8StartupPhase *phase in self.phases) {
+        if ([phase.name isEqualToString:name]) {
+            return phase;
+        }
+    }
+    return nil;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%.3fs total: %@", self.totalDuration,
+            [self.phases componentsJoinedByString:@"; "]];
+}
+
+@end
@@ -0,0 +1,107 @@
+#ifndef G8TaskPool_h
+#define G8TaskPool_h
+
+#import <Foundation/Foundation.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * A fixed set of worker threads with a task queue each. Tasks submitted from
+ * outside the pool are spread over the queues round-robin, tasks submitted
+ * by a worker go to its own queue. Workers take their own tasks in FIFO
+ * order and steal from the back of other queues when they run dry, so
+ * uneven tasks still keep every thread busy.
+ *
+ * Usage example:
+ * @code
+ * g8::TaskPool pool(4);
+ * for (auto& region : regions) {
+ *     pool.submit([&region] { recognize(region); });
+ * }
+ * pool.wait();
+ * @endcode
+ */
+class TaskPool final {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Returned by `workerIndex` on threads that don't belong to the pool.
+     */
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * Starts the worker threads.
+     * @param threadCount Number of threads, 0 for one per processor core
+     */
+    explicit TaskPool(size_t threadCount = 0);
+
+    /**
+     * Runs the queued tasks to completion and joins the threads.
+     */
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * Queues a task. Tasks must not throw.
+     */
+    void submit(Task task);
+
+    /**
+     * Blocks until every task submitted so far has finished. Must not be
+     * called from a task.
+     */
+    void wait();
+
+    /**
+     * Number of worker threads.
+     */
+    size_t threadCount() const noexcept;
+
+    /**
+     * Index of the calling worker thread, from 0 to threadCount() - 1, e.g.
+     * to bind per-worker state; npos if called from another thread.
+     */
+    size_t workerIndex() const noexcept;
+
+    /**
+     * Number of tasks taken from another worker's queue so far.
+     */
+    size_t stealCount() const noexcept;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t index);
+    bool take(size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<size_t> steals_{0};
+
+    std::mutex mutex_;
+    std::condition_variable available_;
+    std::condition_variable idle_;
+    size_t queued_ = 0;   ///< Tasks waiting in any queue
+    size_t pending_ = 0;  ///< Tasks queued or running
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
+
+} // namespace g8
+
+#endif /* G8TaskPool_h */
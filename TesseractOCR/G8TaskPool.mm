@@ -0,0 +1,127 @@
+#import "G8TaskPool.h"
+
+#include <algorithm>
+
+namespace g8 {
+
+namespace {
+
+// The pool and queue index of the calling worker thread
+thread_local const TaskPool* currentPool = nullptr;
+thread_local size_t currentIndex = TaskPool::npos;
+
+} // namespace
+
+TaskPool::TaskPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, i] { run(i); });
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    available_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void TaskPool::submit(Task task) {
+    size_t index = workerIndex();
+    if (index == npos) {
+        index = nextQueue_++ % queues_.size();
+    }
+    // Count the task first, so that it can't finish before it's counted
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+        ++pending_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    available_.notify_one();
+}
+
+void TaskPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return pending_ == 0; });
+}
+
+size_t TaskPool::threadCount() const noexcept {
+    return threads_.size();
+}
+
+size_t TaskPool::workerIndex() const noexcept {
+    return currentPool == this ? currentIndex : npos;
+}
+
+size_t TaskPool::stealCount() const noexcept {
+    return steals_;
+}
+
+bool TaskPool::take(size_t index, Task& task) {
+    {
+        Queue& own = *queues_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    // Steal the task the victim would run last
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        Queue& victim = *queues_[(index + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            ++steals_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::run(size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        Task task;
+        if (take(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --queued_;
+            }
+            task();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                idle_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+} // namespace g8
@@ -0,0 +1,48 @@
+//
+//  G8Tesseract+Internal.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8Tesseract.h"
+#import "G8Engine.h"
+
+@class G8QualityTier;
+
+struct Pix;
+
+/**
+ *  Methods of `G8Tesseract` shared with the other classes of the framework.
+ *  Only import this header from Objective-C++ files.
+ */
+@interface G8Tesseract (Internal)
+
+/**
+ *  Builds the core engine configuration from the current settings.
+ *
+ *  @return Configuration equivalent to this instance's engine.
+ */
+- (g8::EngineConfig)engineConfig;
+
+/**
+ *  Converts an image to a Leptonica image. Safe to call from any thread.
+ *
+ *  @param image The image to convert.
+ *
+ *  @return A new Pix owned by the caller, or nullptr on failure.
+ */
+- (Pix *)pixForImage:(UIImage *)image;
+
+/**
+ *  Recognizes like `recognize`, with the settings of a quality tier.
+ *
+ *  @param tier  The tier, `nil` for full quality.
+ *  @param index The tier's index, reported by `recognizedQualityTier`.
+ *
+ *  @return Whether recognition succeeded.
+ */
+- (BOOL)recognizeAtQualityTier:(G8QualityTier *)tier index:(NSUInteger)index;
+
+@end
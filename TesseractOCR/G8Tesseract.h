@@ -11,6 +11,18 @@
 #import <TesseractOCR/G8Constants.h>
 #import <TesseractOCR/G8TesseractDelegate.h>
 
+@class G8CancellationToken;
+@class G8ProgressEvent;
+@class G8StartupProfile;
+@class G8TrainedDataReport;
+
+/**
+ *  The type of a block function called with the progress of a recognition.
+ *
+ *  @param event The sampled progress.
+ */
+typedef void(^G8ProgressEventBlock)(G8ProgressEvent * _Nonnull event);
+
 /**
  *  Default value of `sourceResolution` property.
  */
@@ -44,11 +56,114 @@ extern NSInteger const kG8MaxCredibleResolution;
  *  There are a variety of expensive-to-load constant data structures (mostly
  *  language dictionaries) that are cached globally. This function allows the
  *  clearing of these caches. It's safe to call this method, while a
- *  recognition is in progress. It's also called automatically on
- *  UIApplicationDidReceiveMemoryWarningNotification
+ *  recognition is in progress.
+ *
+ *  @note On UIApplicationDidReceiveMemoryWarningNotification the caches are
+ *        trimmed gradually instead, see `handleMemoryPressure:`.
  */
 + (void)clearCache;
 
+/**
+ *  Whether the raw traineddata files are kept in memory once read, so that
+ *  later instances for the same language skip the file system. Each cached
+ *  file takes as much memory as its size on disk on top of the models every
+ *  engine deserializes, and counts against `memoryBudget`. Defaults to NO;
+ *  disabling it drops the cached files.
+ */
+@property (class, nonatomic, assign) BOOL cachesTrainedData;
+
+/**
+ *  The number of bytes the library's caches (idle engines and traineddata)
+ *  may hold. When the budget is exceeded, the least recently used entries
+ *  are evicted. Defaults to an eighth of the device's physical
+ *  memory, between 64 MB and 512 MB; 0 means no limit.
+ */
+@property (class, nonatomic, assign) NSUInteger memoryBudget;
+
+/**
+ *  The number of bytes currently held by the library's caches.
+ */
+@property (class, nonatomic, assign, readonly) NSUInteger memoryUsage;
+
+/**
+ *  The number of threads all recognitions of the library may use together.
+ *  Recognitions in flight count one thread each; a recognition with a
+ *  `parallelRecognitionMode` splits its page over the threads left, so that
+ *  several instances or queues recognizing in parallel don't oversubscribe
+ *  the processor. A page is recognized on a single thread when the budget
+ *  is taken. Setting 0 restores the default of one thread per processor core.
+ */
+@property (class, nonatomic, assign) NSUInteger coreBudget;
+
+/**
+ *  The number of threads currently granted to recognitions, see `coreBudget`.
+ */
+@property (class, nonatomic, assign, readonly) NSUInteger coreUsage;
+
+/**
+ *  The entries currently held by the library's caches, least recently used
+ *  first. See `G8MemoryEntry`.
+ */
+@property (class, nonatomic, copy, readonly, nonnull) NSArray *cachedMemoryEntries;
+
+/**
+ *  The most recently evicted cache entries, oldest first. See `G8MemoryEntry`.
+ */
+@property (class, nonatomic, copy, readonly, nonnull) NSArray *evictedMemoryEntries;
+
+/**
+ *  Release cached memory according to the severity of the pressure.
+ *  Moderate pressure evicts the least recently used entries until about half
+ *  of the cached memory is released; critical pressure releases everything.
+ *  Tesseract's dictionary cache is cleared at either level.
+ *
+ *  This is called automatically on
+ *  UIApplicationDidReceiveMemoryWarningNotification: the first warning is
+ *  treated as moderate pressure, a repeated warning shortly after as critical.
+ *
+ *  @param level The severity of the memory pressure.
+ */
++ (void)handleMemoryPressure:(G8MemoryPressureLevel)level;
+
+/**
+ *  Prepare engines in the background, so that the first recognition doesn't
+ *  pay for loading traineddata and building lazily initialized structures.
+ *  One engine is initialized for every combination of language and engine
+ *  mode, warmed up with a tiny synthetic recognition and kept in a pool. The
+ *  next `G8Tesseract` initialized with the same language and engine mode (and
+ *  no custom configuration) adopts it instead of initializing its own.
+ *
+ *  Prewarmed engines count against `memoryBudget` and may be released under
+ *  memory pressure.
+ *
+ *  @param languages   Array of language strings, e.g. @"eng" or @"eng+ita".
+ *  @param engineModes Array of `G8OCREngineMode` values wrapped in NSNumber.
+ *                     Pass nil to use `G8OCREngineModeDefault`.
+ *  @param completion  Called on the main queue when all engines are ready.
+ *                     `success` is NO if any engine failed to initialize.
+ */
++ (void)prewarmLanguages:(nonnull NSArray *)languages
+             engineModes:(nullable NSArray *)engineModes
+              completion:(nullable void (^)(BOOL success))completion;
+
+/**
+ *  Prepare engines in the background for a custom tessdata location. See
+ *  `prewarmLanguages:engineModes:completion:`.
+ *
+ *  @param languages        Array of language strings.
+ *  @param engineModes      Array of `G8OCREngineMode` values wrapped in
+ *                          NSNumber, or nil for `G8OCREngineModeDefault`.
+ *  @param absoluteDataPath The same path you pass to
+ *                          `initWithLanguage:configDictionary:configFileNames:absoluteDataPath:engineMode:`.
+ *                          The "tessdata" folder must already be there.
+ *                          Pass nil for the application bundle.
+ *  @param completion       Called on the main queue when all engines are ready.
+ */
++ (void)prewarmLanguages:(nonnull NSArray *)languages
+             engineModes:(nullable NSArray *)engineModes
+        absoluteDataPath:(nullable NSString *)absoluteDataPath
+              completion:(nullable void (^)(BOOL success))completion;
+
 /**
  *  The language pack to use during recognition. A corresponding trained data
  *  file must exist in the "tessdata" folder of the project. For example, if
@@ -85,6 +200,14 @@ extern NSInteger const kG8MaxCredibleResolution;
  */
 @property (nonatomic, readonly, getter=isEngineConfigured) BOOL engineConfigured;
 
+/**
+ *  Where the time of the latest engine initialization went: reading the
+ *  traineddata files and parsing their components, per phase. For an engine
+ *  prepared by `prewarmLanguages:engineModes:completion:` this is the profile
+ *  of the prewarming. nil if the engine has not been configured.
+ */
+@property (nonatomic, strong, readonly, nullable) G8StartupProfile *startupProfile;
+
 /**
  *  A white list of characters that Tesseract should recognize. Any
  *  recognition string that Tesseract returns will only contain characters from
@@ -129,14 +252,252 @@ extern NSInteger const kG8MaxCredibleResolution;
 /**
  *  A time limit (in seconds, via `NSTimeInterval`) to limit Tesseract's time
  *  spent during recognition.
+ *
+ *  Recognition with a time limit is anytime: when the time runs out, the
+ *  text lines recognized so far are the results. `recognize` returns YES,
+ *  `partialResult` is set and `recognizedCoverage` tells how much of the
+ *  page was done. The page is recognized in reading order by a single
+ *  engine, unless `regionPriority` asks for another order.
+ *
+ *  @note Layout analysis counts against the limit but can't be
+ *        interrupted. Page segmentation modes for a single line or less,
+ *        speculative recognition and reduced quality tiers still stop
+ *        wherever the engine is when the time runs out.
  */
 @property (nonatomic, assign) NSTimeInterval maximumRecognitionTime;
 
+/**
+ *  The order in which the regions of a page are recognized with
+ *  `maximumRecognitionTime` set, see `G8RegionPriority` in G8Constants.h.
+ *  Another priority than reading order splits the page into regions (text
+ *  lines, unless `parallelRecognitionMode` asks for larger regions) after
+ *  layout analysis, and recognizes them with engines of their own. Results
+ *  are in reading order whatever the priority.
+ *
+ *  @default Default value is G8RegionPriorityReadingOrder
+ */
+@property (nonatomic, assign) G8RegionPriority regionPriority;
+
+/**
+ *  Whether the last recognition ran out of `maximumRecognitionTime` before
+ *  every region of the page was recognized. The results are those of the
+ *  regions done in time.
+ */
+@property (nonatomic, readonly) BOOL partialResult;
+
+/**
+ *  The number of regions the page was split into by the last region by
+ *  region recognition, or the number of its text lines if it ran out of
+ *  `maximumRecognitionTime` on a single engine; 0 otherwise.
+ */
+@property (nonatomic, readonly) NSUInteger regionCount;
+
+/**
+ *  The number of regions of `regionCount` that were recognized.
+ */
+@property (nonatomic, readonly) NSUInteger recognizedRegionCount;
+
+/**
+ *  The share of the page's text area (between 0 and 1) covered by the
+ *  results of the last recognition; 1 unless it was partial or finished
+ *  early.
+ */
+@property (nonatomic, readonly) CGFloat recognizedCoverage;
+
+/**
+ *  Whether and how `recognize` splits the page to recognize its parts on
+ *  several threads. Layout analysis runs once on the whole page, then each
+ *  block, paragraph or text line is recognized by its own engine and the
+ *  results are merged back in reading order. See `G8ParallelRecognitionMode`
+ *  in G8Constants.h for the available modes.
+ *
+ *  `recognizedText`, `characterChoices`, `recognizedBlocksByIteratorLevel:`,
+ *  `recognizedHierarchicalBlocksByIteratorLevel:` and
+ *  `recognizedHOCRForPageNumber:` return the merged results.
+ *  `recognizedPDFForImages:` recognizes its pages with a single engine.
+ *
+ *  Layout analysis follows `pageSegmentationMode`, so splitting by blocks
+ *  needs a mode that finds several blocks, e.g.
+ *  `G8PageSegmentationModeAuto`.
+ *
+ *  @note The additional engines are taken from the prewarmed ones if
+ *        available, see `prewarmLanguages:engineModes:completion:`, and are
+ *        kept for later pages. Each one needs about as much memory as this
+ *        instance's engine.
+ *
+ *  @default Default value is `G8ParallelRecognitionModeNone`
+ */
+@property (nonatomic, assign) G8ParallelRecognitionMode parallelRecognitionMode;
+
+/**
+ *  The maximum number of threads used by parallel recognition, see
+ *  `parallelRecognitionMode`. `0` uses one thread per processor core.
+ *  Fewer threads are used while other recognitions run, see `coreBudget`.
+ *
+ *  @default Default value is 0
+ */
+@property (nonatomic, assign) NSUInteger maximumConcurrency;
+
+/**
+ *  Page segmentation modes (`G8PageSegmentationMode` values as `NSNumber`)
+ *  to try at once when the layout of the image isn't known, e.g. whether a
+ *  crop is a single line, a block or sparse text. When set, `recognize`
+ *  runs every mode on its own engine and keeps the result with the highest
+ *  mean confidence instead of using `pageSegmentationMode` and
+ *  `parallelRecognitionMode`. As soon as a mode reaches
+ *  `speculativeWinningConfidence`, the others are cancelled, so recognition
+ *  takes about as long as the winning mode alone.
+ *
+ *  List the most likely modes first; they're started first when there are
+ *  fewer free cores than modes, see `coreBudget`. The mode that won is
+ *  reported by `recognizedPageSegmentationMode`.
+ *
+ *  @note The additional engines are taken from the prewarmed ones like
+ *        those of `parallelRecognitionMode`.
+ *
+ *  @default Default value is nil
+ */
+@property (nonatomic, copy) NSArray *speculativePageSegmentationModes;
+
+/**
+ *  The mean confidence (between 0 and 100) at which a mode of
+ *  `speculativePageSegmentationModes` wins without waiting for the others.
+ *  Above 100 every mode runs to the end.
+ *
+ *  @default Default value is 85
+ */
+@property (nonatomic, assign) NSUInteger speculativeWinningConfidence;
+
+/**
+ *  The page segmentation mode of the last recognition's results: the
+ *  winning one of `speculativePageSegmentationModes`, otherwise
+ *  `pageSegmentationMode`.
+ */
+@property (nonatomic, readonly) G8PageSegmentationMode recognizedPageSegmentationMode;
+
+/**
+ *  The index in `qualityTiers` of the `G8RecognitionScheduler` of the tier
+ *  the last recognition ran at; `0`, full quality, for recognitions not
+ *  run by a scheduler with quality tiers.
+ */
+@property (nonatomic, readonly) NSUInteger recognizedQualityTier;
+
+/**
+ *  The language of a slower, more accurate model, e.g. from tessdata_best,
+ *  to cascade to. When set, `recognize` first recognizes the page with
+ *  `language`, usually a fast model, then recognizes the words or lines
+ *  (see `cascadeLevel`) whose confidence is below
+ *  `cascadeConfidenceThreshold` again with this language, each within its
+ *  own box, and keeps whichever result is more confident. Most words are
+ *  confident after the first pass, so the page costs little more than the
+ *  fast model alone.
+ *
+ *  @note The accurate engine is taken from the prewarmed ones like those
+ *        of `parallelRecognitionMode`; prewarm it to avoid loading it on
+ *        the first recognition. `maximumRecognitionTime` covers both
+ *        passes: refinement gets what the first pass left of it, and is
+ *        skipped when the first pass ran out of time. Words not refined in
+ *        time keep their first result.
+ *
+ *  @default Default value is nil
+ */
+@property (nonatomic, copy, nullable) NSString *cascadeLanguage;
+
+/**
+ *  The confidence (between 0 and 100) below which a word or line is
+ *  recognized again with `cascadeLanguage`.
+ *
+ *  @default Default value is 80
+ */
+@property (nonatomic, assign) NSUInteger cascadeConfidenceThreshold;
+
+/**
+ *  Whether `cascadeLanguage` refines single words,
+ *  `G8PageIteratorLevelWord`, or whole lines, `G8PageIteratorLevelTextline`,
+ *  which gives the accurate model more context at a higher cost.
+ *
+ *  @default Default value is G8PageIteratorLevelWord
+ */
+@property (nonatomic, assign) G8PageIteratorLevel cascadeLevel;
+
+/**
+ *  The number of words or lines of the last recognition below
+ *  `cascadeConfidenceThreshold` that were recognized again with
+ *  `cascadeLanguage`.
+ */
+@property (nonatomic, readonly) NSUInteger cascadeRefinedCount;
+
+/**
+ *  The number of words or lines of the last recognition whose result was
+ *  replaced by a more confident one of `cascadeLanguage`.
+ */
+@property (nonatomic, readonly) NSUInteger cascadeReplacedCount;
+
+/**
+ *  The `G8FieldTarget` objects to look for, e.g. the total of a receipt.
+ *  When set, `recognize` recognizes the page line by line in reading order,
+ *  tests the words and lines of each line as soon as it's done, and stops
+ *  once every target has been found with its minimum confidence. The
+ *  results are those of the lines done by then; `finishedEarly` tells
+ *  whether the rest of the page was skipped.
+ *
+ *  @note Lines are recognized on several threads with
+ *        `parallelRecognitionMode` set, see `maximumConcurrency`.
+ *
+ *  @default Default value is nil
+ */
+@property (nonatomic, copy, nullable) NSArray *targetFields;
+
+/**
+ *  The most confident match of each of `targetFields` found by the last
+ *  recognition, as `G8RecognizedBlock` objects by target name. Targets
+ *  matched below their minimum confidence are included.
+ */
+@property (nonatomic, readonly, nullable) NSDictionary *recognizedFields;
+
+/**
+ *  Whether the last recognition stopped before the end of the page because
+ *  every one of `targetFields` was found.
+ */
+@property (nonatomic, readonly) BOOL finishedEarly;
+
 /**
  *  The percentage of progress of Tesseract's recognition (between 0 and 100).
  */
 @property (nonatomic, readonly) NSUInteger progress;
 
+/**
+ *  An optional block called with the progress of each recognition, on
+ *  `progressEventQueue`. Progress is sampled on that queue every
+ *  `progressEventInterval`, so the recognition thread does no work per
+ *  word for it. Samples that moved less than `progressEventMinimumDelta`
+ *  are skipped. A last event, with `finished` set, follows every
+ *  recognition.
+ *
+ *  @note If `recognize` is called on `progressEventQueue` itself, e.g. on
+ *        the main thread with the default queue, only the last event is
+ *        delivered.
+ */
+@property (nonatomic, copy, nullable) G8ProgressEventBlock progressEventBlock;
+
+/**
+ *  The time between two samples of `progressEventBlock`. Default is 0.1
+ *  seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval progressEventInterval;
+
+/**
+ *  The increase of `progress` needed for a sample to be delivered to
+ *  `progressEventBlock`. `0` delivers every sample. Default is 1.
+ */
+@property (nonatomic, assign) NSUInteger progressEventMinimumDelta;
+
+/**
+ *  The queue `progressEventBlock` is called on. Use a serial queue so that
+ *  events arrive in order. Default is the main queue.
+ */
+@property (nonatomic, strong, null_resettable) dispatch_queue_t progressEventQueue;
+
 /**
  *  A string of text that Tesseract has recognized from the target image.
  */
@@ -147,6 +508,10 @@ extern NSInteger const kG8MaxCredibleResolution;
  *  data structures.
  *  page_number is 0-based but will appear in the output as 1-based.
  *
+ *  Results of region by region, speculative, reduced quality, cascade or
+ *  partial recognition aren't held by the engine; their markup is made from
+ *  the results themselves and has no line baselines.
+ *
  *  @param pageNumber The page number within the image of interest. If you
  *                    aren't using a multipage image or don't know what this
  *                    means, use `0` for `pageNumber`.
@@ -158,6 +523,12 @@ extern NSInteger const kG8MaxCredibleResolution;
 
 /**
  *  Produces a PDF output with the pages sent to the function
+ *  Pages go through a pipeline: while a page is being recognized, the next
+ *  ones are decoded and converted on other threads. See
+ *  `maximumPagesInFlight` and `pipelineStages`.
+ *  Each page is recognized by the engine of this instance within
+ *  `maximumRecognitionTime` and rendered with the text done by then;
+ *  cancelling the `cancellationToken` stops the document.
  *  @param  images  An array of the input images being recognized and
  *                  included into the output PDF file.
  *  @return NSData  representing output PDF file or nil if error occured or
@@ -165,6 +536,40 @@ extern NSInteger const kG8MaxCredibleResolution;
  */
 - (NSData *_Nullable)recognizedPDFForImages:(NSArray*_Nonnull)images;
 
+/**
+ *  The number of pages `recognizedPDFForImages:` keeps decoded at once,
+ *  including the one being recognized. Higher values let decoding run
+ *  further ahead at the cost of memory. Default is `3`.
+ */
+@property (nonatomic, assign) NSUInteger maximumPagesInFlight;
+
+/**
+ *  How busy each stage of the last `recognizedPDFForImages:` call was, as
+ *  `G8PipelineStage` objects in processing order. `nil` before the first
+ *  call.
+ */
+@property (nonatomic, copy, readonly, nullable) NSArray *pipelineStages;
+
+/**
+ *  Write copies of the traineddata files of `language` that only contain the
+ *  components `engineMode` reads, e.g. without the legacy engine's data for
+ *  `G8OCREngineModeLSTMOnly`. Stripped files load faster and take less space;
+ *  ship them instead of the originals.
+ *
+ *  The method initializes an engine from the originals and one from the
+ *  copies and times both. If `image` is set, it recognizes it with each
+ *  engine to verify that the output is unchanged.
+ *
+ *  @param directory Folder to write the files to. It's created if needed.
+ *                   It can't be `absoluteDataPath`, since the files would be
+ *                   written over the ones they're stripped from.
+ *
+ *  @return A report with the file sizes, load times and verification result,
+ *          or nil if error occured, the engine is not properly configured or
+ *          `directory` holds the original files.
+ */
+- (G8TrainedDataReport *_Nullable)writeStrippedTrainedDataToDirectory:(NSString *_Nonnull)directory;
+
 /**
  *  Run Tesseract's page analysis on the target image.
  *
@@ -288,6 +693,17 @@ extern NSInteger const kG8MaxCredibleResolution;
  */
 @property (nonatomic, weak, nullable) id<G8TesseractDelegate> delegate;
 
+/**
+ *  The token that cancels recognition. Each instance starts with its own;
+ *  assign a shared token to cancel several instances at once, e.g. all
+ *  pages of a document. Setting `nil` assigns a new token.
+ *
+ *  Tesseract checks the token for every word, without calling into
+ *  Objective-C. If the delegate implements
+ *  `shouldCancelImageRecognitionForTesseract:`, it is asked as well.
+ */
+@property (nonatomic, strong, null_resettable) G8CancellationToken *cancellationToken;
+
 /**
  *  The default initializer.
  *  @return A G8Tesseract instance initialized with neither language,
@@ -403,6 +819,25 @@ extern NSInteger const kG8MaxCredibleResolution;
                          absoluteDataPath:(nullable NSString *)absoluteDataPath
                                engineMode:(G8OCREngineMode)engineMode;
 
+/**
+ *  Initialize Tesseract with the configuration of an already configured
+ *  instance. Language, engine mode, tessdata folder, config files, all
+ *  variables and the recognition settings (time limit, region priority,
+ *  parallel, speculative and cascade recognition, target fields, progress
+ *  events and pipeline depth) are taken from the prototype. The engine is
+ *  initialized in full; only the tessdata folder lookup is skipped and, if
+ *  `cachesTrainedData` is enabled, the traineddata is read from memory.
+ *
+ *  @param prototype The `G8Tesseract` instance to copy. Its image, rect,
+ *                   delegate and cancellation token are not copied.
+ *
+ *  @return The initialized Tesseract object.
+ *
+ *  @note   No model state is shared with the prototype, so every copy
+ *          can be used on a different thread.
+ */
+- (nullable instancetype)initWithPrototype:(nonnull G8Tesseract *)prototype;
+
 /**
  *  Set a Tesseract variable. See G8TesseractParameters.h for the available
  *  options.
@@ -8,9 +8,30 @@
 //
 
 #import "G8Tesseract.h"
-
+#import "G8Tesseract+Internal.h"
+
+#import "G8CancellationToken+Internal.h"
+#import "G8Engine.h"
+#import "G8EnginePool.h"
+#import "G8MemoryEntry.h"
+#import "G8MemoryGovernor.h"
+#import "G8ConcurrencyGovernor.h"
+#import "G8PagePipeline.h"
+#import "G8CascadeRecognizer.h"
+#import "G8FieldMatcher.h"
+#import "G8FieldTarget.h"
+#import "G8ParallelRecognizer.h"
+#import "G8QualityTier.h"
+#import "G8QualityTiers.h"
+#import "G8SpeculativeRecognizer.h"
+#import "G8PipelineStage.h"
 #import "G8PixWrapper.h"
+#import "G8ProgressChannel.h"
+#import "G8ProgressEvent.h"
+#import "G8StartupProfile.h"
 #import "G8TextMonitor.h"
+#import "G8TrainedData.h"
+#import "G8TrainedDataReport.h"
 #import "UIImage+G8Filters.h"
 #import "G8TesseractParameters.h"
 #import "G8Constants.h"
@@ -28,11 +49,15 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <atomic>
 
 NSInteger const kG8DefaultResolution = 72;
 NSInteger const kG8MinCredibleResolution = 70;
 NSInteger const kG8MaxCredibleResolution = 2400;
 
+// Memory warnings closer together than this escalate to critical pressure
+static NSTimeInterval const kG8MemoryWarningEscalationInterval = 30.0;
+
 // Forward declare the callback function used by TextMonitor
 static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 
@@ -42,6 +67,20 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 @interface G8Tesseract () {
     std::unique_ptr<tesseract::TessBaseAPI> _tesseract;
     std::unique_ptr<g8::TextMonitor> _monitor;
+    std::unique_ptr<g8::ParallelPageResult> _pageResult;  // Set by parallel, speculative and tiered recognition
+
+    // The tier the next recognition runs at, see recognizeAtQualityTier:index:
+    G8QualityTier *_qualityTier;
+    NSUInteger _qualityTierIndex;
+
+    // System uptime when the last recognition started, which
+    // maximumRecognitionTime counts from
+    NSTimeInterval _recognitionStart;
+
+    // The delegate as of the start of the recognition, set if it implements
+    // the respective method
+    __weak id<G8TesseractDelegate> _cancelDelegate;
+    __weak id<G8TesseractDelegate> _progressDelegate;
 }
 
 @property (nonatomic, strong) NSDictionary *configDictionary;
@@ -49,6 +88,8 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 @property (nonatomic, strong) NSMutableDictionary *variables;
 
 @property (readwrite, assign) CGSize imageSize;
+@property (nonatomic, strong, readwrite) G8StartupProfile *startupProfile;
+@property (nonatomic, copy, readwrite) NSArray *pipelineStages;
 
 @property (nonatomic, assign, getter=isRecognized) BOOL recognized;
 @property (nonatomic, assign, getter=isLayoutAnalysed) BOOL layoutAnalysed;
@@ -72,7 +113,17 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 }
 
 + (void)didReceiveMemoryWarningNotification:(NSNotification*)notification {
-    [self clearCache];
+    static NSDate *lastWarningDate = nil;
+    G8MemoryPressureLevel level = G8MemoryPressureLevelModerate;
+    @synchronized(self) {
+        NSDate *now = [NSDate date];
+        if (lastWarningDate != nil &&
+            [now timeIntervalSinceDate:lastWarningDate] < kG8MemoryWarningEscalationInterval) {
+            level = G8MemoryPressureLevelCritical;
+        }
+        lastWarningDate = now;
+    }
+    [self handleMemoryPressure:level];
 }
 
 + (NSString *)version {
@@ -81,6 +132,115 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 
 + (void)clearCache {
     tesseract::TessBaseAPI::ClearPersistentCache();
+    g8::TrainedDataCache::shared().clear();
+    g8::EnginePool::shared().clear();
+}
+
++ (BOOL)cachesTrainedData {
+    return g8::TrainedDataCache::shared().isEnabled();
+}
+
++ (void)setCachesTrainedData:(BOOL)cachesTrainedData {
+    g8::TrainedDataCache::shared().setEnabled(cachesTrainedData);
+}
+
++ (NSUInteger)memoryBudget {
+    return g8::MemoryGovernor::shared().budget();
+}
+
++ (void)setMemoryBudget:(NSUInteger)memoryBudget {
+    g8::MemoryGovernor::shared().setBudget(memoryBudget);
+}
+
++ (NSUInteger)memoryUsage {
+    return g8::MemoryGovernor::shared().usage();
+}
+
++ (NSUInteger)coreBudget {
+    return g8::ConcurrencyGovernor::shared().coreBudget();
+}
+
++ (void)setCoreBudget:(NSUInteger)coreBudget {
+    g8::ConcurrencyGovernor::shared().setCoreBudget(coreBudget);
+}
+
++ (NSUInteger)coreUsage {
+    return g8::ConcurrencyGovernor::shared().statistics().coresInUse;
+}
+
++ (NSArray *)memoryEntriesFromEntries:(const std::vector<g8::MemoryEntry> &)entries {
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:entries.size()];
+    for (const auto &entry : entries) {
+        NSTimeInterval interval = std::chrono::duration<double>(entry.date.time_since_epoch()).count();
+        [result addObject:[[G8MemoryEntry alloc] initWithKey:@(entry.key.c_str())
+                                                        kind:(G8MemoryKind)entry.kind
+                                                       bytes:entry.bytes
+                                                        date:[NSDate dateWithTimeIntervalSince1970:interval]]];
+    }
+    return [result copy];
+}
+
++ (NSArray *)cachedMemoryEntries {
+    return [self memoryEntriesFromEntries:g8::MemoryGovernor::shared().entries()];
+}
+
++ (NSArray *)evictedMemoryEntries {
+    return [self memoryEntriesFromEntries:g8::MemoryGovernor::shared().evictions()];
+}
+
++ (void)handleMemoryPressure:(G8MemoryPressureLevel)level {
+    g8::MemoryGovernor::shared().handlePressure(level == G8MemoryPressureLevelCritical
+                                                ? g8::MemoryPressure::Critical
+                                                : g8::MemoryPressure::Moderate);
+    // Dictionaries held by live engines stay loaded, the cache only drops
+    // those no engine uses anymore
+    tesseract::TessBaseAPI::ClearPersistentCache();
+}
+
++ (void)prewarmLanguages:(NSArray *)languages
+             engineModes:(NSArray *)engineModes
+              completion:(void (^)(BOOL success))completion
+{
+    [self prewarmLanguages:languages engineModes:engineModes absoluteDataPath:nil completion:completion];
+}
+
++ (void)prewarmLanguages:(NSArray *)languages
+             engineModes:(NSArray *)engineModes
+        absoluteDataPath:(NSString *)absoluteDataPath
+              completion:(void (^)(BOOL success))completion
+{
+    // Must produce the same configuration as a fresh instance's engineConfig
+    NSString *dataPath = [absoluteDataPath ?: [NSBundle mainBundle].bundlePath
+                          stringByAppendingString:@"/tessdata/"];
+    if (engineModes.count == 0) {
+        engineModes = @[@(G8OCREngineModeDefault)];
+    }
+
+    auto failed = std::make_shared<std::atomic<bool>>(false);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_UTILITY, 0);
+
+    for (NSString *language in languages) {
+        for (NSNumber *engineMode in engineModes) {
+            g8::EngineConfig config;
+            config.dataPath = dataPath.fileSystemRepresentation;
+            config.language = language.UTF8String;
+            config.engineMode = engineMode.intValue;
+
+            dispatch_group_async(group, queue, ^{
+                if (!g8::EnginePool::shared().prewarm(config)) {
+                    NSLog(@"ERROR! Can't prewarm Tesseract engine for language %@", language);
+                    failed->store(true);
+                }
+            });
+        }
+    }
+
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        if (completion) {
+            completion(!failed->load());
+        }
+    });
 }
 
 - (instancetype)init {
@@ -127,19 +287,7 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
                       engineMode:(G8OCREngineMode)engineMode {
     self = [super init];
     if (self) {
-        // Basic setup
-        _pageSegmentationMode = G8PageSegmentationModeSingleBlock;
-        _variables = [NSMutableDictionary dictionary];
-        _sourceResolution = kG8DefaultResolution;
-        _rect = CGRectZero;
-
-        // Monitor setup
-        try {
-            _monitor = std::make_unique<g8::TextMonitor>(
-                                                         tesseractCancelCallbackFunction,
-                                                         (__bridge void*)self
-                                                         );
-        } catch (const std::bad_alloc&) {
+        if (![self setupDefaults]) {
             return nil;
         }
 
@@ -182,35 +330,91 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     return self;
 }
 
+- (instancetype)initWithPrototype:(G8Tesseract *)prototype {
+    self = [super init];
+    if (self) {
+        if (![self setupDefaults]) {
+            return nil;
+        }
+
+        // The prototype has already resolved its tessdata folder, so there is
+        // nothing to look up. Init itself runs in full.
+        _language = prototype.language.copy;
+        _engineMode = prototype.engineMode;
+        _absoluteDataPath = prototype.absoluteDataPath.copy;
+        _configDictionary = prototype.configDictionary;
+        _configFileNames = prototype.configFileNames;
+        _variables = [prototype.variables mutableCopy];
+        _pageSegmentationMode = prototype.pageSegmentationMode;
+        _charWhitelist = prototype.charWhitelist.copy;
+        _charBlacklist = prototype.charBlacklist.copy;
+        _sourceResolution = prototype.sourceResolution;
+        _maximumRecognitionTime = prototype.maximumRecognitionTime;
+        _regionPriority = prototype.regionPriority;
+        _parallelRecognitionMode = prototype.parallelRecognitionMode;
+        _maximumConcurrency = prototype.maximumConcurrency;
+        _speculativePageSegmentationModes = prototype.speculativePageSegmentationModes.copy;
+        _speculativeWinningConfidence = prototype.speculativeWinningConfidence;
+        _cascadeLanguage = prototype.cascadeLanguage.copy;
+        _cascadeConfidenceThreshold = prototype.cascadeConfidenceThreshold;
+        _cascadeLevel = prototype.cascadeLevel;
+        _targetFields = prototype.targetFields.copy;
+        _progressEventBlock = prototype.progressEventBlock;
+        _progressEventInterval = prototype.progressEventInterval;
+        _progressEventMinimumDelta = prototype.progressEventMinimumDelta;
+        _progressEventQueue = prototype->_progressEventQueue;
+        _maximumPagesInFlight = prototype.maximumPagesInFlight;
+
+        if (prototype.isEngineConfigured && [self configEngine]) {
+            [self loadVariables];
+            [self setOtherCachedValues];
+        }
+    }
+    return self;
+}
+
+/**
+ * Sets up the state shared by all initializers
+ * @return NO if the monitor couldn't be allocated
+ */
+- (BOOL)setupDefaults {
+    // Basic setup
+    _pageSegmentationMode = G8PageSegmentationModeSingleBlock;
+    _variables = [NSMutableDictionary dictionary];
+    _sourceResolution = kG8DefaultResolution;
+    _rect = CGRectZero;
+
+    _cancellationToken = [[G8CancellationToken alloc] init];
+    _progressEventInterval = 0.1;
+    _progressEventMinimumDelta = 1;
+    _maximumPagesInFlight = 3;
+    _speculativeWinningConfidence = 85;
+    _cascadeConfidenceThreshold = 80;
+    _cascadeLevel = G8PageIteratorLevelWord;
+
+    // Monitor setup, callbacks are set for each recognition
+    try {
+        _monitor = std::make_unique<g8::TextMonitor>();
+    } catch (const std::bad_alloc&) {
+        return NO;
+    }
+    return YES;
+}
+
 /**
  * Configures the Tesseract engine with current settings
  * @return YES if configuration was successful, NO otherwise
  */
 - (BOOL)configEngine {
     try {
-        std::vector<std::string> vars_vec;
-        std::vector<std::string> vars_values;
-
-        // Fill vectors if we have config dictionary
-        if (self.configDictionary) {
-            [self fillVectors:vars_vec values:vars_values fromDictionary:self.configDictionary];
-        }
-
-        // Handle config files
-        std::vector<std::unique_ptr<char[]>> configPtrs;
-        std::vector<char*> configs;
-
-        if (self.configFileNames) {
-            configPtrs.reserve(self.configFileNames.count);
-            configs.reserve(self.configFileNames.count);
-
-            for (NSString *configFile in self.configFileNames) {
-                const char *utf8String = [configFile UTF8String];
-                auto ptr = std::make_unique<char[]>(strlen(utf8String) + 1);
-                strcpy(ptr.get(), utf8String);
-                configs.push_back(ptr.get());
-                configPtrs.push_back(std::move(ptr));
-            }
+        g8::EngineConfig config = [self engineConfig];
+
+        // Adopt a prewarmed engine if one matches the configuration
+        std::unique_ptr<g8::Engine> pooledEngine = g8::EnginePool::shared().acquire(config);
+        if (pooledEngine) {
+            self.startupProfile = [G8Tesseract startupProfileFromProfile:pooledEngine->startupProfile()];
+            _tesseract = pooledEngine->releaseAPI();
+            return YES;
         }
 
         // Initialize Tesseract with current configuration
@@ -218,23 +422,16 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
             _tesseract = std::make_unique<tesseract::TessBaseAPI>();
         }
 
-        // Pass the address of our vectors - this creates const pointers to our non-const vectors
-        int returnCode = _tesseract->Init(
-                                          self.absoluteDataPath.fileSystemRepresentation,
-                                          self.language.UTF8String,
-                                          (tesseract::OcrEngineMode)self.engineMode,
-                                          configs.empty() ? nullptr : configs.data(),
-                                          static_cast<int>(configs.size()),
-                                          vars_vec.empty() ? nullptr : &vars_vec,
-                                          vars_values.empty() ? nullptr : &vars_values,
-                                          false
-                                          );
+        g8::StartupProfile profile;
+        int returnCode = g8::initializeAPI(*_tesseract, config, &profile);
 
         if (returnCode != 0) {
+            self.startupProfile = nil;
             _tesseract.reset();  // Clear the pointer if initialization failed
             return NO;
         }
 
+        self.startupProfile = [G8Tesseract startupProfileFromProfile:profile];
         return YES;
 
     } catch (const std::exception& e) {
@@ -243,20 +440,58 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     }
 }
 
-- (void)fillVectors:(std::vector<std::string>&)vars_vec values:(std::vector<std::string>&)vars_values fromDictionary:(NSDictionary*)dict {
-    vars_vec.reserve(dict.count);
-    vars_values.reserve(dict.count);
+/**
+ * Converts a core startup profile
+ * @return The equivalent public profile
+ */
++ (G8StartupProfile *)startupProfileFromProfile:(const g8::StartupProfile &)profile {
+    NSMutableArray *phases = [NSMutableArray arrayWithCapacity:profile.phases.size()];
+    for (const auto &phase : profile.phases) {
+        [phases addObject:[[G8StartupPhase alloc] initWithName:@(phase.name.c_str())
+                                                      duration:phase.seconds
+                                                         bytes:phase.bytes]];
+    }
+
+    NSMutableDictionary *componentSizes = [NSMutableDictionary dictionary];
+    for (size_t i = 0; i < profile.componentBytes.size(); ++i) {
+        if (profile.componentBytes[i] > 0) {
+            auto component = static_cast<g8::TrainedDataComponent>(i);
+            componentSizes[@(g8::componentName(component))] = @(profile.componentBytes[i]);
+        }
+    }
 
-    [dict enumerateKeysAndObjectsUsingBlock: ^(NSString *key, NSString *value, BOOL *stop) {
-        vars_vec.push_back(std::string([key UTF8String]));
-        vars_values.push_back(std::string([value UTF8String]));
+    return [[G8StartupProfile alloc] initWithPhases:phases
+                                     componentSizes:componentSizes
+                                        cachedBytes:profile.cachedBytes];
+}
+
+/**
+ * Builds the core engine configuration from the current settings
+ * @return Configuration equivalent to this instance's engine
+ */
+- (g8::EngineConfig)engineConfig {
+    __block g8::EngineConfig config;
+    config.dataPath = self.absoluteDataPath.fileSystemRepresentation ?: "";
+    config.language = self.language.UTF8String ?: "";
+    config.engineMode = (int)self.engineMode;
+
+    for (NSString *configFile in self.configFileNames) {
+        config.configFiles.push_back(configFile.UTF8String);
+    }
+    [self.configDictionary enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        config.initVariables[key.UTF8String] = value.UTF8String;
     }];
+    [self.variables enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        config.variables[key.UTF8String] = value.UTF8String;
+    }];
+    return config;
 }
 
 - (void)resetFlags
 {
     self.recognized = NO;
     self.layoutAnalysed = NO;
+    _pageResult.reset();
 }
 
 /**
@@ -490,6 +725,17 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         return;
     }
 
+    CGRect engineRect = [self engineRectForRect:rect];
+    _tesseract->SetRectangle(CGRectGetMinX(engineRect), CGRectGetMinY(engineRect),
+                             CGRectGetWidth(engineRect), CGRectGetHeight(engineRect));
+}
+
+/**
+ * Converts a rectangle of the image to one of the engine's image
+ * @param rect The rectangle in the image to process
+ * @return The rectangle scaled like the preprocessed image and clipped to it
+ */
+- (CGRect)engineRectForRect:(CGRect)rect {
     CGFloat x = CGRectGetMinX(rect);
     CGFloat y = CGRectGetMinY(rect);
     CGFloat width = CGRectGetWidth(rect);
@@ -516,7 +762,7 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     width = clip(width, 0, self.imageSize.width - x);
     height = clip(height, 0, self.imageSize.height - y);
 
-    _tesseract->SetRectangle(x, y, width, height);
+    return CGRectMake(x, y, width, height);
 }
 
 #pragma mark - Public getters and setters
@@ -657,6 +903,10 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         return nil;
     }
 
+    if (_pageResult) {
+        return [NSString stringWithUTF8String:_pageResult->text().c_str()];
+    }
+
     std::unique_ptr<char[]> utf8Text(_tesseract->GetUTF8Text());
     if (!utf8Text) {
         NSLog(@"No recognized text. Check that -[Tesseract setImage:] is passed an image bigger than 0x0.");
@@ -835,6 +1085,69 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     return block;
 }
 
+/**
+ * Creates a recognized block from a parallel recognition result
+ * @param node Result in page coordinates
+ * @return Recognized block with a normalized bounding box
+ */
+- (G8RecognizedBlock *)blockFromNode:(const g8::ResultNode &)node {
+    CGRect boundingBox = [self normalizedRectForX:node.left
+                                                y:node.top
+                                            width:node.right - node.left
+                                           height:node.bottom - node.top];
+    return [[G8RecognizedBlock alloc] initWithText:[NSString stringWithUTF8String:node.text.c_str()]
+                                       boundingBox:boundingBox
+                                        confidence:node.confidence
+                                             level:(G8PageIteratorLevel)node.level];
+}
+
+/**
+ * Creates the character choices of a symbol from a parallel recognition result
+ * @param node Symbol result
+ * @return Array of recognized blocks, one per choice
+ */
+- (NSArray *)choicesFromNode:(const g8::ResultNode &)node {
+    CGRect boundingBox = [self blockFromNode:node].boundingBox;
+    NSMutableArray *choices = [NSMutableArray arrayWithCapacity:node.choices.size()];
+    for (const auto &choice : node.choices) {
+        [choices addObject:[[G8RecognizedBlock alloc] initWithText:[NSString stringWithUTF8String:choice.text.c_str()]
+                                                       boundingBox:boundingBox
+                                                        confidence:choice.confidence
+                                                             level:G8PageIteratorLevelSymbol]];
+    }
+    return [choices copy];
+}
+
+/**
+ * Creates a hierarchical block with all of its descendants from a parallel recognition result
+ * @param node Result in page coordinates
+ * @return Hierarchical recognized block
+ */
+- (G8HierarchicalRecognizedBlock *)hierarchicalBlockFromNode:(const g8::ResultNode &)node {
+    G8HierarchicalRecognizedBlock *block = [[G8HierarchicalRecognizedBlock alloc] initWithBlock:[self blockFromNode:node]];
+
+    if (node.level == tesseract::RIL_WORD) {
+        block.isFromDict = node.isFromDictionary;
+        block.isNumeric = node.isNumeric;
+        block.isBold = node.isBold;
+        block.isItalic = node.isItalic;
+    } else if (node.level == tesseract::RIL_SYMBOL) {
+        NSArray *choices = [self choicesFromNode:node];
+        if (choices.count > 0) {
+            block.characterChoices = choices;
+        }
+    }
+
+    if (!node.children.empty()) {
+        NSMutableArray *childBlocks = [NSMutableArray arrayWithCapacity:node.children.size()];
+        for (const auto &child : node.children) {
+            [childBlocks addObject:[self hierarchicalBlockFromNode:child]];
+        }
+        block.childBlocks = [childBlocks copy];
+    }
+    return block;
+}
+
 /**
  * Gets all character choices from the recognition results
  * @return Array of arrays containing character alternatives
@@ -842,6 +1155,17 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 - (NSArray *)characterChoices {
     if (!self.isEngineConfigured) return nil;
 
+    if (_pageResult) {
+        NSMutableArray *resultArray = [NSMutableArray array];
+        for (const g8::ResultNode *symbol : g8::collectResultNodes(_pageResult->blocks, tesseract::RIL_SYMBOL)) {
+            NSArray *choices = [self choicesFromNode:*symbol];
+            if (choices.count > 0) {
+                [resultArray addObject:choices];
+            }
+        }
+        return [resultArray copy];
+    }
+
     NSMutableArray *resultArray = [NSMutableArray array];
     std::unique_ptr<tesseract::ResultIterator> iterator(_tesseract->GetIterator());
 
@@ -900,6 +1224,14 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         return nil;
     }
 
+    if (_pageResult) {
+        NSMutableArray *blocks = [NSMutableArray array];
+        for (const g8::ResultNode *node : g8::collectResultNodes(_pageResult->blocks, (int)pageIteratorLevel)) {
+            [blocks addObject:[self hierarchicalBlockFromNode:*node]];
+        }
+        return [blocks copy];
+    }
+
     std::unique_ptr<tesseract::ResultIterator> resultIterator(_tesseract->GetIterator());
     if (!resultIterator) {
         return nil;
@@ -1005,6 +1337,13 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     }
 
     NSMutableArray *blocks = [NSMutableArray array];
+    if (_pageResult) {
+        for (const g8::ResultNode *node : g8::collectResultNodes(_pageResult->blocks, (int)pageIteratorLevel)) {
+            [blocks addObject:[self blockFromNode:*node]];
+        }
+        return [blocks copy];
+    }
+
     std::unique_ptr<tesseract::ResultIterator> resultIterator(_tesseract->GetIterator());
 
     if (resultIterator) {
@@ -1032,6 +1371,13 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         return nil;
     }
 
+    // The engine doesn't hold these results, it would recognize the page again
+    if (_pageResult) {
+        std::string hocr = g8::resultHOCR(_pageResult->blocks, pageNumber,
+                                          (int)self.imageSize.width, (int)self.imageSize.height);
+        return [NSString stringWithUTF8String:hocr.c_str()];
+    }
+
     std::unique_ptr<char[]> hocr(_tesseract->GetHOCRText(pageNumber));
     if (!hocr) {
         return nil;
@@ -1063,24 +1409,10 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
             return nil;
         }
 
-        // Process each image
-        for (int pageIndex = 0; pageIndex < images.count; pageIndex++) {
-            UIImage *image = images[pageIndex];
-            if (![image isKindOfClass:[UIImage class]]) {
-                continue;
-            }
-
-            Pix *pix = [self pixForImage:image];
-            if (!pix) {
-                continue;
-            }
+        [self prepareMonitor];
 
-            if (!_tesseract->ProcessPage(pix, pageIndex, "", nullptr, 0, renderer.get())) {
-                pixDestroy(&pix);
-                return nil;
-            }
-
-            pixDestroy(&pix);
+        if (![self recognizePages:images renderer:renderer.get()]) {
+            return nil;
         }
 
         if (!renderer->EndDocument()) {
@@ -1104,6 +1436,104 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     return pdfData;
 }
 
+/**
+ * Recognizes images into a renderer through a pipeline: pages are decoded and
+ * converted ahead while the engine recognizes and renders them in order.
+ * Entries that aren't images are skipped but keep their page index.
+ * @return NO if a page couldn't be recognized or rendered
+ */
+- (BOOL)recognizePages:(NSArray *)images renderer:(tesseract::TessResultRenderer *)renderer {
+    std::vector<g8::PipelineStage> stages;
+    stages.push_back({kG8PipelineStageDecode.UTF8String, 2, false, [self, images](g8::PipelinePage &page) {
+        @autoreleasepool {
+            UIImage *image = images[page.index];
+            CFDataRef pixelData = [image isKindOfClass:[UIImage class]] ? [self copyPixelDataForImage:image] : NULL;
+            if (!pixelData) {
+                page.skipped = true;
+                return true;
+            }
+            page.data = std::shared_ptr<void>((void *)pixelData, CFRelease);
+            return true;
+        }
+    }});
+    stages.push_back({kG8PipelineStagePreprocess.UTF8String, 1, false, [self, images](g8::PipelinePage &page) {
+        @autoreleasepool {
+            auto pixelData = static_cast<CFDataRef>(page.data.get());
+            page.pix.reset([self pixForImage:images[page.index] pixelData:pixelData]);
+            page.data.reset();
+            page.skipped = !page.pix;
+            return true;
+        }
+    }});
+    stages.push_back({kG8PipelineStageRecognize.UTF8String, 1, true, [self, renderer](g8::PipelinePage &page) {
+        // Each page gets maximumRecognitionTime and is rendered with what
+        // was done by then; cancellation stops the document
+        try {
+            tesseract::TessBaseAPI *api = self->_tesseract.get();
+            api->SetInputName("");
+            api->SetImage(page.pix.get());
+            self->_monitor->setDeadline(self.maximumRecognitionTime > FLT_EPSILON
+                                        ? static_cast<int>(self.maximumRecognitionTime * 1000) : 0);
+            if (api->Recognize(self->_monitor->get()) != 0 && !self->_monitor->deadlineExceeded()) {
+                return false;
+            }
+            return renderer->AddImage(api);
+        } catch (const std::exception&) {
+            return false;
+        }
+    }});
+
+    g8::PagePipeline pipeline(std::move(stages), self.maximumPagesInFlight);
+    g8::PipelineReport report = pipeline.run(images.count);
+
+    NSMutableArray *pipelineStages = [NSMutableArray arrayWithCapacity:report.stages.size()];
+    for (const auto &stage : report.stages) {
+        [pipelineStages addObject:[[G8PipelineStage alloc] initWithName:@(stage.name.c_str())
+                                                              pageCount:stage.pages
+                                                               busyTime:stage.busySeconds
+                                                            utilization:stage.utilization
+                                                      maximumQueueDepth:stage.maxQueueDepth]];
+    }
+    self.pipelineStages = pipelineStages;
+    return report.completed;
+}
+
+- (G8TrainedDataReport *)writeStrippedTrainedDataToDirectory:(NSString *)directory {
+    if (!self.isEngineConfigured) {
+        return nil;
+    }
+
+    NSError *error = nil;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory
+                                   withIntermediateDirectories:YES
+                                                    attributes:nil
+                                                         error:&error]) {
+        NSLog(@"ERROR! Can't create directory %@: %@", directory, error);
+        return nil;
+    }
+    if (![directory hasSuffix:@"/"]) {
+        directory = [directory stringByAppendingString:@"/"];
+    }
+
+    g8::PixWrapper pix(self.image ? [self pixForImage:self.image] : nullptr);
+    g8::TrainedDataStripReport report;
+    if (!g8::stripTrainedData([self engineConfig],
+                              directory.fileSystemRepresentation,
+                              pix.get(),
+                              (int)self.pageSegmentationMode,
+                              report)) {
+        NSLog(@"ERROR! Can't strip traineddata for language %@", self.language);
+        return nil;
+    }
+
+    return [[G8TrainedDataReport alloc] initWithOriginalSize:report.originalBytes
+                                                strippedSize:report.strippedBytes
+                                            originalLoadTime:report.originalLoadSeconds
+                                            strippedLoadTime:report.strippedLoadSeconds
+                                                    verified:report.verified
+                                             identicalOutput:report.identicalOutput];
+}
+
 - (UIImage *)imageWithBlocks:(NSArray *)blocks drawText:(BOOL)drawText thresholded:(BOOL)thresholded {
     UIImage *image = thresholded ? self.thresholdedImage : self.image;
 
@@ -1139,25 +1569,465 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         return NO;
     }
 
-    // Set recognition deadline using the wrapper
-    if (self.maximumRecognitionTime > FLT_EPSILON) {
-        _monitor->setDeadline(static_cast<int>(self.maximumRecognitionTime * 1000));
-    }
+    _recognitionStart = [NSProcessInfo processInfo].systemUptime;
+    [self prepareMonitor];
 
     self.recognized = NO;
-    int returnCode = 0;
+    _pageResult.reset();
+
+    void (^finishProgressEvents)(BOOL) = [self startProgressEvents];
+
+    _recognizedPageSegmentationMode = self.pageSegmentationMode;
+    _recognizedQualityTier = _qualityTierIndex;
+    _cascadeRefinedCount = 0;
+    _cascadeReplacedCount = 0;
+    _recognizedFields = nil;
+    _finishedEarly = NO;
+    _partialResult = NO;
+    _regionCount = 0;
+    _recognizedRegionCount = 0;
+    _recognizedCoverage = 0;
+
+    if (_qualityTier != nil && !_qualityTier.isFullQuality) {
+        self.recognized = [self recognizeAtReducedQuality];
+    } else if (self.speculativePageSegmentationModes.count > 0) {
+        self.recognized = [self recognizeSpeculatively];
+    } else {
+        // A page is only split when the cores aren't taken by other recognitions
+        size_t maximumWidth = 1;
+        if (self.parallelRecognitionMode != G8ParallelRecognitionModeNone) {
+            maximumWidth = self.maximumConcurrency ?: [NSProcessInfo processInfo].activeProcessorCount;
+        }
+        g8::ConcurrencyGovernor::Lease lease = g8::ConcurrencyGovernor::shared().acquire(maximumWidth);
 
-    @try {
-        returnCode = _tesseract->Recognize(_monitor->get());
-        self.recognized = (returnCode == 0);
+        // Target fields are looked for line by line, even on one thread, and
+        // so are regions in another order than reading order
+        if (lease.width() > 1 || self.targetFields.count > 0 || [self prioritizesRegions]) {
+            self.recognized = [self recognizeInParallelWithConcurrency:lease.width()];
+        } else {
+            @try {
+                int returnCode = _tesseract->Recognize(_monitor->get());
+                self.recognized = (returnCode == 0);
+                if (returnCode != 0 && _monitor->deadlineExceeded() && !self.cancellationToken.isCancelled) {
+                    self.recognized = [self collectPartialResult];
+                }
+            }
+            @catch (NSException *exception) {
+                NSLog(@"[Exception] Recognition process encountered an error: %@", exception);
+            }
+        }
     }
-    @catch (NSException *exception) {
-        NSLog(@"[Exception] Recognition process encountered an error: %@", exception);
+
+    // Reduced quality tiers are meant to be cheap, and a first pass that ran
+    // out of time leaves none for refinement
+    BOOL reducedQuality = _qualityTier != nil && !_qualityTier.isFullQuality;
+    if (self.recognized && self.cascadeLanguage.length > 0 && !reducedQuality && !_partialResult) {
+        [self refineLowConfidenceResults];
+    }
+    if (self.recognized && _regionCount == 0) {
+        _recognizedCoverage = 1;
     }
 
+    if (finishProgressEvents) {
+        finishProgressEvents(self.recognized);
+    }
     return self.recognized;
 }
 
+/**
+ * Whether the page is split into regions so that they're recognized in
+ * regionPriority order before maximumRecognitionTime runs out. Modes
+ * recognizing a single line or less, or nothing, have no regions to split
+ * the page into.
+ */
+- (BOOL)prioritizesRegions {
+    if (self.maximumRecognitionTime <= FLT_EPSILON || self.regionPriority == G8RegionPriorityReadingOrder) {
+        return NO;
+    }
+    switch (self.pageSegmentationMode) {
+        case G8PageSegmentationModeOSDOnly:
+        case G8PageSegmentationModeAutoOnly:
+        case G8PageSegmentationModeSingleLine:
+        case G8PageSegmentationModeSingleWord:
+        case G8PageSegmentationModeCircleWord:
+        case G8PageSegmentationModeSingleChar:
+            return NO;
+        default:
+            return YES;
+    }
+}
+
+/**
+ * Keeps the text lines the engine recognized before maximumRecognitionTime
+ * ran out as the results, see maximumRecognitionTime
+ * @return NO if the engine has no results
+ */
+- (BOOL)collectPartialResult {
+    auto result = std::make_unique<g8::ParallelPageResult>();
+    try {
+        if (!g8::collectPartialResult(*_tesseract, *result)) {
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        NSLog(@"[Exception] Collecting partial results encountered an error: %s", e.what());
+        return NO;
+    }
+
+    _partialResult = YES;
+    _regionCount = result->regionCount;
+    _recognizedRegionCount = result->regionsRecognized;
+    _recognizedCoverage = result->coverage;
+
+    _pageResult = std::move(result);
+    return YES;
+}
+
+/**
+ * Recognizes the words or lines of the results below
+ * cascadeConfidenceThreshold again with cascadeLanguage, see cascadeLanguage
+ */
+- (void)refineLowConfidenceResults {
+    // The refinement gets what's left of maximumRecognitionTime
+    int deadlineMsecs = 0;
+    if (self.maximumRecognitionTime > FLT_EPSILON) {
+        NSTimeInterval elapsed = [NSProcessInfo processInfo].systemUptime - _recognitionStart;
+        deadlineMsecs = static_cast<int>((self.maximumRecognitionTime - elapsed) * 1000);
+        if (deadlineMsecs <= 0) {
+            return;
+        }
+    }
+
+    // Results kept by the engine are copied out to be refined
+    std::unique_ptr<g8::ParallelPageResult> engineResult;
+    g8::ParallelPageResult *pageResult = _pageResult.get();
+    if (pageResult == nullptr) {
+        std::unique_ptr<tesseract::ResultIterator> iterator(_tesseract->GetIterator());
+        if (!iterator) {
+            return;
+        }
+        engineResult = std::make_unique<g8::ParallelPageResult>();
+        engineResult->blocks = g8::buildResultTree(*iterator);
+        pageResult = engineResult.get();
+    }
+
+    g8::EngineConfig config = [self engineConfig];
+    config.language = self.cascadeLanguage.UTF8String;
+
+    g8::CascadeOptions options;
+    options.confidenceThreshold = (int)MIN(self.cascadeConfidenceThreshold, (NSUInteger)100);
+    options.regionLevel = self.cascadeLevel == G8PageIteratorLevelTextline ? tesseract::RIL_TEXTLINE : tesseract::RIL_WORD;
+    options.sourceResolution = (int)self.sourceResolution;
+    options.deadlineMsecs = deadlineMsecs;
+    options.cancellation = self.cancellationToken.token;
+    if (_cancelDelegate != nil) {
+        options.shouldCancel = [self] {
+            return static_cast<bool>([self tesseractCancelCallbackFunction:0]);
+        };
+    }
+
+    g8::CascadeStatistics statistics;
+    try {
+        if (!g8::refineLowConfidence(_tesseract->GetInputImage(), config, options, pageResult->blocks, statistics)) {
+            NSLog(@"[Error] Couldn't load the cascade language %@.", self.cascadeLanguage);
+            return;
+        }
+    } catch (const std::exception& e) {
+        NSLog(@"[Exception] Cascade recognition encountered an error: %s", e.what());
+        return;
+    }
+
+    // Unchanged results can stay with the engine
+    if (engineResult && statistics.replaced > 0) {
+        _pageResult = std::move(engineResult);
+    }
+    _cascadeRefinedCount = statistics.recognized;
+    _cascadeReplacedCount = statistics.replaced;
+}
+
+/**
+ * Starts sampling progress for progressEventBlock on progressEventQueue
+ * @return Block that stops sampling and delivers the last event, given
+ *         whether recognition succeeded; nil if there's no progressEventBlock
+ */
+- (void (^)(BOOL))startProgressEvents {
+    G8ProgressEventBlock block = self.progressEventBlock;
+    _monitor->setSampling(block != nil);
+    if (block == nil) {
+        return nil;
+    }
+
+    auto channel = std::make_shared<g8::ProgressChannel>(self.progressEventInterval,
+                                                         static_cast<int>(self.progressEventMinimumDelta));
+    dispatch_queue_t queue = self.progressEventQueue;
+    uint64_t interval = static_cast<uint64_t>(MAX(self.progressEventInterval, 0.01) * NSEC_PER_SEC);
+
+    // Samples are taken on the delivery queue, the recognition thread only
+    // keeps the monitor's counters up to date
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, interval / 10);
+    dispatch_source_set_event_handler(timer, ^{
+        g8::ProgressEvent event;
+        if (channel->sample(self->_monitor->sample(), event)) {
+            block([G8Tesseract progressEventFromEvent:event]);
+        }
+    });
+    dispatch_resume(timer);
+
+    return ^(BOOL recognized) {
+        dispatch_source_cancel(timer);
+        g8::ProgressEvent event;
+        if (channel->finish(self->_monitor->sample(), recognized, event)) {
+            G8ProgressEvent *progressEvent = [G8Tesseract progressEventFromEvent:event];
+            dispatch_async(queue, ^{
+                block(progressEvent);
+            });
+        }
+    };
+}
+
++ (G8ProgressEvent *)progressEventFromEvent:(const g8::ProgressEvent &)event {
+    return [[G8ProgressEvent alloc] initWithProgress:event.progress
+                                           wordCount:event.words
+                                         elapsedTime:event.elapsedSeconds
+                                      wordsPerSecond:event.wordsPerSecond
+                              estimatedTimeRemaining:event.remainingSeconds
+                                            finished:event.finished
+                                           completed:event.completed];
+}
+
+- (dispatch_queue_t)progressEventQueue {
+    return _progressEventQueue ?: dispatch_get_main_queue();
+}
+
+/**
+ * Recognizes the page region by region on several threads, see
+ * parallelRecognitionMode, targetFields and regionPriority
+ * @param concurrency Number of threads, granted by the concurrency governor
+ * @return YES if every region was recognized, or the time ran out
+ */
+- (BOOL)recognizeInParallelWithConcurrency:(size_t)concurrency {
+    g8::ParallelRecognitionOptions options;
+    switch (self.parallelRecognitionMode) {
+        case G8ParallelRecognitionModeBlocks:
+            options.regionLevel = tesseract::RIL_BLOCK;
+            break;
+        case G8ParallelRecognitionModeParagraphs:
+            options.regionLevel = tesseract::RIL_PARA;
+            break;
+        default:
+            // Without a mode the page is split for target fields or region
+            // priority, which lines serve best
+            options.regionLevel = tesseract::RIL_TEXTLINE;
+            break;
+    }
+    options.concurrency = concurrency;
+    options.sourceResolution = (int)self.sourceResolution;
+
+    // Lines are the smallest regions, found soonest
+    std::unique_ptr<g8::FieldMatcher> matcher;
+    if (self.targetFields.count > 0) {
+        std::vector<g8::FieldTarget> targets;
+        for (G8FieldTarget *field in self.targetFields) {
+            g8::FieldTarget target;
+            target.name = field.name.UTF8String;
+            target.level = field.level == G8PageIteratorLevelTextline ? tesseract::RIL_TEXTLINE : tesseract::RIL_WORD;
+            target.minimumConfidence = field.minimumConfidence;
+            G8FieldPredicate predicate = field.predicate;
+            target.matches = [predicate](const std::string &text) {
+                @autoreleasepool {
+                    return static_cast<bool>(predicate([NSString stringWithUTF8String:text.c_str()] ?: @""));
+                }
+            };
+            targets.push_back(std::move(target));
+        }
+        matcher = std::make_unique<g8::FieldMatcher>(std::move(targets));
+        options.regionLevel = tesseract::RIL_TEXTLINE;
+        g8::FieldMatcher *fieldMatcher = matcher.get();
+        options.regionRecognized = [fieldMatcher](const std::vector<g8::ResultNode> &blocks) {
+            return fieldMatcher->inspect(blocks);
+        };
+    }
+    if (self.maximumRecognitionTime > FLT_EPSILON) {
+        options.deadlineMsecs = static_cast<int>(self.maximumRecognitionTime * 1000);
+        options.partialOnDeadline = true;
+    }
+    switch (self.regionPriority) {
+        case G8RegionPriorityCenterFirst:
+            options.order = g8::RegionOrder::CenterFirst;
+            break;
+        case G8RegionPriorityLargestFirst:
+            options.order = g8::RegionOrder::LargestFirst;
+            break;
+        default:
+            options.order = g8::RegionOrder::Reading;
+            break;
+    }
+
+    // Both are called from the worker threads, one at a time
+    g8::TextMonitor *monitor = _monitor.get();
+    options.cancellation = self.cancellationToken.token;
+    if (_cancelDelegate != nil) {
+        options.shouldCancel = [self] {
+            return static_cast<bool>([self tesseractCancelCallbackFunction:0]);
+        };
+    }
+    options.progress = [self, monitor](int progress) {
+        monitor->setProgress(progress);
+        [self tesseractProgressCallbackFunction:0];
+    };
+
+    auto result = std::make_unique<g8::ParallelPageResult>();
+    try {
+        if (!g8::recognizeInParallel(*_tesseract, [self engineConfig], options, *result)) {
+            if (!result->cancelled) {
+                NSLog(@"[Error] Parallel recognition failed.");
+            }
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        NSLog(@"[Exception] Parallel recognition encountered an error: %s", e.what());
+        return NO;
+    }
+
+    if (matcher) {
+        NSMutableDictionary *fields = [NSMutableDictionary dictionary];
+        for (const g8::FieldMatch &match : matcher->matches()) {
+            fields[@(match.name.c_str())] = [self blockFromNode:match.node];
+        }
+        _recognizedFields = [fields copy];
+        _finishedEarly = result->finishedEarly;
+    }
+    _partialResult = result->partial;
+    _regionCount = result->regionCount;
+    _recognizedRegionCount = result->regionsRecognized;
+    _recognizedCoverage = result->coverage;
+
+    _pageResult = std::move(result);
+    return YES;
+}
+
+/**
+ * Recognizes the page with every mode of speculativePageSegmentationModes at
+ * once and keeps the most confident result
+ * @return YES if a mode finished
+ */
+- (BOOL)recognizeSpeculatively {
+    g8::SpeculativeRecognitionOptions options;
+    for (NSNumber *mode in self.speculativePageSegmentationModes) {
+        options.pageSegModes.push_back(mode.intValue);
+    }
+    options.winningConfidence = (int)MIN(self.speculativeWinningConfidence, (NSUInteger)INT_MAX);
+    options.sourceResolution = (int)self.sourceResolution;
+    if (self.maximumRecognitionTime > FLT_EPSILON) {
+        options.deadlineMsecs = static_cast<int>(self.maximumRecognitionTime * 1000);
+    }
+    if (!CGRectIsEmpty(_rect)) {
+        CGRect rect = [self engineRectForRect:_rect];
+        options.left = (int)CGRectGetMinX(rect);
+        options.top = (int)CGRectGetMinY(rect);
+        options.width = (int)CGRectGetWidth(rect);
+        options.height = (int)CGRectGetHeight(rect);
+    }
+
+    // Called from the worker threads, one at a time
+    options.cancellation = self.cancellationToken.token;
+    if (_cancelDelegate != nil) {
+        options.shouldCancel = [self] {
+            return static_cast<bool>([self tesseractCancelCallbackFunction:0]);
+        };
+    }
+
+    g8::SpeculativeResult result;
+    try {
+        if (!g8::recognizeSpeculatively(_tesseract->GetInputImage(), [self engineConfig], options, result)) {
+            if (!result.cancelled) {
+                NSLog(@"[Error] Speculative recognition failed.");
+            }
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        NSLog(@"[Exception] Speculative recognition encountered an error: %s", e.what());
+        return NO;
+    }
+
+    auto pageResult = std::make_unique<g8::ParallelPageResult>();
+    pageResult->blocks = std::move(result.blocks);
+    _pageResult = std::move(pageResult);
+    _recognizedPageSegmentationMode = (G8PageSegmentationMode)result.pageSegMode;
+
+    _monitor->setProgress(100);
+    [self tesseractProgressCallbackFunction:0];
+    return YES;
+}
+
+- (BOOL)recognizeAtQualityTier:(G8QualityTier *)tier index:(NSUInteger)index {
+    _qualityTier = tier;
+    _qualityTierIndex = index;
+    BOOL recognized = [self recognize];
+    _qualityTier = nil;
+    _qualityTierIndex = 0;
+    return recognized;
+}
+
+/**
+ * Recognizes the page with the settings of _qualityTier on an engine of its
+ * own, see G8RecognitionScheduler's qualityTiers
+ * @return YES if the page was recognized
+ */
+- (BOOL)recognizeAtReducedQuality {
+    g8::QualityTier tier;
+    tier.language = _qualityTier.language.UTF8String ?: "";
+    if (_qualityTier.pageSegmentationMode != nil) {
+        tier.pageSegMode = _qualityTier.pageSegmentationMode.intValue;
+    }
+    tier.scale = _qualityTier.imageScale;
+
+    g8::TierRecognitionOptions options;
+    options.pageSegMode = (int)self.pageSegmentationMode;
+    options.sourceResolution = (int)self.sourceResolution;
+    if (self.maximumRecognitionTime > FLT_EPSILON) {
+        options.deadlineMsecs = static_cast<int>(self.maximumRecognitionTime * 1000);
+    }
+    if (!CGRectIsEmpty(_rect)) {
+        CGRect rect = [self engineRectForRect:_rect];
+        options.left = (int)CGRectGetMinX(rect);
+        options.top = (int)CGRectGetMinY(rect);
+        options.width = (int)CGRectGetWidth(rect);
+        options.height = (int)CGRectGetHeight(rect);
+    }
+    options.cancellation = self.cancellationToken.token;
+    if (_cancelDelegate != nil) {
+        options.shouldCancel = [self] {
+            return static_cast<bool>([self tesseractCancelCallbackFunction:0]);
+        };
+    }
+
+    g8::TierResult result;
+    try {
+        if (!g8::recognizeAtTier(_tesseract->GetInputImage(), [self engineConfig], tier, options, result)) {
+            if (!result.cancelled) {
+                NSLog(@"[Error] Recognition at quality tier %lu failed.", (unsigned long)_qualityTierIndex);
+            }
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        NSLog(@"[Exception] Recognition at quality tier %lu encountered an error: %s",
+              (unsigned long)_qualityTierIndex, e.what());
+        return NO;
+    }
+
+    auto pageResult = std::make_unique<g8::ParallelPageResult>();
+    pageResult->blocks = std::move(result.blocks);
+    _pageResult = std::move(pageResult);
+    if (tier.pageSegMode >= 0) {
+        _recognizedPageSegmentationMode = (G8PageSegmentationMode)tier.pageSegMode;
+    }
+
+    _monitor->setProgress(100);
+    [self tesseractProgressCallbackFunction:0];
+    return YES;
+}
+
 - (UIImage *)thresholdedImage {
     if (!self.isEngineConfigured) {
         return nil;
@@ -1237,26 +2107,45 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
 }
 
 - (Pix *)pixForImage:(UIImage *)image {
-    if (!image) {
+    CFDataRef imageData = [self copyPixelDataForImage:image];
+    if (!imageData) {
         return nullptr;
     }
 
-    int width = image.size.width;
-    int height = image.size.height;
+    Pix *pix = [self pixForImage:image pixelData:imageData];
+    CFRelease(imageData);
+    return pix;
+}
 
-    if (width <= 0 || height <= 0) {
-        return nullptr;
+/**
+ * Decodes the pixels of an image. Safe to call from any thread.
+ * @param image The image to decode
+ * @return The pixel data owned by the caller, or NULL on failure
+ */
+- (CFDataRef)copyPixelDataForImage:(UIImage *)image CF_RETURNS_RETAINED {
+    if (!image || image.size.width < 1 || image.size.height < 1) {
+        return NULL;
     }
 
     CGImage *cgImage = image.CGImage;
     if (!cgImage) {
-        return nullptr;
+        return NULL;
     }
 
-    CFDataRef imageData = CGDataProviderCopyData(CGImageGetDataProvider(cgImage));
-    if (!imageData) {
-        return nullptr;
-    }
+    return CGDataProviderCopyData(CGImageGetDataProvider(cgImage));
+}
+
+/**
+ * Converts decoded pixels to a Leptonica image in the image's orientation.
+ * Safe to call from any thread.
+ * @param image The image the pixels belong to
+ * @param imageData Pixels returned by copyPixelDataForImage:
+ * @return A new Pix owned by the caller, or nullptr on failure
+ */
+- (Pix *)pixForImage:(UIImage *)image pixelData:(CFDataRef)imageData {
+    int width = image.size.width;
+    int height = image.size.height;
+    CGImage *cgImage = image.CGImage;
 
     const UInt8 *pixels = CFDataGetBytePtr(imageData);
     size_t bitsPerPixel = CGImageGetBitsPerPixel(cgImage);
@@ -1266,7 +2155,6 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
     int bpp = MAX(1, (int)bitsPerPixel);
     Pix *pix = pixCreate(width, height, bpp == 24 ? 32 : bpp);
     if (!pix) {
-        CFRelease(imageData);
         return nullptr;
     }
 
@@ -1292,13 +2180,11 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         default:
             NSLog(@"Cannot convert image to Pix with bpp = %d", bpp);
             pixDestroy(&pix);
-            CFRelease(imageData);
             return nullptr;
     }
 
     if (!copyBlock) {
         pixDestroy(&pix);
-        CFRelease(imageData);
         return nullptr;
     }
 
@@ -1383,28 +2269,52 @@ static bool tesseractCancelCallbackFunction(void *cancel_this, int words);
         pixSetYRes(pix, (l_int32)self.sourceResolution);
     }
 
-    CFRelease(imageData);
     return pix;
 }
 
-- (void)tesseractProgressCallbackFunction:(int)words {
-    if ([self.delegate respondsToSelector:@selector(progressImageRecognitionForTesseract:)]) {
-        [self.delegate progressImageRecognitionForTesseract:self];
-    }
+- (void)setCancellationToken:(G8CancellationToken *)cancellationToken {
+    _cancellationToken = cancellationToken ?: [[G8CancellationToken alloc] init];
 }
 
-- (BOOL)tesseractCancelCallbackFunction:(int)words {
-    if (_monitor->get()->ocr_alive == 1) {
-        _monitor->get()->ocr_alive = 0;
+/**
+ * Sets up the monitor for a recognition. The delegate is asked which methods
+ * it implements once here, instead of every time Tesseract polls the monitor.
+ */
+- (void)prepareMonitor {
+    _monitor->reset();
+    _monitor->setDeadline(self.maximumRecognitionTime > FLT_EPSILON
+                          ? static_cast<int>(self.maximumRecognitionTime * 1000) : 0);
+
+    id<G8TesseractDelegate> delegate = self.delegate;
+    BOOL delegateCancels = [delegate respondsToSelector:@selector(shouldCancelImageRecognitionForTesseract:)];
+    BOOL delegateObservesProgress = [delegate respondsToSelector:@selector(progressImageRecognitionForTesseract:)];
+    _cancelDelegate = delegateCancels ? delegate : nil;
+    _progressDelegate = delegateObservesProgress ? delegate : nil;
+
+    // Without a delegate to ask, Tesseract only reads the token's flag
+    if (delegateCancels) {
+        _monitor->setCancelCallback(tesseractCancelCallbackFunction, (__bridge void*)self);
+    } else {
+        _monitor->setCancellationToken(self.cancellationToken.token);
     }
 
-    [self tesseractProgressCallbackFunction:words];  // Notify progress during cancellation check
-
-    BOOL isCancel = NO;
-    if ([self.delegate respondsToSelector:@selector(shouldCancelImageRecognitionForTesseract:)]) {
-        isCancel = [self.delegate shouldCancelImageRecognitionForTesseract:self];
+    if (delegateObservesProgress) {
+        // The monitor is owned by self, retaining self would leak both
+        __unsafe_unretained G8Tesseract *unretainedSelf = self;
+        _monitor->setProgressCallback([unretainedSelf](int progress) {
+            [unretainedSelf tesseractProgressCallbackFunction:0];
+        });
+    } else {
+        _monitor->setProgressCallback(nullptr);
     }
-    return isCancel;
+}
+
+- (void)tesseractProgressCallbackFunction:(int)words {
+    [_progressDelegate progressImageRecognitionForTesseract:self];
+}
+
+- (BOOL)tesseractCancelCallbackFunction:(int)words {
+    return self.cancellationToken.isCancelled || [_cancelDelegate shouldCancelImageRecognitionForTesseract:self];
 }
 
 static bool tesseractCancelCallbackFunction(void *cancel_this, int words) {
@@ -21,7 +21,8 @@
 
 /**
  *  An optional method to be called periodically during recognition so
- *  the recognition's progress can be observed.
+ *  the recognition's progress can be observed. It is called each time
+ *  `progress` increases.
  *
  *  @param tesseract The `G8Tesseract` object performing the recognition.
  */
@@ -31,6 +32,10 @@
  *  An optional method to be called periodically during recognition so
  *  the user can choose whether or not to cancel recognition.
  *
+ *  @note It is called for every recognized word. Prefer cancelling the
+ *        `cancellationToken` of `G8Tesseract`, which is much cheaper to
+ *        check.
+ *
  *  @param tesseract The `G8Tesseract` object performing the recognition.
  *
  *  @return Whether or not to cancel the recognition in progress.
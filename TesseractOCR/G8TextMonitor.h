@@ -3,6 +3,10 @@
 
 #import <Foundation/Foundation.h>
 
+#import "G8Cancellation.h"
+
+#include <functional>
+
 // Forward declarations to avoid exposing Tesseract internals
 namespace tesseract {
 class ETEXT_DESC;
@@ -18,6 +22,14 @@ typedef bool (*G8CancelationCallback)(void* cancel_this, int words);
 
 namespace g8 {
 
+/**
+ * Progress of a recognition as seen from another thread.
+ */
+struct ProgressSample {
+    int progress = 0;  ///< Percentage, 0-100
+    size_t words = 0;  ///< Words recognized so far
+};
+
 /**
  * RAII wrapper for Tesseract's ETEXT_DESC monitor.
  * Manages the lifecycle of progress/cancellation monitor for OCR operations.
@@ -88,14 +100,64 @@ public:
      */
     void setCancelCallback(G8CancelationCallback cancelFunc, void* userData = nullptr) noexcept;
 
+    /**
+     * Cancel through a token instead of a callback; Tesseract then checks
+     * for cancellation with a single atomic load per word. Replaces the
+     * cancellation callback.
+     * @param token Token to check, kept alive by the monitor
+     */
+    void setCancellationToken(const CancellationToken& token) noexcept;
+
+    /**
+     * Set a callback called when the progress percentage increases, from
+     * Tesseract's progress hook. Tesseract reports progress for every word,
+     * the callback only when the percentage changed.
+     * @param progressFunc Called with the new percentage, empty for none
+     */
+    void setProgressCallback(std::function<void(int)> progressFunc);
+
+    /**
+     * Record progress and a word count that other threads can `sample`.
+     * Costs two relaxed atomic stores per word while enabled.
+     * @param enabled Whether to record
+     */
+    void setSampling(bool enabled) noexcept;
+
+    /**
+     * The progress recorded while sampling is enabled. Can be called from
+     * any thread.
+     */
+    ProgressSample sample() const noexcept;
+
+    /**
+     * Set the progress of an operation that doesn't report it through
+     * Tesseract, e.g. one split over several engines.
+     * @param progress Percentage, 0-100
+     */
+    void setProgress(int progress) noexcept;
+
     /**
      * Set deadline for OCR operation.
-     * @param deadline_msecs Maximum time in milliseconds
+     * @param deadline_msecs Maximum time in milliseconds, 0 to clear the
+     *                       deadline of a previous operation
      */
     void setDeadline(int deadline_msecs) noexcept;
 
+    /**
+     * Whether the deadline set with setDeadline has passed.
+     * @return false if there's no deadline
+     */
+    bool deadlineExceeded() const noexcept;
+
+    /**
+     * Prepare for a new OCR operation: progress goes back to 0.
+     */
+    void reset() noexcept;
+
 private:
-    tesseract::ETEXT_DESC* monitor_; // The wrapped ETEXT_DESC pointer
+    struct Monitor;
+
+    Monitor* monitor_; // The wrapped ETEXT_DESC with the callback state
 };
 
 } // namespace g8
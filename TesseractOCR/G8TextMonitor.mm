@@ -3,9 +3,46 @@
 #import <Tesseract/ocrclass.h>
 #import <stdexcept>
 
+#include <atomic>
+
 namespace g8 {
 
-TextMonitor::TextMonitor(G8CancelationCallback cancelFunc, void* userData): monitor_(new tesseract::ETEXT_DESC()) {
+/**
+ * ETEXT_DESC with the state its callbacks need; Tesseract hands the monitor
+ * back to progress_callback2, so no lookup is needed.
+ */
+struct TextMonitor::Monitor : tesseract::ETEXT_DESC {
+    tesseract::PROGRESS_FUNC2 defaultProgress = progress_callback2;
+    CancellationToken token;
+    std::function<void(int)> progressFunc;
+    int reportedProgress = 0;
+
+    bool sampling = false;
+    std::atomic<int> sampledProgress{0};
+    std::atomic<size_t> sampledWords{0};
+
+    // Called by Tesseract once per word
+    static bool reportProgress(tesseract::ETEXT_DESC* desc, int left, int right, int top, int bottom) {
+        auto* monitor = static_cast<Monitor*>(desc);
+        if (monitor->sampling) {
+            // Only this thread writes, no read-modify-write needed
+            monitor->sampledWords.store(monitor->sampledWords.load(std::memory_order_relaxed) + 1,
+                                        std::memory_order_relaxed);
+            monitor->sampledProgress.store(monitor->progress, std::memory_order_relaxed);
+        }
+        if (monitor->progressFunc && monitor->progress > monitor->reportedProgress) {
+            monitor->reportedProgress = monitor->progress;
+            monitor->progressFunc(monitor->progress);
+        }
+        return monitor->defaultProgress(desc, left, right, top, bottom);
+    }
+
+    void updateProgressHook() {
+        progress_callback2 = progressFunc || sampling ? reportProgress : defaultProgress;
+    }
+};
+
+TextMonitor::TextMonitor(G8CancelationCallback cancelFunc, void* userData): monitor_(new Monitor()) {
     if (!monitor_) {
         throw std::bad_alloc();
     }
@@ -48,9 +85,63 @@ void TextMonitor::setCancelCallback(G8CancelationCallback cancelFunc, void* user
     }
 }
 
+void TextMonitor::setCancellationToken(const CancellationToken& token) noexcept {
+    if (monitor_) {
+        monitor_->token = token;
+        setCancelCallback(CancellationToken::cancelCallback, monitor_->token.flag());
+    }
+}
+
+void TextMonitor::setProgressCallback(std::function<void(int)> progressFunc) {
+    if (monitor_) {
+        monitor_->progressFunc = std::move(progressFunc);
+        monitor_->updateProgressHook();
+    }
+}
+
+void TextMonitor::setSampling(bool enabled) noexcept {
+    if (monitor_) {
+        monitor_->sampling = enabled;
+        monitor_->updateProgressHook();
+    }
+}
+
+ProgressSample TextMonitor::sample() const noexcept {
+    ProgressSample sample;
+    if (monitor_) {
+        sample.progress = monitor_->sampledProgress.load(std::memory_order_relaxed);
+        sample.words = monitor_->sampledWords.load(std::memory_order_relaxed);
+    }
+    return sample;
+}
+
+void TextMonitor::setProgress(int progress) noexcept {
+    if (monitor_) {
+        monitor_->progress = static_cast<int16_t>(progress);
+        monitor_->sampledProgress.store(progress, std::memory_order_relaxed);
+    }
+}
+
 void TextMonitor::setDeadline(int deadline_msecs) noexcept {
     if (monitor_) {
-        monitor_->set_deadline_msecs(deadline_msecs);
+        if (deadline_msecs > 0) {
+            monitor_->set_deadline_msecs(deadline_msecs);
+        } else {
+            monitor_->end_time = std::chrono::steady_clock::time_point();
+        }
+    }
+}
+
+bool TextMonitor::deadlineExceeded() const noexcept {
+    return monitor_ && monitor_->deadline_exceeded();
+}
+
+void TextMonitor::reset() noexcept {
+    if (monitor_) {
+        monitor_->progress = 0;
+        monitor_->reportedProgress = 0;
+        monitor_->sampledProgress.store(0, std::memory_order_relaxed);
+        monitor_->sampledWords.store(0, std::memory_order_relaxed);
     }
 }
 
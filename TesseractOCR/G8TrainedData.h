@@ -0,0 +1,169 @@
+#ifndef G8TrainedData_h
+#define G8TrainedData_h
+
+#import <Foundation/Foundation.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forward declarations to avoid exposing Leptonica internals
+struct Pix;
+
+namespace g8 {
+
+struct EngineConfig;
+
+/**
+ * Components of a traineddata file, in file order.
+ * Values match tesseract::TessdataType.
+ */
+enum class TrainedDataComponent : int {
+    LangConfig = 0,
+    Unicharset = 1,
+    Ambigs = 2,
+    IntTemplates = 3,
+    PffmTable = 4,
+    NormProto = 5,
+    PuncDawg = 6,
+    SystemDawg = 7,
+    NumberDawg = 8,
+    FreqDawg = 9,
+    FixedLengthDawgs = 10,  ///< Obsolete
+    CubeUnicharset = 11,    ///< Obsolete
+    CubeSystemDawg = 12,    ///< Obsolete
+    ShapeTable = 13,
+    BigramDawg = 14,
+    UnambigDawg = 15,
+    ParamsModel = 16,
+    LSTM = 17,
+    LSTMPuncDawg = 18,
+    LSTMSystemDawg = 19,
+    LSTMNumberDawg = 20,
+    LSTMUnicharset = 21,
+    LSTMRecoder = 22,
+    Version = 23,
+};
+
+/**
+ * The component's file name suffix as used by combine_tessdata, e.g. "lstm".
+ */
+const char* componentName(TrainedDataComponent component);
+
+/**
+ * In-memory traineddata file, the format `combine_tessdata` reads and writes:
+ * an int32 entry count, an int64 offset per component (-1 if absent) and
+ * the component payloads in order.
+ *
+ * Usage example:
+ * @code
+ * auto data = g8::TrainedData::load("tessdata/eng.traineddata");
+ * if (data) {
+ *     data->strip(1);  // OEM_LSTM_ONLY
+ *     data->save("slim/eng.traineddata");
+ * }
+ * @endcode
+ */
+class TrainedData final {
+public:
+    /**
+     * Number of components Tesseract knows about.
+     */
+    static constexpr int kComponentCount = 24;
+
+    /**
+     * Parses a traineddata buffer.
+     * @return The parsed file or nullptr if the buffer is malformed
+     */
+    static std::unique_ptr<TrainedData> parse(const char* bytes, size_t size);
+
+    /**
+     * Reads only the offset table of a traineddata buffer.
+     * @param sizes Receives the size of each component, 0 if absent
+     * @return false if the buffer is malformed
+     */
+    static bool index(const char* bytes, size_t size, std::vector<size_t>& sizes);
+
+    /**
+     * Reads and parses a traineddata file.
+     * @return The parsed file or nullptr if it can't be read or is malformed
+     */
+    static std::unique_ptr<TrainedData> load(const std::string& path);
+
+    /**
+     * Components Tesseract may read when initialized with an engine mode.
+     * @param engineMode tesseract::OcrEngineMode value
+     */
+    static std::vector<TrainedDataComponent> usedComponents(int engineMode);
+
+    bool hasComponent(TrainedDataComponent component) const;
+    size_t componentSize(TrainedDataComponent component) const;
+    void removeComponent(TrainedDataComponent component);
+
+    /**
+     * Removes every component the engine mode doesn't read.
+     * @param engineMode tesseract::OcrEngineMode value
+     * @return false if the file has no model for the engine mode; nothing is
+     *         removed then
+     */
+    bool strip(int engineMode);
+
+    /**
+     * The file contents in traineddata format.
+     */
+    std::vector<char> serialize() const;
+
+    /**
+     * Writes the file contents to path.
+     * @return false on I/O failure
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Size of the serialized file in bytes.
+     */
+    size_t size() const;
+
+private:
+    TrainedData() = default;
+
+    std::vector<std::vector<char>> components_ = std::vector<std::vector<char>>(kComponentCount);
+};
+
+/**
+ * Outcome of `stripTrainedData`.
+ */
+struct TrainedDataStripReport {
+    size_t originalBytes = 0;        ///< Total size of the source files
+    size_t strippedBytes = 0;        ///< Total size of the written files
+    double originalLoadSeconds = 0;  ///< Engine initialization from the source files
+    double strippedLoadSeconds = 0;  ///< Engine initialization from the written files
+    bool verified = false;           ///< Whether an image was recognized with both
+    bool identicalOutput = false;    ///< Whether both recognized the same text
+};
+
+/**
+ * Writes a stripped copy of every traineddata file config loads into
+ * directory, keeping only the components config's engine mode reads. Then
+ * initializes an engine from the originals and one from the copies, timing
+ * both, and recognizes image with each to verify the output is unchanged.
+ *
+ * @param config      Configuration of the engine the files are stripped for
+ * @param directory   Output folder, trailing slash included; not config's
+ *                    data path
+ * @param image       Image to verify with, or nullptr to skip verification
+ * @param pageSegMode tesseract::PageSegMode used for verification
+ * @param report      Receives sizes, load times and the verification result
+ * @return false if directory is config's data path or a file would be
+ *         written over its source, if a file can't be read, stripped or
+ *         written, or if either engine fails to initialize
+ */
+bool stripTrainedData(const EngineConfig& config,
+                      const std::string& directory,
+                      Pix* image,
+                      int pageSegMode,
+                      TrainedDataStripReport& report);
+
+} // namespace g8
+
+#endif /* G8TrainedData_h */
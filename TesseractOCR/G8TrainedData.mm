@@ -0,0 +1,318 @@
+#import "G8TrainedData.h"
+#import "G8Engine.h"
+#import <Tesseract/baseapi.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace g8 {
+
+namespace {
+
+// Tesseract refuses files claiming more entries than this
+constexpr uint32_t kMaxEntryCount = 1000;
+
+// tesseract::OcrEngineMode values
+constexpr int kEngineModeTesseractOnly = 0;
+constexpr int kEngineModeLSTMOnly = 1;
+
+using Component = TrainedDataComponent;
+
+// Resolves symbolic links, so a file and a link to it compare equal
+std::string canonicalPath(const std::string& path) {
+    char resolved[PATH_MAX];
+    return realpath(path.c_str(), resolved) ? std::string(resolved) : path;
+}
+
+const char* const kComponentNames[TrainedData::kComponentCount] = {
+    "config", "unicharset", "unicharambigs", "inttemp", "pffmtable", "normproto",
+    "punc-dawg", "word-dawg", "number-dawg", "freq-dawg", "fixed-length-dawgs",
+    "cube-unicharset", "cube-word-dawg", "shapetable", "bigram-dawg", "unambig-dawg",
+    "params-model", "lstm", "lstm-punc-dawg", "lstm-word-dawg", "lstm-number-dawg",
+    "lstm-unicharset", "lstm-recoder", "version",
+};
+
+/**
+ * Component extents as Tesseract computes them: a component extends to the
+ * next present one, or to the end of the buffer.
+ */
+bool readOffsets(const char* bytes, size_t size, std::vector<std::pair<int64_t, int64_t>>& extents) {
+    uint32_t count = 0;
+    if (!bytes || size < sizeof(count)) {
+        return false;
+    }
+    std::memcpy(&count, bytes, sizeof(count));
+    // A huge count means the file was written with the other byte order
+    if (count > kMaxEntryCount) {
+        return false;
+    }
+
+    const size_t tableEnd = sizeof(count) + count * sizeof(int64_t);
+    if (size < tableEnd) {
+        return false;
+    }
+    std::vector<int64_t> offsets(count);
+    if (count > 0) {
+        std::memcpy(offsets.data(), bytes + sizeof(count), count * sizeof(int64_t));
+    }
+
+    extents.assign(TrainedData::kComponentCount, {-1, -1});
+    for (uint32_t i = 0; i < count && i < TrainedData::kComponentCount; ++i) {
+        if (offsets[i] < 0) {
+            continue;
+        }
+        int64_t end = static_cast<int64_t>(size);
+        for (uint32_t j = i + 1; j < count; ++j) {
+            if (offsets[j] >= 0) {
+                end = offsets[j];
+                break;
+            }
+        }
+        if (offsets[i] < static_cast<int64_t>(tableEnd) || end < offsets[i] ||
+            end > static_cast<int64_t>(size)) {
+            return false;
+        }
+        extents[i] = {offsets[i], end};
+    }
+    return true;
+}
+
+bool isObsolete(Component component) {
+    return component == Component::FixedLengthDawgs ||
+           component == Component::CubeUnicharset ||
+           component == Component::CubeSystemDawg;
+}
+
+bool isLSTM(Component component) {
+    return component >= Component::LSTM && component <= Component::LSTMRecoder;
+}
+
+/**
+ * Initializes an engine from disk rather than from TrainedDataCache, so that
+ * the measured time includes reading the files.
+ */
+std::unique_ptr<Engine> createTimedEngine(const EngineConfig& config, double& seconds) {
+    for (const auto& path : config.trainedDataPaths()) {
+        TrainedDataCache::shared().evict(path);
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<Engine> engine = Engine::create(config);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return engine;
+}
+
+std::string recognizeText(Engine& engine, Pix* image, int pageSegMode) {
+    tesseract::TessBaseAPI* api = engine.api();
+    api->SetPageSegMode(static_cast<tesseract::PageSegMode>(pageSegMode));
+    api->SetImage(image);
+    std::unique_ptr<char[]> text(api->GetUTF8Text());
+    api->Clear();
+    return text ? std::string(text.get()) : std::string();
+}
+
+} // namespace
+
+const char* componentName(TrainedDataComponent component) {
+    return kComponentNames[static_cast<int>(component)];
+}
+
+std::unique_ptr<TrainedData> TrainedData::parse(const char* bytes, size_t size) {
+    std::vector<std::pair<int64_t, int64_t>> extents;
+    if (!readOffsets(bytes, size, extents)) {
+        return nullptr;
+    }
+    std::unique_ptr<TrainedData> data(new TrainedData());
+    for (int i = 0; i < kComponentCount; ++i) {
+        if (extents[i].first >= 0) {
+            data->components_[i].assign(bytes + extents[i].first, bytes + extents[i].second);
+        }
+    }
+    return data;
+}
+
+bool TrainedData::index(const char* bytes, size_t size, std::vector<size_t>& sizes) {
+    std::vector<std::pair<int64_t, int64_t>> extents;
+    if (!readOffsets(bytes, size, extents)) {
+        return false;
+    }
+    sizes.assign(kComponentCount, 0);
+    for (int i = 0; i < kComponentCount; ++i) {
+        if (extents[i].first >= 0) {
+            sizes[i] = static_cast<size_t>(extents[i].second - extents[i].first);
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<TrainedData> TrainedData::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return nullptr;
+    }
+    std::streamsize size = file.tellg();
+    if (size < 0) {
+        return nullptr;
+    }
+    std::vector<char> bytes(static_cast<size_t>(size));
+    file.seekg(0);
+    if (size > 0 && !file.read(bytes.data(), size)) {
+        return nullptr;
+    }
+    return parse(bytes.data(), bytes.size());
+}
+
+std::vector<TrainedDataComponent> TrainedData::usedComponents(int engineMode) {
+    std::vector<Component> components;
+    for (int i = 0; i < kComponentCount; ++i) {
+        Component component = static_cast<Component>(i);
+        if (isObsolete(component)) {
+            continue;
+        }
+        // Every mode reads the language config and the version string
+        bool shared = component == Component::LangConfig || component == Component::Version;
+        if (shared ||
+            (engineMode == kEngineModeLSTMOnly && isLSTM(component)) ||
+            (engineMode == kEngineModeTesseractOnly && !isLSTM(component)) ||
+            (engineMode != kEngineModeLSTMOnly && engineMode != kEngineModeTesseractOnly)) {
+            components.push_back(component);
+        }
+    }
+    return components;
+}
+
+bool TrainedData::hasComponent(TrainedDataComponent component) const {
+    return !components_[static_cast<int>(component)].empty();
+}
+
+size_t TrainedData::componentSize(TrainedDataComponent component) const {
+    return components_[static_cast<int>(component)].size();
+}
+
+void TrainedData::removeComponent(TrainedDataComponent component) {
+    std::vector<char>().swap(components_[static_cast<int>(component)]);
+}
+
+bool TrainedData::strip(int engineMode) {
+    bool hasLSTM = hasComponent(Component::LSTM);
+    bool hasLegacy = hasComponent(Component::Unicharset) && hasComponent(Component::IntTemplates);
+    if ((engineMode == kEngineModeLSTMOnly && !hasLSTM) ||
+        (engineMode == kEngineModeTesseractOnly && !hasLegacy)) {
+        return false;
+    }
+
+    std::vector<bool> used(kComponentCount, false);
+    for (Component component : usedComponents(engineMode)) {
+        used[static_cast<int>(component)] = true;
+    }
+    for (int i = 0; i < kComponentCount; ++i) {
+        if (!used[i]) {
+            removeComponent(static_cast<Component>(i));
+        }
+    }
+    return true;
+}
+
+std::vector<char> TrainedData::serialize() const {
+    const uint32_t count = kComponentCount;
+    std::vector<int64_t> offsets(count, -1);
+    int64_t offset = sizeof(count) + count * sizeof(int64_t);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!components_[i].empty()) {
+            offsets[i] = offset;
+            offset += static_cast<int64_t>(components_[i].size());
+        }
+    }
+
+    std::vector<char> bytes;
+    bytes.reserve(static_cast<size_t>(offset));
+    const char* countBytes = reinterpret_cast<const char*>(&count);
+    bytes.insert(bytes.end(), countBytes, countBytes + sizeof(count));
+    const char* offsetBytes = reinterpret_cast<const char*>(offsets.data());
+    bytes.insert(bytes.end(), offsetBytes, offsetBytes + count * sizeof(int64_t));
+    for (const auto& component : components_) {
+        bytes.insert(bytes.end(), component.begin(), component.end());
+    }
+    return bytes;
+}
+
+bool TrainedData::save(const std::string& path) const {
+    std::vector<char> bytes = serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+size_t TrainedData::size() const {
+    size_t total = sizeof(uint32_t) + kComponentCount * sizeof(int64_t);
+    for (const auto& component : components_) {
+        total += component.size();
+    }
+    return total;
+}
+
+bool stripTrainedData(const EngineConfig& config,
+                      const std::string& directory,
+                      Pix* image,
+                      int pageSegMode,
+                      TrainedDataStripReport& report) {
+    report = TrainedDataStripReport();
+
+    // Writing over the files being stripped would corrupt them, and those
+    // in tessdata may be links into the read-only bundle
+    if (canonicalPath(directory) == canonicalPath(config.dataPath)) {
+        return false;
+    }
+
+    // Config files are looked up relative to the datapath, so point the
+    // stripped configuration at the original ones
+    EngineConfig strippedConfig = config;
+    strippedConfig.dataPath = directory;
+    for (auto& file : strippedConfig.configFiles) {
+        for (const char* folder : {"configs/", "tessconfigs/"}) {
+            std::string path = config.dataPath + folder + file;
+            if (std::ifstream(path)) {
+                file = path;
+                break;
+            }
+        }
+    }
+
+    for (const auto& path : config.trainedDataPaths()) {
+        std::unique_ptr<TrainedData> data = TrainedData::load(path);
+        if (!data) {
+            return false;
+        }
+        report.originalBytes += data->size();
+        if (!data->strip(config.engineMode)) {
+            return false;
+        }
+
+        std::string destination = directory + path.substr(path.find_last_of('/') + 1);
+        if (canonicalPath(destination) == canonicalPath(path) || !data->save(destination)) {
+            return false;
+        }
+        report.strippedBytes += data->size();
+    }
+
+    std::unique_ptr<Engine> original = createTimedEngine(config, report.originalLoadSeconds);
+    std::unique_ptr<Engine> stripped = createTimedEngine(strippedConfig, report.strippedLoadSeconds);
+    if (!original || !stripped) {
+        return false;
+    }
+
+    if (image) {
+        report.verified = true;
+        report.identicalOutput = recognizeText(*original, image, pageSegMode) ==
+                                 recognizeText(*stripped, image, pageSegMode);
+    }
+    return true;
+}
+
+} // namespace g8
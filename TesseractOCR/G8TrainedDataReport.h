@@ -0,0 +1,69 @@
+//
+//  G8TrainedDataReport.h
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  `G8TrainedDataReport` describes the effect of stripping traineddata files
+ *  down to the components an engine mode needs. See
+ *  `writeStrippedTrainedDataToDirectory:` in G8Tesseract.h.
+ */
+@interface G8TrainedDataReport : NSObject
+
+/**
+ *  Total size in bytes of the original traineddata files.
+ */
+@property (nonatomic, assign, readonly) NSUInteger originalSize;
+
+/**
+ *  Total size in bytes of the stripped traineddata files.
+ */
+@property (nonatomic, assign, readonly) NSUInteger strippedSize;
+
+/**
+ *  Time it took to initialize an engine from the original files.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval originalLoadTime;
+
+/**
+ *  Time it took to initialize an engine from the stripped files.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval strippedLoadTime;
+
+/**
+ *  Whether an image was recognized with both engines. This is NO if no image
+ *  was set on the `G8Tesseract` instance.
+ */
+@property (nonatomic, assign, readonly, getter=isVerified) BOOL verified;
+
+/**
+ *  Whether both engines recognized exactly the same text. Only meaningful if
+ *  `verified` is YES.
+ */
+@property (nonatomic, assign, readonly) BOOL identicalOutput;
+
+/**
+ *  Initialize a report with the data it will contain.
+ *
+ *  @param originalSize     Total size of the original files.
+ *  @param strippedSize     Total size of the stripped files.
+ *  @param originalLoadTime Engine initialization time with the original files.
+ *  @param strippedLoadTime Engine initialization time with the stripped files.
+ *  @param verified         Whether the output of both engines was compared.
+ *  @param identicalOutput  Whether the output of both engines was the same.
+ *
+ *  @return The initialized report.
+ */
+- (nonnull instancetype)initWithOriginalSize:(NSUInteger)originalSize
+                                strippedSize:(NSUInteger)strippedSize
+                            originalLoadTime:(NSTimeInterval)originalLoadTime
+                            strippedLoadTime:(NSTimeInterval)strippedLoadTime
+                                    verified:(BOOL)verified
+                             identicalOutput:(BOOL)identicalOutput;
+
+@end
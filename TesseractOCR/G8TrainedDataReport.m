@@ -0,0 +1,39 @@
+//
+//  G8TrainedDataReport.m
+//  Tesseract OCR iOS
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import "G8TrainedDataReport.h"
+
+@implementation G8TrainedDataReport
+
+- (instancetype)initWithOriginalSize:(NSUInteger)originalSize
+                        strippedSize:(NSUInteger)strippedSize
+                    originalLoadTime:(NSTimeInterval)originalLoadTime
+                    strippedLoadTime:(NSTimeInterval)strippedLoadTime
+                            verified:(BOOL)verified
+                     identicalOutput:(BOOL)identicalOutput
+{
+    self = [super init];
+    if (self != nil) {
+        _originalSize = originalSize;
+        _strippedSize = strippedSize;
+        _originalLoadTime = originalLoadTime;
+        _strippedLoadTime = strippedLoadTime;
+        _verified = verified;
+        _identicalOutput = identicalOutput;
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%lu -> %lu bytes, %.3fs -> %.3fs load time",
+            (unsigned long)self.originalSize, (unsigned long)self.strippedSize,
+            self.originalLoadTime, self.strippedLoadTime];
+}
+
+@end
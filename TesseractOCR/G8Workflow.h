@@ -0,0 +1,109 @@
+#ifndef G8Workflow_h
+#define G8Workflow_h
+
+#import <Foundation/Foundation.h>
+
+#import "G8AsyncRecognizer.h"
+#import "G8Coroutine.h"
+#import "G8PixWrapper.h"
+#import "G8ResultNode.h"
+
+#include <string>
+#include <vector>
+
+namespace g8 {
+
+/**
+ * What `preprocess` does to an image, in this order.
+ */
+struct PreprocessOptions {
+    bool grayscale = true;   ///< Convert to 8 bpp grayscale
+    bool deskew = false;     ///< Straighten text lines, see pixDeskew
+    bool binarize = false;   ///< Convert to 1 bpp with a fixed threshold of 127
+};
+
+/**
+ * A page after the recognize stage, detached from the engine.
+ */
+struct RecognizedPage {
+    RecognitionOutput output;
+    std::vector<ResultNode> blocks;  ///< Blocks down to symbols, in reading order
+    int width = 0;                   ///< Size of the image, in pixels
+    int height = 0;
+};
+
+/**
+ * Formats of the render stage.
+ */
+enum class RenderFormat {
+    Text,  ///< As TessBaseAPI::GetUTF8Text
+    TSV,   ///< As TessBaseAPI::GetTSVText, with a header row
+};
+
+/**
+ * The stages of an OCR workflow as coroutines. Each stage continues on a
+ * worker of recognizer's pool, does its work there and completes its
+ * awaiter on the same worker; stages needing an engine use the worker's.
+ * A document waiting for a worker holds no thread, so thousands of
+ * documents can be in flight on a few threads.
+ *
+ * Images passed by reference must outlive the awaited stage.
+ *
+ * Usage example:
+ * @code
+ * g8::Task<std::string> ocr(g8::AsyncRecognizer& recognizer, std::string path) {
+ *     g8::PixWrapper pix = co_await g8::decode(recognizer, path);
+ *     pix = co_await g8::preprocess(recognizer, std::move(pix), g8::PreprocessOptions());
+ *     g8::RecognizedPage page = co_await g8::recognize(recognizer, pix, g8::RecognitionOptions());
+ *     co_return co_await g8::render(recognizer, page, g8::RenderFormat::TSV);
+ * }
+ *
+ * for (const auto& path : paths) {
+ *     g8::spawn(ocr(recognizer, path), [](std::string tsv) { store(tsv); });
+ * }
+ * @endcode
+ */
+
+/**
+ * Decodes an encoded image in any format Leptonica reads.
+ * @return The image, empty if it can't be decoded
+ */
+Task<PixWrapper> decode(AsyncRecognizer& recognizer, std::vector<unsigned char> data);
+
+/**
+ * Reads and decodes an image file.
+ * @return The image, empty if it can't be read
+ */
+Task<PixWrapper> decode(AsyncRecognizer& recognizer, std::string path);
+
+/**
+ * Prepares an image for recognition.
+ * @return The processed image; the input if a step failed
+ */
+Task<PixWrapper> preprocess(AsyncRecognizer& recognizer, PixWrapper pix, PreprocessOptions options);
+
+/**
+ * Runs layout analysis with the worker's engine.
+ * @param pageSegMode tesseract::PageSegMode, -1 to keep the engine's mode
+ * @return Blocks with their text lines as children, boxes only, in reading
+ *         order; empty if the layout can't be analysed
+ */
+Task<std::vector<ResultNode>> analyseLayout(AsyncRecognizer& recognizer, const PixWrapper& pix,
+                                            int pageSegMode = -1);
+
+/**
+ * Recognizes an image with the worker's engine.
+ * @return The text and the result hierarchy
+ */
+Task<RecognizedPage> recognize(AsyncRecognizer& recognizer, const PixWrapper& pix, RecognitionOptions options);
+
+/**
+ * Renders a recognized page.
+ * @param pageNumber Page number written to TSV rows, starting at 1
+ */
+Task<std::string> render(AsyncRecognizer& recognizer, const RecognizedPage& page, RenderFormat format,
+                         int pageNumber = 1);
+
+} // namespace g8
+
+#endif /* G8Workflow_h */
@@ -0,0 +1,154 @@
+#import "G8Workflow.h"
+#import <Leptonica/allheaders.h>
+#import <Tesseract/baseapi.h>
+
+#include <memory>
+
+namespace g8 {
+
+namespace {
+
+/**
+ * Appends one TSV row; levels are those of Tesseract's TSV output, 1 for the
+ * page to 5 for words.
+ */
+void appendRow(std::string& tsv, int level, const int (&numbers)[5], int left, int top, int width, int height,
+               float confidence, const std::string& text) {
+    tsv += std::to_string(level);
+    for (int number : numbers) {
+        tsv += '\t';
+        tsv += std::to_string(number);
+    }
+    tsv += '\t' + std::to_string(left) + '\t' + std::to_string(top);
+    tsv += '\t' + std::to_string(width) + '\t' + std::to_string(height);
+    tsv += '\t' + (confidence < 0 ? std::string("-1") : std::to_string(confidence));
+    tsv += '\t' + text + '\n';
+}
+
+/**
+ * Appends the rows of nodes and their descendants down to words. numbers
+ * holds page, block, paragraph, line and word numbers, as in Tesseract's
+ * TSV output.
+ */
+void appendRows(std::string& tsv, const std::vector<ResultNode>& nodes, int (&numbers)[5]) {
+    for (const auto& node : nodes) {
+        if (node.level > tesseract::RIL_WORD) {
+            continue;
+        }
+        // Number this level, restart the deeper ones
+        const int column = node.level + 1;
+        ++numbers[column];
+        for (int deeper = column + 1; deeper < 5; ++deeper) {
+            numbers[deeper] = 0;
+        }
+
+        const bool isWord = node.level == tesseract::RIL_WORD;
+        appendRow(tsv, node.level + 2, numbers, node.left, node.top, node.right - node.left, node.bottom - node.top,
+                  isWord ? node.confidence : -1, isWord ? node.text : std::string());
+        appendRows(tsv, node.children, numbers);
+    }
+}
+
+} // namespace
+
+Task<PixWrapper> decode(AsyncRecognizer& recognizer, std::vector<unsigned char> data) {
+    co_await resumeOn(recognizer.pool());
+    co_return PixWrapper(data.empty() ? nullptr : pixReadMem(data.data(), data.size()));
+}
+
+Task<PixWrapper> decode(AsyncRecognizer& recognizer, std::string path) {
+    co_await resumeOn(recognizer.pool());
+    co_return PixWrapper(pixRead(path.c_str()));
+}
+
+Task<PixWrapper> preprocess(AsyncRecognizer& recognizer, PixWrapper pix, PreprocessOptions options) {
+    co_await resumeOn(recognizer.pool());
+    if (!pix) {
+        co_return std::move(pix);
+    }
+
+    if (options.grayscale && pixGetDepth(pix.get()) != 8) {
+        PixWrapper gray(pixConvertTo8(pix.get(), 0));
+        if (gray) {
+            pix = std::move(gray);
+        }
+    }
+    if (options.deskew) {
+        PixWrapper deskewed(pixDeskew(pix.get(), 0));
+        if (deskewed) {
+            pix = std::move(deskewed);
+        }
+    }
+    if (options.binarize && pixGetDepth(pix.get()) != 1) {
+        PixWrapper binary(pixConvertTo1(pix.get(), UINT8_MAX / 2));
+        if (binary) {
+            pix = std::move(binary);
+        }
+    }
+    co_return std::move(pix);
+}
+
+Task<std::vector<ResultNode>> analyseLayout(AsyncRecognizer& recognizer, const PixWrapper& pix, int pageSegMode) {
+    co_await resumeOn(recognizer.pool());
+    std::vector<ResultNode> blocks;
+    Engine* engine = pix ? recognizer.workerEngine() : nullptr;
+    if (!engine) {
+        co_return blocks;
+    }
+
+    tesseract::TessBaseAPI* api = engine->api();
+    const tesseract::PageSegMode previousMode = api->GetPageSegMode();
+    if (pageSegMode >= 0) {
+        api->SetPageSegMode(static_cast<tesseract::PageSegMode>(pageSegMode));
+    }
+    api->SetImage(pix.get());
+
+    std::unique_ptr<tesseract::PageIterator> iterator(api->AnalyseLayout());
+    if (iterator && !iterator->Empty(tesseract::RIL_TEXTLINE)) {
+        do {
+            ResultNode line;
+            line.level = tesseract::RIL_TEXTLINE;
+            iterator->BoundingBox(tesseract::RIL_TEXTLINE, &line.left, &line.top, &line.right, &line.bottom);
+            if (blocks.empty() || iterator->IsAtBeginningOf(tesseract::RIL_BLOCK)) {
+                ResultNode block;
+                block.level = tesseract::RIL_BLOCK;
+                iterator->BoundingBox(tesseract::RIL_BLOCK, &block.left, &block.top, &block.right, &block.bottom);
+                blocks.push_back(std::move(block));
+            }
+            blocks.back().children.push_back(std::move(line));
+        } while (iterator->Next(tesseract::RIL_TEXTLINE));
+    }
+
+    iterator.reset();
+    api->Clear();
+    api->SetPageSegMode(previousMode);
+    co_return blocks;
+}
+
+Task<RecognizedPage> recognize(AsyncRecognizer& recognizer, const PixWrapper& pix, RecognitionOptions options) {
+    co_await resumeOn(recognizer.pool());
+    RecognizedPage page;
+    if (pix) {
+        page.width = pixGetWidth(pix.get());
+        page.height = pixGetHeight(pix.get());
+        page.output = recognizer.recognizeOnWorker(pix.get(), options, &page.blocks);
+    }
+    co_return page;
+}
+
+Task<std::string> render(AsyncRecognizer& recognizer, const RecognizedPage& page, RenderFormat format,
+                         int pageNumber) {
+    co_await resumeOn(recognizer.pool());
+    if (format == RenderFormat::Text) {
+        co_return page.output.text;
+    }
+
+    std::string tsv = "level\tpage_num\tblock_num\tpar_num\tline_num\tword_num\t"
+                      "left\ttop\twidth\theight\tconf\ttext\n";
+    int numbers[5] = {pageNumber, 0, 0, 0, 0};
+    appendRow(tsv, 1, numbers, 0, 0, page.width, page.height, -1, std::string());
+    appendRows(tsv, page.blocks, numbers);
+    co_return tsv;
+}
+
+} // namespace g8
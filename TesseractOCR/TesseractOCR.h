@@ -19,10 +19,22 @@ FOUNDATION_EXPORT const unsigned char TesseractOCRVersionString[];
 #define Tesseract_OCR_iOS_TesseractOCR_h
 
 #import <TesseractOCR/G8Tesseract.h>
+#import <TesseractOCR/G8CancellationToken.h>
+#import <TesseractOCR/G8ProgressEvent.h>
 #import <TesseractOCR/G8RecognizedBlock.h>
 #import <TesseractOCR/G8HierarchicalRecognizedBlock.h>
 #import <TesseractOCR/G8TesseractParameters.h>
 #import <TesseractOCR/G8RecognitionOperation.h>
+#import <TesseractOCR/G8RecognitionQueue.h>
+#import <TesseractOCR/G8RecognitionResult.h>
+#import <TesseractOCR/G8RecognitionScheduler.h>
+#import <TesseractOCR/G8SchedulerMetrics.h>
+#import <TesseractOCR/G8QualityTier.h>
+#import <TesseractOCR/G8FieldTarget.h>
+#import <TesseractOCR/G8MemoryEntry.h>
+#import <TesseractOCR/G8TrainedDataReport.h>
+#import <TesseractOCR/G8StartupProfile.h>
+#import <TesseractOCR/G8PipelineStage.h>
 #import <TesseractOCR/G8Constants.h>
 #import <TesseractOCR/UIImage+G8Filters.h>
 
@@ -0,0 +1,135 @@
+//
+//  AsyncRecognizerTests.mm
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+// Internal to the framework, not one of its public headers
+#import "../../TesseractOCR/G8AsyncRecognizer.h"
+
+#include <atomic>
+#include <memory>
+
+// Leptonica's headers aren't public either; the loaders only need this one
+extern "C" Pix *pixRead(const char *filename);
+
+SPEC_BEGIN(AsyncRecognizerTests)
+
+describe(@"Asynchronous recognizer", ^{
+
+    __block g8::EngineConfig config;
+
+    // Reads the image on the worker thread, the way callers are expected to
+    g8::AsyncRecognizer::ImageLoader (^loaderForImage)(NSString *, NSString *) =
+        ^g8::AsyncRecognizer::ImageLoader(NSString *name, NSString *type) {
+        std::string path = [[NSBundle mainBundle] pathForResource:name ofType:type].fileSystemRepresentation;
+        return [path]() -> Pix * {
+            return pixRead(path.c_str());
+        };
+    };
+
+    beforeEach(^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(tesseract.isEngineConfigured) should] beYes];
+
+        config = g8::EngineConfig();
+        config.dataPath = tesseract.absoluteDataPath.fileSystemRepresentation;
+        config.language = tesseract.language.UTF8String;
+        config.engineMode = (int)tesseract.engineMode;
+    });
+
+    it(@"Should resolve a future with the recognized text", ^{
+        g8::AsyncRecognizer recognizer(config, 2);
+        g8::RecognitionOptions options;
+        options.pageSegMode = G8PageSegmentationModeSingleLine;
+
+        g8::RecognitionOutput output = recognizer.submit(loaderForImage(@"image_sample", @"jpg"), options).get();
+        [[theValue(output.recognized) should] beYes];
+        [[theValue(output.cancelled) should] beNo];
+        [[@(output.text.c_str()) should] containString:@"1234567890"];
+        [[theValue(output.meanConfidence) should] beGreaterThan:theValue(0)];
+        [[theValue(output.worker) should] beLessThan:theValue(recognizer.threadCount())];
+    });
+
+    it(@"Should call every completion exactly once on a worker thread", ^{
+        g8::AsyncRecognizer recognizer(config, 2);
+        auto calls = std::make_shared<std::atomic<int>>(0);
+        auto offWorker = std::make_shared<std::atomic<int>>(0);
+        for (int i = 0; i < 4; ++i) {
+            recognizer.submit(loaderForImage(@"image_sample", @"jpg"), g8::RecognitionOptions(),
+                              [&recognizer, calls, offWorker](g8::RecognitionOutput output) {
+                if (recognizer.pool().workerIndex() == g8::TaskPool::npos) {
+                    ++*offWorker;
+                }
+                if (output.recognized) {
+                    ++*calls;
+                }
+            });
+        }
+        recognizer.pool().wait();
+
+        [[theValue(calls->load()) should] equal:theValue(4)];
+        [[theValue(offWorker->load()) should] equal:theValue(0)];
+    });
+
+    it(@"Should report progress", ^{
+        g8::AsyncRecognizer recognizer(config, 1);
+        auto lastPercent = std::make_shared<std::atomic<int>>(0);
+        g8::RecognitionOptions options;
+        options.progress = [lastPercent](int percent) {
+            *lastPercent = percent;
+        };
+
+        g8::RecognitionOutput output = recognizer.submit(loaderForImage(@"well_scaned_page", @"png"), options).get();
+        [[theValue(output.recognized) should] beYes];
+        [[theValue(lastPercent->load()) should] beGreaterThan:theValue(0)];
+    });
+
+    it(@"Should skip a submission cancelled before it starts", ^{
+        g8::AsyncRecognizer recognizer(config, 1);
+        auto loaded = std::make_shared<std::atomic<bool>>(false);
+        g8::RecognitionOptions options;
+        options.cancellation.cancel();
+
+        g8::RecognitionOutput output = recognizer.submit([loaded]() -> Pix * {
+            *loaded = true;
+            return nullptr;
+        }, options).get();
+        [[theValue(output.cancelled) should] beYes];
+        [[theValue(output.recognized) should] beNo];
+        [[theValue(loaded->load()) should] beNo];
+    });
+
+    it(@"Should stop a recognition cancelled while it runs", ^{
+        g8::AsyncRecognizer recognizer(config, 1);
+        g8::RecognitionOptions options;
+        g8::CancellationToken token = options.cancellation;
+        options.progress = [token](int) {
+            token.cancel();
+        };
+
+        g8::RecognitionOutput output = recognizer.submit(loaderForImage(@"well_scaned_page", @"png"), options).get();
+        [[theValue(output.cancelled) should] beYes];
+        [[theValue(output.recognized) should] beNo];
+        [[theValue(output.text.empty()) should] beYes];
+    });
+
+    it(@"Should fail an image that can't be loaded", ^{
+        g8::AsyncRecognizer recognizer(config, 1);
+
+        g8::RecognitionOutput output = recognizer.submit([]() -> Pix * {
+            return nullptr;
+        }).get();
+        [[theValue(output.recognized) should] beNo];
+        [[theValue(output.cancelled) should] beNo];
+    });
+});
+
+SPEC_END
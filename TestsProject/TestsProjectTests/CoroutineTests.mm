@@ -0,0 +1,141 @@
+//
+//  CoroutineTests.mm
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Kiwi/Kiwi.h>
+
+// Internal to the framework, not one of its public headers
+#import "../../TesseractOCR/G8Coroutine.h"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+g8::Task<> setFlag(bool& flag) {
+    flag = true;
+    co_return;
+}
+
+g8::Task<int> answer(g8::TaskPool& pool) {
+    co_await g8::resumeOn(pool);
+    co_return 42;
+}
+
+g8::Task<int> sumOfAnswers(g8::TaskPool& pool) {
+    int first = co_await answer(pool);
+    int second = co_await answer(pool);
+    co_return first + second;
+}
+
+g8::Task<size_t> workerIndex(g8::TaskPool& pool) {
+    co_await g8::resumeOn(pool);
+    co_return pool.workerIndex();
+}
+
+g8::Task<bool> staysOnWorker(g8::TaskPool& pool) {
+    co_await g8::resumeOn(pool);
+    const size_t worker = pool.workerIndex();
+    co_await g8::resumeOn(pool);
+    co_return pool.workerIndex() == worker;
+}
+
+g8::Task<int> failing(g8::TaskPool& pool) {
+    co_await g8::resumeOn(pool);
+    throw std::runtime_error("failed");
+}
+
+g8::Task<std::string> catching(g8::TaskPool& pool) {
+    try {
+        co_await failing(pool);
+    } catch (const std::runtime_error& error) {
+        co_return error.what();
+    }
+    co_return std::string();
+}
+
+} // namespace
+
+SPEC_BEGIN(CoroutineTests)
+
+describe(@"Coroutine tasks", ^{
+
+    it(@"Should not start a task before it's awaited", ^{
+        bool flag = false;
+        {
+            g8::Task<> task = setFlag(flag);
+        }
+        [[theValue(flag) should] beNo];
+
+        g8::blockingWait(setFlag(flag));
+        [[theValue(flag) should] beYes];
+    });
+
+    it(@"Should resume on a worker of the pool", ^{
+        g8::TaskPool pool(2);
+        size_t worker = g8::blockingWait(workerIndex(pool));
+        [[theValue(worker) should] beLessThan:theValue(pool.threadCount())];
+    });
+
+    it(@"Should continue right away when already on a worker", ^{
+        g8::TaskPool pool(4);
+        [[theValue(g8::blockingWait(staysOnWorker(pool))) should] beYes];
+    });
+
+    it(@"Should pass results through awaited tasks", ^{
+        g8::TaskPool pool(2);
+        [[theValue(g8::blockingWait(answer(pool))) should] equal:theValue(42)];
+        [[theValue(g8::blockingWait(sumOfAnswers(pool))) should] equal:theValue(84)];
+    });
+
+    it(@"Should rethrow exceptions to the awaiter", ^{
+        g8::TaskPool pool(2);
+        [[@(g8::blockingWait(catching(pool)).c_str()) should] equal:@"failed"];
+    });
+
+    it(@"Should rethrow exceptions from blockingWait", ^{
+        g8::TaskPool pool(2);
+        BOOL thrown = NO;
+        try {
+            g8::blockingWait(failing(pool));
+        } catch (const std::runtime_error& error) {
+            thrown = std::string(error.what()) == "failed";
+        }
+        [[theValue(thrown) should] beYes];
+    });
+
+    it(@"Should call the completion of a spawned task on a worker", ^{
+        g8::TaskPool pool(2);
+        auto result = std::make_shared<std::promise<std::pair<int, size_t>>>();
+        std::future<std::pair<int, size_t>> future = result->get_future();
+
+        g8::spawn(answer(pool), [&pool, result](int value) {
+            result->set_value({value, pool.workerIndex()});
+        });
+
+        std::pair<int, size_t> completion = future.get();
+        [[theValue(completion.first) should] equal:theValue(42)];
+        [[theValue(completion.second) should] beLessThan:theValue(pool.threadCount())];
+    });
+
+    it(@"Should keep many tasks in flight on a few threads", ^{
+        g8::TaskPool pool(2);
+        auto sum = std::make_shared<std::atomic<int>>(0);
+        for (int i = 0; i < 1000; ++i) {
+            g8::spawn(sumOfAnswers(pool), [sum](int value) {
+                *sum += value;
+            });
+        }
+        pool.wait();
+
+        [[theValue(sum->load()) should] equal:theValue(84 * 1000)];
+    });
+});
+
+SPEC_END
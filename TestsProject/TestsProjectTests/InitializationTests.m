@@ -658,6 +658,141 @@ describe(@"Tesseract initialization", ^{
         });
     });
     
+    context(@"Initialization with prototype", ^{
+        it(@"Should copy the configuration of the prototype", ^{
+            G8Tesseract *prototype = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            prototype.charWhitelist = @"0123456789";
+            prototype.pageSegmentationMode = G8PageSegmentationModeSingleLine;
+            [prototype setVariableValue:@"1" forKey:kG8ParamMultilangDebugLevel];
+
+            G8Tesseract *clone = [[G8Tesseract alloc] initWithPrototype:prototype];
+            [[theValue(clone.isEngineConfigured) should] beYes];
+            [[clone.language should] equal:prototype.language];
+            [[clone.absoluteDataPath should] equal:prototype.absoluteDataPath];
+            [[clone.charWhitelist should] equal:@"0123456789"];
+            [[theValue(clone.pageSegmentationMode) should] equal:theValue(G8PageSegmentationModeSingleLine)];
+            [[[clone variableValueForKey:kG8ParamMultilangDebugLevel] should] equal:@"1"];
+        });
+
+        it(@"Should copy the recognition settings of the prototype", ^{
+            G8Tesseract *prototype = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            prototype.maximumRecognitionTime = 2.0;
+            prototype.parallelRecognitionMode = G8ParallelRecognitionModeBlocks;
+            prototype.speculativePageSegmentationModes = @[@(G8PageSegmentationModeAuto)];
+            prototype.cascadeLanguage = kG8Languages;
+            prototype.cascadeConfidenceThreshold = 60;
+            NSRegularExpression *expression = [NSRegularExpression regularExpressionWithPattern:@"^\\d+$" options:0 error:nil];
+            prototype.targetFields = @[[[G8FieldTarget alloc] initWithName:@"total"
+                                                         regularExpression:expression
+                                                         minimumConfidence:50]];
+            prototype.progressEventInterval = 0.5;
+
+            G8Tesseract *clone = [[G8Tesseract alloc] initWithPrototype:prototype];
+            [[theValue(clone.maximumRecognitionTime) should] equal:theValue(2.0)];
+            [[theValue(clone.parallelRecognitionMode) should] equal:theValue(G8ParallelRecognitionModeBlocks)];
+            [[clone.speculativePageSegmentationModes should] equal:prototype.speculativePageSegmentationModes];
+            [[clone.cascadeLanguage should] equal:kG8Languages];
+            [[theValue(clone.cascadeConfidenceThreshold) should] equal:theValue(60)];
+            [[clone.targetFields should] equal:prototype.targetFields];
+            [[theValue(clone.progressEventInterval) should] equal:theValue(0.5)];
+            [[clone.cancellationToken shouldNot] equal:prototype.cancellationToken];
+        });
+
+        it(@"Should recognize independently of the prototype", ^{
+            G8Tesseract *prototype = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            G8Tesseract *clone = [[G8Tesseract alloc] initWithPrototype:prototype];
+
+            recognizeSimpleImageWithTesseract(clone);
+            recognizeSimpleImageWithTesseract(prototype);
+        });
+
+        it(@"Should not configure engine if prototype isn't configured", ^{
+            G8Tesseract *prototype = [[G8Tesseract alloc] initWithLanguage:@"rus"];
+            G8Tesseract *clone = [[G8Tesseract alloc] initWithPrototype:prototype];
+            [[theValue(clone.isEngineConfigured) should] beNo];
+        });
+    });
+
+    context(@"Startup profile", ^{
+        beforeEach(^{
+            [G8Tesseract clearCache];
+        });
+
+        it(@"Should break down the initialization", ^{
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            G8StartupProfile *profile = tesseract.startupProfile;
+            [[profile shouldNot] beNil];
+
+            NSArray *names = [profile.phases valueForKey:@"name"];
+            [[names should] equal:@[kG8StartupPhaseRead, kG8StartupPhaseIndex,
+                                    kG8StartupPhaseModel, kG8StartupPhaseVariables]];
+            [[theValue(profile.totalDuration) should] beGreaterThan:theValue(0)];
+            [[theValue(profile.bytesRead) should] beGreaterThan:theValue(0)];
+            [[theValue([profile phaseNamed:kG8StartupPhaseRead].bytes) should] equal:theValue(profile.bytesRead)];
+            [[profile.componentSizes[@"lstm"] shouldNot] beNil];
+        });
+
+        it(@"Should read traineddata from storage by default", ^{
+            G8Tesseract *first = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            G8Tesseract *second = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+
+            [[theValue(G8Tesseract.cachesTrainedData) should] beNo];
+            [[theValue(second.startupProfile.cachedBytes) should] equal:theValue(0)];
+            [[theValue(second.startupProfile.bytesRead) should] equal:theValue(first.startupProfile.bytesRead)];
+        });
+
+        it(@"Should report traineddata served from memory", ^{
+            G8Tesseract.cachesTrainedData = YES;
+            G8Tesseract *first = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            G8Tesseract *second = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            G8Tesseract.cachesTrainedData = NO;
+
+            [[theValue(second.startupProfile.bytesRead) should] equal:theValue(0)];
+            [[theValue(second.startupProfile.cachedBytes) should] equal:theValue(first.startupProfile.bytesRead)];
+        });
+
+        it(@"Should be nil if the engine isn't configured", ^{
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:@"rus"];
+            [[tesseract.startupProfile should] beNil];
+        });
+    });
+
+    context(@"Prewarming", ^{
+        beforeEach(^{
+            [G8Tesseract clearCache];
+        });
+
+        it(@"Should hand a prewarmed engine to a new instance", ^{
+            __block NSNumber *result = nil;
+            [G8Tesseract prewarmLanguages:@[kG8Languages] engineModes:nil completion:^(BOOL success) {
+                result = @(success);
+            }];
+            [[expectFutureValue(result) shouldEventuallyBeforeTimingOutAfter(30.0)] equal:@YES];
+
+            NSUInteger engineCount = 0;
+            for (G8MemoryEntry *entry in G8Tesseract.cachedMemoryEntries) {
+                engineCount += entry.kind == G8MemoryKindEngine;
+            }
+            [[theValue(engineCount) should] equal:theValue(1)];
+
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            [[theValue(tesseract.isEngineConfigured) should] beYes];
+            recognizeSimpleImageWithTesseract(tesseract);
+
+            for (G8MemoryEntry *entry in G8Tesseract.cachedMemoryEntries) {
+                [[theValue(entry.kind) shouldNot] equal:theValue(G8MemoryKindEngine)];
+            }
+        });
+
+        it(@"Should report a failure for missing languages", ^{
+            __block NSNumber *result = nil;
+            [G8Tesseract prewarmLanguages:@[@"rus"] engineModes:nil completion:^(BOOL success) {
+                result = @(success);
+            }];
+            [[expectFutureValue(result) shouldEventuallyBeforeTimingOutAfter(30.0)] equal:@NO];
+        });
+    });
+
     context(@"Reinitialization with wrong language", ^{
         it(@"Should not crach", ^{
             
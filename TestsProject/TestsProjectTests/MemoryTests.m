@@ -0,0 +1,84 @@
+//
+//  MemoryTests.m
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+SPEC_BEGIN(MemoryTests)
+
+describe(@"Memory budget", ^{
+
+    __block NSUInteger defaultBudget = 0;
+
+    beforeEach(^{
+        [G8Tesseract clearCache];
+        defaultBudget = G8Tesseract.memoryBudget;
+        G8Tesseract.memoryBudget = 0;
+        G8Tesseract.cachesTrainedData = YES;
+    });
+
+    afterEach(^{
+        G8Tesseract.cachesTrainedData = NO;
+        G8Tesseract.memoryBudget = defaultBudget;
+    });
+
+    it(@"Should have a default budget", ^{
+        [[theValue(defaultBudget) should] beGreaterThanOrEqualTo:theValue(64 << 20)];
+        [[theValue(defaultBudget) should] beLessThanOrEqualTo:theValue(512 << 20)];
+    });
+
+    it(@"Should track loaded models", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(tesseract.isEngineConfigured) should] beYes];
+
+        [[theValue(G8Tesseract.memoryUsage) should] beGreaterThan:theValue(0)];
+        NSArray *entries = G8Tesseract.cachedMemoryEntries;
+        [[entries shouldNot] beEmpty];
+
+        G8MemoryEntry *entry = entries.firstObject;
+        [[theValue(entry.kind) should] equal:theValue(G8MemoryKindModel)];
+        [[entry.key should] containString:@"traineddata"];
+    });
+
+    it(@"Should evict down to the budget", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(tesseract.isEngineConfigured) should] beYes];
+        NSUInteger usage = G8Tesseract.memoryUsage;
+
+        G8Tesseract.memoryBudget = usage - 1;
+
+        [[theValue(G8Tesseract.memoryUsage) should] beLessThan:theValue(usage)];
+        [[G8Tesseract.evictedMemoryEntries shouldNot] beEmpty];
+    });
+
+    it(@"Should release memory gradually under pressure", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(tesseract.isEngineConfigured) should] beYes];
+        NSUInteger usage = G8Tesseract.memoryUsage;
+
+        [G8Tesseract handleMemoryPressure:G8MemoryPressureLevelModerate];
+        [[theValue(G8Tesseract.memoryUsage) should] beLessThan:theValue(usage)];
+
+        [G8Tesseract handleMemoryPressure:G8MemoryPressureLevelCritical];
+        [[theValue(G8Tesseract.memoryUsage) should] equal:theValue(0)];
+        [[G8Tesseract.cachedMemoryEntries should] beEmpty];
+    });
+
+    it(@"Should keep recognizing after eviction", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [G8Tesseract handleMemoryPressure:G8MemoryPressureLevelCritical];
+
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        [[theValue([tesseract recognize]) should] beYes];
+        [[tesseract.recognizedText shouldNot] beEmpty];
+    });
+});
+
+SPEC_END
@@ -0,0 +1,288 @@
+//
+//  PerformanceTests.m
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+SPEC_BEGIN(PerformanceTests)
+
+/**
+ *  The benchmarks below log their timings instead of asserting on them, since
+ *  absolute numbers depend on the device. They only fail on wrong results.
+ *  TestsProject.xctestplan skips them; run PerformanceTests.xctestplan,
+ *  e.g. with `xcodebuild test -testPlan PerformanceTests`.
+ */
+NSTimeInterval (^measure)(void (^)(void)) = ^NSTimeInterval(void (^block)(void)) {
+    CFTimeInterval start = CACurrentMediaTime();
+    block();
+    return CACurrentMediaTime() - start;
+};
+
+describe(@"Engine startup", ^{
+
+    static NSUInteger const kG8WorkerCount = 8;
+
+    beforeEach(^{
+        [G8Tesseract clearCache];
+    });
+
+    afterEach(^{
+        G8Tesseract.cachesTrainedData = NO;
+    });
+
+    it(@"Should measure cloning against a cold initialization", ^{
+        // Every initialization starts with empty caches, as at first launch
+        NSMutableArray *initialized = [NSMutableArray array];
+        NSTimeInterval initTime = 0;
+        for (NSUInteger i = 0; i < kG8WorkerCount; i++) {
+            [G8Tesseract clearCache];
+            initTime += measure(^{
+                [initialized addObject:[[G8Tesseract alloc] initWithLanguage:kG8Languages]];
+            });
+        }
+
+        [G8Tesseract clearCache];
+        G8Tesseract.cachesTrainedData = YES;
+        G8Tesseract *prototype = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(prototype.isEngineConfigured) should] beYes];
+
+        NSMutableArray *cloned = [NSMutableArray array];
+        NSTimeInterval cloneTime = measure(^{
+            for (NSUInteger i = 0; i < kG8WorkerCount; i++) {
+                [cloned addObject:[[G8Tesseract alloc] initWithPrototype:prototype]];
+            }
+        });
+
+        NSLog(@"Cold init of %lu engines: %.3fs, clone: %.3fs",
+              (unsigned long)kG8WorkerCount, initTime, cloneTime);
+
+        for (G8Tesseract *tesseract in cloned) {
+            [[theValue(tesseract.isEngineConfigured) should] beYes];
+        }
+    });
+
+    it(@"Should measure first recognition cold and prewarmed", ^{
+        UIImage *image = [UIImage imageNamed:@"image_sample.jpg"];
+
+        __block NSString *coldText = nil;
+        NSTimeInterval coldTime = measure(^{
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            tesseract.image = image;
+            [tesseract recognize];
+            coldText = tesseract.recognizedText;
+        });
+
+        [G8Tesseract clearCache];
+        __block BOOL prewarmed = NO;
+        [G8Tesseract prewarmLanguages:@[kG8Languages] engineModes:nil completion:^(BOOL success) {
+            prewarmed = success;
+        }];
+        [[expectFutureValue(theValue(prewarmed)) shouldEventuallyBeforeTimingOutAfter(30.0)] beYes];
+
+        __block NSString *warmText = nil;
+        NSTimeInterval warmTime = measure(^{
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            tesseract.image = image;
+            [tesseract recognize];
+            warmText = tesseract.recognizedText;
+        });
+
+        NSLog(@"First recognition cold: %.3fs, prewarmed: %.3fs", coldTime, warmTime);
+
+        [[warmText should] equal:coldText];
+    });
+});
+
+describe(@"Parallel recognition", ^{
+
+    void (^measureSpeedup)(G8ParallelRecognitionMode, NSString *) = ^(G8ParallelRecognitionMode mode, NSString *name) {
+        UIImage *image = [UIImage imageNamed:@"well_scaned_page"];
+        NSUInteger coreCount = [NSProcessInfo processInfo].activeProcessorCount;
+
+        // Leave an idle engine per thread in the pool, so the timings below
+        // don't include engine initialization
+        G8Tesseract *warmup = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        warmup.parallelRecognitionMode = mode;
+        warmup.image = image;
+        [[theValue([warmup recognize]) should] beYes];
+
+        NSString *serialText = nil;
+        NSTimeInterval serialTime = 0;
+        for (NSUInteger threadCount = 1; threadCount <= coreCount; threadCount++) {
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            tesseract.parallelRecognitionMode = mode;
+            tesseract.maximumConcurrency = threadCount;
+            tesseract.image = image;
+
+            NSTimeInterval time = measure(^{
+                [tesseract recognize];
+            });
+            NSString *text = tesseract.recognizedText;
+
+            if (threadCount == 1) {
+                serialText = text;
+                serialTime = time;
+            }
+            NSLog(@"Parallel recognition by %@ with %lu threads: %.3fs, speedup %.2fx",
+                  name, (unsigned long)threadCount, time, serialTime / time);
+
+            [[text should] equal:serialText];
+        }
+    };
+
+    it(@"Should measure speedup by thread count for paragraphs", ^{
+        measureSpeedup(G8ParallelRecognitionModeParagraphs, @"paragraphs");
+    });
+
+    it(@"Should measure speedup by thread count for text lines", ^{
+        measureSpeedup(G8ParallelRecognitionModeTextlines, @"text lines");
+    });
+});
+
+describe(@"Concurrency governor", ^{
+
+    it(@"Should measure concurrent parallel recognitions by core budget", ^{
+        UIImage *image = [UIImage imageNamed:@"well_scaned_page"];
+        NSUInteger coreCount = [NSProcessInfo processInfo].activeProcessorCount;
+
+        // A budget of one thread per core against one large enough for every
+        // recognition to split its page over all cores
+        for (NSNumber *budget in @[@(coreCount), @(coreCount * coreCount)]) {
+            G8Tesseract.coreBudget = budget.unsignedIntegerValue;
+
+            NSMutableArray *tesseracts = [NSMutableArray arrayWithCapacity:coreCount];
+            for (NSUInteger i = 0; i < coreCount; i++) {
+                G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+                tesseract.parallelRecognitionMode = G8ParallelRecognitionModeParagraphs;
+                tesseract.image = image;
+                [tesseracts addObject:tesseract];
+            }
+
+            NSTimeInterval time = measure(^{
+                dispatch_apply(coreCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+                    [tesseracts[i] recognize];
+                });
+            });
+            NSLog(@"%lu concurrent parallel recognitions with a budget of %@ threads: %.3fs, %.2f pages/s",
+                  (unsigned long)coreCount, budget, time, coreCount / time);
+
+            for (G8Tesseract *tesseract in tesseracts) {
+                [[tesseract.recognizedText should] containString:@"Foreword"];
+            }
+        }
+        G8Tesseract.coreBudget = 0;
+    });
+});
+
+describe(@"Speculative recognition", ^{
+
+    it(@"Should measure racing modes against trying them one after another", ^{
+        UIImage *image = [UIImage imageNamed:@"image_sample.jpg"];
+        NSArray *modes = @[@(G8PageSegmentationModeSingleLine),
+                           @(G8PageSegmentationModeSingleBlock),
+                           @(G8PageSegmentationModeSparseText)];
+
+        // Leave an idle engine per mode in the pool
+        G8Tesseract *warmup = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        warmup.speculativePageSegmentationModes = modes;
+        warmup.speculativeWinningConfidence = 101;
+        warmup.image = image;
+        [[theValue([warmup recognize]) should] beYes];
+
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = image;
+        NSTimeInterval sequentialTime = measure(^{
+            for (NSNumber *mode in modes) {
+                tesseract.pageSegmentationMode = mode.unsignedIntegerValue;
+                [tesseract recognize];
+            }
+        });
+
+        tesseract.speculativePageSegmentationModes = modes;
+        NSTimeInterval speculativeTime = measure(^{
+            [tesseract recognize];
+        });
+
+        NSLog(@"%lu modes one after another: %.3fs, speculatively: %.3fs with mode %lu, speedup %.2fx",
+              (unsigned long)modes.count, sequentialTime, speculativeTime,
+              (unsigned long)tesseract.recognizedPageSegmentationMode, sequentialTime / speculativeTime);
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+    });
+});
+
+describe(@"Batch recognition", ^{
+
+    it(@"Should measure throughput by thread count", ^{
+        UIImage *image = [UIImage imageNamed:@"image_sample.jpg"];
+        NSUInteger coreCount = [NSProcessInfo processInfo].activeProcessorCount;
+        NSUInteger pageCount = 8 * coreCount;
+
+        NSMutableArray *images = [NSMutableArray arrayWithCapacity:pageCount];
+        for (NSUInteger i = 0; i < pageCount; i++) {
+            [images addObject:image];
+        }
+
+        NSTimeInterval serialTime = 0;
+        for (NSUInteger threadCount = 1; threadCount <= coreCount; threadCount++) {
+            G8RecognitionQueue *queue = [[G8RecognitionQueue alloc] initWithLanguage:kG8Languages
+                                                                    configDictionary:nil
+                                                                     configFileNames:nil
+                                                                    absoluteDataPath:nil
+                                                                          engineMode:G8OCREngineModeDefault
+                                                                  maximumConcurrency:threadCount];
+            // Every page is the same image, so each has to be recognized
+            queue.coalescesIdenticalImages = NO;
+            // Bind an engine to every thread before timing
+            [queue recognizeImages:[images subarrayWithRange:NSMakeRange(0, threadCount)]];
+
+            __block NSArray *results = nil;
+            NSTimeInterval time = measure(^{
+                results = [queue recognizeImages:images];
+            });
+
+            if (threadCount == 1) {
+                serialTime = time;
+            }
+            NSLog(@"Batch recognition of %lu pages with %lu threads: %.3fs, %.2f pages/s, scaling %.2fx",
+                  (unsigned long)pageCount, (unsigned long)threadCount, time, pageCount / time, serialTime / time);
+
+            for (G8RecognitionResult *result in results) {
+                [[result.text should] containString:@"1234567890"];
+            }
+        }
+    });
+});
+
+describe(@"PDF pipeline", ^{
+
+    it(@"Should measure stage utilization by pages in flight", ^{
+        UIImage *page = [UIImage imageNamed:@"well_scaned_page"];
+        NSArray *images = @[page, page, page, page, page, page];
+
+        for (NSUInteger pagesInFlight = 1; pagesInFlight <= 4; pagesInFlight++) {
+            G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+            tesseract.maximumPagesInFlight = pagesInFlight;
+
+            __block NSData *pdfData = nil;
+            NSTimeInterval time = measure(^{
+                pdfData = [tesseract recognizedPDFForImages:images];
+            });
+
+            NSLog(@"PDF of %lu pages with %lu pages in flight: %.3fs, %.2f pages/s",
+                  (unsigned long)images.count, (unsigned long)pagesInFlight, time, images.count / time);
+            for (G8PipelineStage *stage in tesseract.pipelineStages) {
+                NSLog(@"    %@", stage);
+            }
+            [[pdfData shouldNot] beNil];
+        }
+    });
+});
+
+SPEC_END
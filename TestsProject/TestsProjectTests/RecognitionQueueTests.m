@@ -0,0 +1,151 @@
+//
+//  RecognitionQueueTests.m
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+SPEC_BEGIN(RecognitionQueueTests)
+
+describe(@"Recognition queue", ^{
+
+    __block G8RecognitionQueue *queue = nil;
+    __block NSArray *images = nil;
+
+    beforeEach(^{
+        queue = [[G8RecognitionQueue alloc] initWithLanguage:kG8Languages
+                                            configDictionary:nil
+                                             configFileNames:nil
+                                            absoluteDataPath:nil
+                                                  engineMode:G8OCREngineModeDefault
+                                          maximumConcurrency:2];
+        images = @[[UIImage imageNamed:@"image_sample.jpg"],
+                   [[NSBundle mainBundle] pathForResource:@"well_scaned_page" ofType:@"png"],
+                   @"/nonexistent/image.png"];
+    });
+
+    afterEach(^{
+        queue = nil;
+    });
+
+    it(@"Should be configured", ^{
+        [[queue shouldNot] beNil];
+        [[theValue(queue.maximumConcurrency) should] equal:theValue(2)];
+    });
+
+    it(@"Should return results in batch order", ^{
+        NSArray *results = [queue recognizeImages:images];
+        [[results should] haveCountOf:3];
+
+        G8RecognitionResult *sample = results[0];
+        [[theValue(sample.index) should] equal:theValue(0)];
+        [[theValue(sample.isRecognized) should] beYes];
+        [[sample.text should] containString:@"1234567890"];
+        [[theValue(sample.confidence) should] beGreaterThan:theValue(0)];
+
+        G8RecognitionResult *page = results[1];
+        [[theValue(page.index) should] equal:theValue(1)];
+        [[theValue(page.isRecognized) should] beYes];
+        [[page.text should] containString:@"Foreword"];
+
+        G8RecognitionResult *missing = results[2];
+        [[theValue(missing.index) should] equal:theValue(2)];
+        [[theValue(missing.isRecognized) should] beNo];
+        [[missing.text should] beNil];
+    });
+
+    it(@"Should match a single engine", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = images[0];
+        [tesseract recognize];
+
+        G8RecognitionResult *result = [queue recognizeImages:@[images[0]]].firstObject;
+        [[result.text should] equal:tesseract.recognizedText];
+    });
+
+    it(@"Should report each image asynchronously", ^{
+        NSMutableIndexSet *reported = [NSMutableIndexSet indexSet];
+        __block NSArray *results = nil;
+
+        [queue recognizeImages:images itemCompletion:^(G8RecognitionResult *result) {
+            [[theValue([NSThread isMainThread]) should] beYes];
+            [reported addIndex:result.index];
+        } completion:^(NSArray *batchResults) {
+            results = batchResults;
+        }];
+
+        [[expectFutureValue(results) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:3];
+        [[theValue(reported.count) should] equal:theValue(3)];
+        [[theValue([results[1] index]) should] equal:theValue(1)];
+    });
+
+    it(@"Should cancel pending batches", ^{
+        __block NSArray *results = nil;
+
+        [queue recognizeImages:images itemCompletion:nil completion:^(NSArray *batchResults) {
+            results = batchResults;
+        }];
+        [queue cancelAllRecognitions];
+
+        [[expectFutureValue(results) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:3];
+        for (G8RecognitionResult *result in results) {
+            [[theValue(result.isRecognized) should] beNo];
+        }
+    });
+
+    it(@"Should recognize batches submitted after cancelling", ^{
+        [queue cancelAllRecognitions];
+
+        NSArray *results = [queue recognizeImages:@[images[0]]];
+        [[theValue([results.firstObject isRecognized]) should] beYes];
+    });
+
+    it(@"Should run overlapping batches", ^{
+        __block NSArray *first = nil;
+        __block NSArray *second = nil;
+
+        [queue recognizeImages:@[images[1], images[0]] itemCompletion:nil completion:^(NSArray *batchResults) {
+            first = batchResults;
+        }];
+        [queue recognizeImages:@[images[0]] itemCompletion:nil completion:^(NSArray *batchResults) {
+            second = batchResults;
+        }];
+
+        [[expectFutureValue(first) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:2];
+        [[expectFutureValue(second) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:1];
+        [[[first[1] text] should] containString:@"1234567890"];
+        [[[second[0] text] should] containString:@"1234567890"];
+    });
+
+    it(@"Should coalesce identical images in flight", ^{
+        [[theValue(queue.coalescesIdenticalImages) should] beYes];
+        NSArray *duplicates = @[images[1], images[1], images[1], images[1]];
+
+        NSArray *results = [queue recognizeImages:duplicates];
+        [[results should] haveCountOf:4];
+        [[theValue(queue.coalescedRequestCount) should] beGreaterThan:theValue(0)];
+        for (NSUInteger i = 0; i < results.count; i++) {
+            G8RecognitionResult *result = results[i];
+            [[theValue(result.index) should] equal:theValue(i)];
+            [[result.text should] equal:[results[0] text]];
+        }
+    });
+
+    it(@"Should recognize every image when not coalescing", ^{
+        queue.coalescesIdenticalImages = NO;
+
+        NSArray *results = [queue recognizeImages:@[images[0], images[0], images[0]]];
+        [[theValue(queue.coalescedRequestCount) should] equal:theValue(0)];
+        for (G8RecognitionResult *result in results) {
+            [[result.text should] containString:@"1234567890"];
+        }
+    });
+});
+
+SPEC_END
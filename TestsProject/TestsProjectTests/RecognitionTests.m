@@ -16,6 +16,40 @@
 #import "NSData+G8Equal.h"
 #import "Defaults.h"
 
+/**
+ *  Delegate that asks to cancel every recognition.
+ */
+@interface G8CancellingDelegate : NSObject <G8TesseractDelegate>
+@end
+
+@implementation G8CancellingDelegate
+
+- (BOOL)shouldCancelImageRecognitionForTesseract:(G8Tesseract *)tesseract
+{
+    return YES;
+}
+
+@end
+
+/**
+ *  Delegate that records the progress it is told about.
+ */
+@interface G8ProgressRecordingDelegate : NSObject <G8TesseractDelegate>
+@property (nonatomic, strong) NSMutableArray *reportedProgress;
+@end
+
+@implementation G8ProgressRecordingDelegate
+
+- (void)progressImageRecognitionForTesseract:(G8Tesseract *)tesseract
+{
+    if (self.reportedProgress == nil) {
+        self.reportedProgress = [NSMutableArray array];
+    }
+    [self.reportedProgress addObject:@(tesseract.progress)];
+}
+
+@end
+
 SPEC_BEGIN(RecognitionTests)
 
 void (^testImageWithOrientationShouldContainText)() = ^(UIImage *image, UIImageOrientation orientation, NSString *text) {
@@ -308,6 +342,503 @@ describe(@"Well scaned page", ^{
     });
 });
 
+#pragma mark - Test - Parallel recognition
+
+describe(@"Parallel recognition", ^{
+
+    G8Tesseract *(^recognizeWellScanedPage)(G8ParallelRecognitionMode) = ^G8Tesseract *(G8ParallelRecognitionMode mode) {
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.parallelRecognitionMode = mode;
+        if (mode == G8ParallelRecognitionModeBlocks) {
+            // A single block page can't be split into blocks
+            tesseract.pageSegmentationMode = G8PageSegmentationModeAuto;
+        }
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        [[theValue([tesseract recognize]) should] beYes];
+        return tesseract;
+    };
+
+    beforeAll(^{
+        [G8Tesseract clearCache];
+    });
+
+    it(@"Should recognize by blocks", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeBlocks);
+
+        [[theValue(tesseract.progress) should] equal:theValue(100)];
+
+        NSString *recognizedText = tesseract.recognizedText;
+        [[recognizedText should] containString:@"Foreword"];
+        [[recognizedText should] containString:@"Division"];
+        [[recognizedText should] containString:@"1954"];
+    });
+
+    it(@"Should recognize by paragraphs", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeParagraphs);
+
+        NSString *recognizedText = tesseract.recognizedText;
+        [[recognizedText should] containString:@"Foreword"];
+        [[recognizedText should] containString:@"recommendations sometimes get acted on"];
+
+        NSArray *blocks = [tesseract recognizedHierarchicalBlocksByIteratorLevel:G8PageIteratorLevelBlock];
+        [[[blocks should] haveAtLeast:1] items];
+        G8HierarchicalRecognizedBlock *block = blocks.firstObject;
+        [[[block.childBlocks should] haveAtLeast:6] items];
+    });
+
+    it(@"Should recognize by text lines", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeTextlines);
+
+        NSString *recognizedText = tesseract.recognizedText;
+        [[recognizedText should] containString:@"Foreword"];
+        [[recognizedText should] containString:@"Division"];
+        [[recognizedText should] containString:@"1954"];
+
+        NSArray *blocks = [tesseract recognizedHierarchicalBlocksByIteratorLevel:G8PageIteratorLevelBlock];
+        [[[blocks should] haveAtLeast:1] items];
+        G8HierarchicalRecognizedBlock *block = blocks.firstObject;
+        [[theValue(block.level) should] equal:theValue(G8PageIteratorLevelBlock)];
+
+        NSArray *paras = block.childBlocks;
+        [[[paras should] haveAtLeast:6] items];
+        G8HierarchicalRecognizedBlock *para = paras.firstObject;
+        [[theValue(para.level) should] equal:theValue(G8PageIteratorLevelParagraph)];
+
+        G8HierarchicalRecognizedBlock *line = para.childBlocks.firstObject;
+        [[theValue(line.level) should] equal:theValue(G8PageIteratorLevelTextline)];
+        [[theValue(CGRectContainsRect(para.boundingBox, line.boundingBox)) should] beYes];
+
+        G8HierarchicalRecognizedBlock *word = line.childBlocks.firstObject;
+        [[theValue(word.level) should] equal:theValue(G8PageIteratorLevelWord)];
+    });
+
+    it(@"Should end every paragraph with an empty line", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeTextlines);
+
+        NSString *recognizedText = tesseract.recognizedText;
+        NSArray *paragraphs = [tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelParagraph];
+        NSUInteger separatorCount = [recognizedText componentsSeparatedByString:@"\n\n"].count - 1;
+        [[theValue(separatorCount) should] equal:theValue(paragraphs.count)];
+        [[theValue([recognizedText hasSuffix:@"\n\n"]) should] beYes];
+
+        for (G8RecognizedBlock *paragraph in paragraphs) {
+            [[theValue([paragraph.text hasSuffix:@"\n\n"]) should] beYes];
+        }
+    });
+
+    it(@"Should return blocks in page coordinates and reading order", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeParagraphs);
+
+        NSArray *lines = [tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelTextline];
+        [[[lines should] haveAtLeast:10] items];
+
+        CGRect page = CGRectMake(0, 0, 1, 1);
+        CGFloat previousTop = -1;
+        for (G8RecognizedBlock *line in lines) {
+            [[theValue(CGRectContainsRect(page, line.boundingBox)) should] beYes];
+            [[theValue(CGRectGetMinY(line.boundingBox)) should] beGreaterThanOrEqualTo:theValue(previousTop)];
+            previousTop = CGRectGetMinY(line.boundingBox);
+        }
+
+        [[[tesseract.characterChoices should] haveAtLeast:100] items];
+    });
+
+    it(@"Should make hOCR from the merged results", ^{
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeTextlines);
+
+        NSString *hOCR = [tesseract recognizedHOCRForPageNumber:0];
+        [[hOCR should] containString:@"class='ocr_page' id='page_1'"];
+        [[hOCR should] containString:@"Foreword"];
+
+        NSUInteger wordCount = [hOCR componentsSeparatedByString:@"class='ocrx_word'"].count - 1;
+        NSArray *words = [tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelWord];
+        [[theValue(wordCount) should] equal:theValue(words.count)];
+    });
+
+    it(@"Should recognize on a single thread when the core budget is taken", ^{
+        G8Tesseract.coreBudget = 1;
+        G8Tesseract *tesseract = recognizeWellScanedPage(G8ParallelRecognitionModeParagraphs);
+        G8Tesseract.coreBudget = 0;
+
+        [[theValue(G8Tesseract.coreUsage) should] equal:theValue(0)];
+        [[theValue(G8Tesseract.coreBudget) should] beGreaterThan:theValue(0)];
+
+        [[tesseract.recognizedText should] containString:@"Foreword"];
+        [[tesseract.recognizedText should] containString:@"Division"];
+        [[tesseract.recognizedText should] containString:@"1954"];
+    });
+});
+
+#pragma mark - Test - Speculative recognition
+
+describe(@"Speculative recognition", ^{
+
+    __block G8Tesseract *tesseract = nil;
+    NSArray *modes = @[@(G8PageSegmentationModeSingleLine),
+                       @(G8PageSegmentationModeSingleBlock),
+                       @(G8PageSegmentationModeSparseText)];
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        tesseract.speculativePageSegmentationModes = modes;
+    });
+
+    it(@"Should recognize with the most confident mode", ^{
+        tesseract.speculativeWinningConfidence = 101;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+        [[modes should] contain:@(tesseract.recognizedPageSegmentationMode)];
+        [[[[tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelWord] should] haveAtLeast:1] items];
+        [[theValue(tesseract.progress) should] equal:theValue(100)];
+    });
+
+    it(@"Should stop at the first confident mode", ^{
+        tesseract.speculativeWinningConfidence = 0;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+        [[modes should] contain:@(tesseract.recognizedPageSegmentationMode)];
+    });
+
+    it(@"Should report the page segmentation mode without speculation", ^{
+        tesseract.speculativePageSegmentationModes = nil;
+        tesseract.pageSegmentationMode = G8PageSegmentationModeSingleLine;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.recognizedPageSegmentationMode) should] equal:theValue(G8PageSegmentationModeSingleLine)];
+    });
+
+    it(@"Should not recognize with a cancelled token", ^{
+        [tesseract.cancellationToken cancel];
+        [[theValue([tesseract recognize]) should] beNo];
+    });
+});
+
+#pragma mark - Test - Cascade recognition
+
+describe(@"Cascade recognition", ^{
+
+    __block G8Tesseract *tesseract = nil;
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        tesseract.cascadeLanguage = kG8Languages;
+    });
+
+    it(@"Should keep confident words", ^{
+        tesseract.cascadeConfidenceThreshold = 0;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+        [[theValue(tesseract.cascadeRefinedCount) should] equal:theValue(0)];
+        [[theValue(tesseract.cascadeReplacedCount) should] equal:theValue(0)];
+    });
+
+    it(@"Should refine words below the threshold", ^{
+        tesseract.cascadeConfidenceThreshold = 100;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        NSArray *words = [tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelWord];
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+        [[[words should] haveAtLeast:1] items];
+
+        [[theValue(tesseract.cascadeRefinedCount) should] beGreaterThan:theValue(0)];
+        [[theValue(tesseract.cascadeReplacedCount) should] beLessThanOrEqualTo:theValue(tesseract.cascadeRefinedCount)];
+    });
+
+    it(@"Should refine lines below the threshold", ^{
+        tesseract.cascadeConfidenceThreshold = 100;
+        tesseract.cascadeLevel = G8PageIteratorLevelTextline;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+        [[theValue(tesseract.cascadeRefinedCount) should] beGreaterThan:theValue(0)];
+    });
+
+    it(@"Should not refine once the time ran out", ^{
+        // A millisecond runs out during layout analysis on any device
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        tesseract.cascadeConfidenceThreshold = 100;
+        tesseract.maximumRecognitionTime = 0.001;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.partialResult) should] beYes];
+        [[theValue(tesseract.cascadeRefinedCount) should] equal:theValue(0)];
+        [[theValue(tesseract.cascadeReplacedCount) should] equal:theValue(0)];
+    });
+});
+
+#pragma mark - Test - Target fields
+
+describe(@"Target fields", ^{
+
+    __block G8Tesseract *tesseract = nil;
+
+    G8FieldTarget *(^target)(NSString *, NSString *) = ^G8FieldTarget *(NSString *name, NSString *pattern) {
+        NSRegularExpression *expression = [NSRegularExpression regularExpressionWithPattern:pattern options:0 error:nil];
+        return [[G8FieldTarget alloc] initWithName:name regularExpression:expression minimumConfidence:0];
+    };
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+    });
+
+    it(@"Should find a field", ^{
+        tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        tesseract.targetFields = @[target(@"number", @"^\\d{10}$")];
+        [[theValue([tesseract recognize]) should] beYes];
+
+        G8RecognizedBlock *field = tesseract.recognizedFields[@"number"];
+        [[field.text should] equal:@"1234567890"];
+        [[theValue(CGRectIsEmpty(field.boundingBox)) should] beNo];
+    });
+
+    it(@"Should stop once every field is found", ^{
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        tesseract.targetFields = @[target(@"heading", @"^Foreword$")];
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.finishedEarly) should] beYes];
+        [[tesseract.recognizedFields[@"heading"] shouldNot] beNil];
+        [[tesseract.recognizedText should] containString:@"Foreword"];
+    });
+
+    it(@"Should recognize the whole page if a field is missing", ^{
+        tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        tesseract.targetFields = @[target(@"number", @"^\\d{10}$"), target(@"missing", @"^nowhere$")];
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.finishedEarly) should] beNo];
+        [[tesseract.recognizedFields[@"missing"] should] beNil];
+        [[tesseract.recognizedFields[@"number"] shouldNot] beNil];
+    });
+});
+
+#pragma mark - Test - Anytime recognition
+
+describe(@"Anytime recognition", ^{
+
+    __block G8Tesseract *tesseract = nil;
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.pageSegmentationMode = G8PageSegmentationModeAuto;
+    });
+
+    it(@"Should cover the whole page in time", ^{
+        tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        tesseract.maximumRecognitionTime = 60.0;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.partialResult) should] beNo];
+        [[theValue(tesseract.regionCount) should] equal:theValue(0)];
+        [[theValue(tesseract.recognizedRegionCount) should] equal:theValue(tesseract.regionCount)];
+        [[theValue(tesseract.recognizedCoverage) should] equal:theValue(1.0)];
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+    });
+
+    it(@"Should return the regions done when the time runs out", ^{
+        // Layout analysis alone outlasts a millisecond, so the limit is hit
+        // before the first line is done on any device
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        tesseract.maximumRecognitionTime = 0.001;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[theValue(tesseract.partialResult) should] beYes];
+        [[theValue(tesseract.regionCount) should] beGreaterThan:theValue(0)];
+        [[theValue(tesseract.recognizedRegionCount) should] beLessThan:theValue(tesseract.regionCount)];
+        [[theValue(tesseract.recognizedCoverage) should] beLessThan:theValue(1.0)];
+
+        NSArray *words = [tesseract recognizedBlocksByIteratorLevel:G8PageIteratorLevelWord];
+        for (G8RecognizedBlock *word in words) {
+            [[theValue(word.text.length) should] beGreaterThan:theValue(0)];
+            [[theValue(CGRectIsEmpty(word.boundingBox)) should] beNo];
+        }
+    });
+
+    it(@"Should keep reading order whatever the priority", ^{
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        tesseract.maximumRecognitionTime = 60.0;
+        tesseract.regionPriority = G8RegionPriorityLargestFirst;
+        [[theValue([tesseract recognize]) should] beYes];
+
+        NSString *text = tesseract.recognizedText;
+        NSRange first = [text rangeOfString:@"Foreword"];
+        NSRange last = [text rangeOfString:@"recommendations sometimes get acted on"];
+        [[theValue(first.location) shouldNot] equal:theValue(NSNotFound)];
+        [[theValue(last.location) shouldNot] equal:theValue(NSNotFound)];
+        [[theValue(first.location) should] beLessThan:theValue(last.location)];
+    });
+});
+
+#pragma mark - Test - Cancellation
+
+describe(@"Cancellation", ^{
+
+    __block G8Tesseract *tesseract = nil;
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+    });
+
+    it(@"Should give every instance its own token", ^{
+        G8Tesseract *other = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[tesseract.cancellationToken shouldNot] beNil];
+        [[tesseract.cancellationToken shouldNot] equal:other.cancellationToken];
+
+        tesseract.cancellationToken = nil;
+        [[tesseract.cancellationToken shouldNot] beNil];
+    });
+
+    it(@"Should not recognize with a cancelled token", ^{
+        [tesseract.cancellationToken cancel];
+        [[theValue(tesseract.cancellationToken.isCancelled) should] beYes];
+        [[theValue([tesseract recognize]) should] beNo];
+
+        tesseract.cancellationToken = [[G8CancellationToken alloc] init];
+        [[theValue([tesseract recognize]) should] beYes];
+    });
+
+    it(@"Should cancel a running recognition from another thread", ^{
+        G8CancellationToken *token = [[G8CancellationToken alloc] init];
+        tesseract.cancellationToken = token;
+
+        __block NSNumber *recognized = nil;
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            BOOL result = [tesseract recognize];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                recognized = @(result);
+            });
+        });
+        [[expectFutureValue(theValue(tesseract.progress)) shouldEventuallyBeforeTimingOutAfter(30.0)] beGreaterThan:theValue(0)];
+        [token cancel];
+
+        [[expectFutureValue(recognized) shouldEventuallyBeforeTimingOutAfter(30.0)] equal:@NO];
+        [[theValue(tesseract.progress) should] beLessThan:theValue(100)];
+    });
+
+    it(@"Should cancel every instance sharing a token", ^{
+        G8CancellationToken *token = [[G8CancellationToken alloc] init];
+        G8Tesseract *parallel = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        parallel.image = [UIImage imageNamed:@"well_scaned_page"];
+        parallel.parallelRecognitionMode = G8ParallelRecognitionModeTextlines;
+        tesseract.cancellationToken = token;
+        parallel.cancellationToken = token;
+
+        [token cancel];
+        [[theValue([tesseract recognize]) should] beNo];
+        [[theValue([parallel recognize]) should] beNo];
+    });
+
+    it(@"Should still ask a delegate that implements it", ^{
+        G8CancellingDelegate *delegate = [[G8CancellingDelegate alloc] init];
+        tesseract.delegate = delegate;
+
+        [[theValue([tesseract recognize]) should] beNo];
+    });
+
+    it(@"Should report progress once per percent", ^{
+        G8ProgressRecordingDelegate *delegate = [[G8ProgressRecordingDelegate alloc] init];
+        tesseract.delegate = delegate;
+
+        [[theValue([tesseract recognize]) should] beYes];
+        NSArray *reported = delegate.reportedProgress;
+        [[reported shouldNot] beEmpty];
+        for (NSUInteger i = 1; i < reported.count; i++) {
+            [[reported[i] should] beGreaterThan:reported[i - 1]];
+        }
+    });
+});
+
+#pragma mark - Test - Progress events
+
+describe(@"Progress events", ^{
+
+    __block G8Tesseract *tesseract = nil;
+    __block NSMutableArray *events = nil;
+
+    beforeEach(^{
+        tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+        events = [NSMutableArray array];
+    });
+
+    it(@"Should deliver sampled events and a last one", ^{
+        tesseract.progressEventInterval = 0.05;
+        tesseract.progressEventBlock = ^(G8ProgressEvent *event) {
+            [[theValue([NSThread isMainThread]) should] beYes];
+            [events addObject:event];
+        };
+
+        dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            [tesseract recognize];
+        });
+        [[expectFutureValue(theValue([[events lastObject] isFinished])) shouldEventuallyBeforeTimingOutAfter(30.0)] beYes];
+
+        G8ProgressEvent *last = events.lastObject;
+        [[theValue(last.isCompleted) should] beYes];
+        [[theValue(last.progress) should] equal:theValue(100)];
+        [[theValue(last.wordCount) should] beGreaterThan:theValue(0)];
+        [[theValue(last.wordsPerSecond) should] beGreaterThan:theValue(0)];
+
+        // Far fewer events than words, in increasing order
+        [[theValue(events.count) should] beLessThan:theValue(last.wordCount)];
+        for (NSUInteger i = 1; i < events.count; i++) {
+            [[theValue([events[i] progress]) should] beGreaterThanOrEqualTo:theValue([events[i - 1] progress])];
+        }
+    });
+
+    it(@"Should deliver events on the chosen queue", ^{
+        dispatch_queue_t queue = dispatch_queue_create("com.g8production.tests.progress", DISPATCH_QUEUE_SERIAL);
+        __block BOOL onQueue = NO;
+        __block G8ProgressEvent *last = nil;
+        static void *kQueueKey = &kQueueKey;
+        dispatch_queue_set_specific(queue, kQueueKey, kQueueKey, NULL);
+
+        tesseract.progressEventQueue = queue;
+        tesseract.progressEventBlock = ^(G8ProgressEvent *event) {
+            onQueue = dispatch_get_specific(kQueueKey) == kQueueKey;
+            last = event;
+        };
+        [[theValue([tesseract recognize]) should] beYes];
+
+        [[expectFutureValue(theValue(last.isFinished)) shouldEventuallyBeforeTimingOutAfter(5.0)] beYes];
+        [[theValue(onQueue) should] beYes];
+
+        tesseract.progressEventQueue = nil;
+        [[tesseract.progressEventQueue should] equal:dispatch_get_main_queue()];
+    });
+
+    it(@"Should be set up by recognition operations", ^{
+        G8RecognitionOperation *operation = [[G8RecognitionOperation alloc] initWithLanguage:kG8Languages];
+        operation.tesseract.image = [UIImage imageNamed:@"image_sample.jpg"];
+        operation.progressEventBlock = ^(G8ProgressEvent *event) {
+            [events addObject:event];
+        };
+        [[(id)operation.tesseract.progressEventBlock shouldNot] beNil];
+
+        [[[NSOperationQueue alloc] init] addOperation:operation];
+        [[expectFutureValue(theValue([[events lastObject] isFinished])) shouldEventuallyBeforeTimingOutAfter(30.0)] beYes];
+    });
+
+    it(@"Should report unfinished recognitions", ^{
+        [tesseract.cancellationToken cancel];
+        tesseract.progressEventBlock = ^(G8ProgressEvent *event) {
+            [events addObject:event];
+        };
+        [[theValue([tesseract recognize]) should] beNo];
+
+        [[expectFutureValue(events) shouldEventuallyBeforeTimingOutAfter(5.0)] haveCountOf:1];
+        G8ProgressEvent *last = events.lastObject;
+        [[theValue(last.isFinished) should] beYes];
+        [[theValue(last.isCompleted) should] beNo];
+    });
+});
+
 #pragma mark - hierarchical data
 
 describe(@"Hierarchical Data", ^{
@@ -473,6 +1004,27 @@ describe(@"PDF", ^{
             [[theValue([recognizedPDFForImages(@[@"someStringAsImage.png"]) g8_isEqualToData:samplePDFDataFromFile(@"empty")]) should] beYes];
         });
     });
+
+    it(@"Should report the pipeline stages", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:@"eng"];
+        tesseract.maximumPagesInFlight = 2;
+        [[tesseract.pipelineStages should] beNil];
+
+        UIImage *image = [UIImage imageNamed:@"image_sample.jpg"];
+        NSData *pdfData = [tesseract recognizedPDFForImages:@[image, @"someStringAsImage.png", image, image]];
+        [[pdfData shouldNot] beNil];
+
+        NSArray *stages = tesseract.pipelineStages;
+        [[stages should] haveCountOf:3];
+        [[[stages[0] name] should] equal:kG8PipelineStageDecode];
+        [[[stages[1] name] should] equal:kG8PipelineStagePreprocess];
+        [[[stages[2] name] should] equal:kG8PipelineStageRecognize];
+        for (G8PipelineStage *stage in stages) {
+            [[theValue(stage.pageCount) should] equal:theValue(3)];
+            [[theValue(stage.utilization) should] beGreaterThan:theValue(0)];
+            [[theValue(stage.utilization) should] beLessThanOrEqualTo:theValue(1)];
+        }
+    });
 });
 
 SPEC_END
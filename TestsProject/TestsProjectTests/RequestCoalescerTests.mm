@@ -0,0 +1,80 @@
+//
+//  RequestCoalescerTests.mm
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <Kiwi/Kiwi.h>
+
+// Internal to the framework, not one of its public headers
+#import "../../TesseractOCR/G8PixWrapper.h"
+#import "../../TesseractOCR/G8RequestCoalescer.h"
+
+#include <memory>
+#include <string>
+
+// Leptonica's headers aren't public either; the specs only need this one
+extern "C" Pix *pixRead(const char *filename);
+
+SPEC_BEGIN(RequestCoalescerTests)
+
+describe(@"Request coalescer", ^{
+
+    // The coalescer only sees keys, so a shared key stands in for a hash collision
+    std::string const key = "key";
+
+    Pix *(^readImage)(NSString *) = ^Pix *(NSString *name) {
+        return pixRead([[NSBundle mainBundle] pathForResource:name ofType:@"jpg"].fileSystemRepresentation);
+    };
+
+    it(@"Should let a request for an equal image follow the leader", ^{
+        g8::PixWrapper leader(readImage(@"image_sample"));
+        g8::PixWrapper follower(readImage(@"image_sample"));
+        g8::RequestCoalescer coalescer;
+        auto received = std::make_shared<g8::RecognitionOutput>();
+
+        [[theValue(coalescer.join(key, leader.get(), nullptr)) should] beNo];
+        bool follows = coalescer.join(key, follower.get(), [received](g8::RecognitionOutput output) {
+            *received = output;
+        });
+        [[theValue(follows) should] beYes];
+
+        g8::RecognitionOutput output;
+        output.recognized = true;
+        output.text = "1234567890";
+        coalescer.finish(key, leader.get(), output);
+
+        [[theValue(received->recognized) should] beYes];
+        [[theValue(received->coalesced) should] beYes];
+        [[@(received->text.c_str()) should] equal:@"1234567890"];
+        [[theValue(coalescer.statistics().coalesced) should] equal:theValue(1)];
+        [[theValue(coalescer.statistics().inFlight) should] equal:theValue(0)];
+    });
+
+    it(@"Should not join a leader with a different image under the same key", ^{
+        g8::PixWrapper first(readImage(@"image_sample"));
+        g8::PixWrapper second(readImage(@"image_sample_down"));
+        g8::RequestCoalescer coalescer;
+        auto calls = std::make_shared<int>(0);
+
+        [[theValue(coalescer.join(key, first.get(), nullptr)) should] beNo];
+        [[theValue(coalescer.join(key, second.get(), nullptr)) should] beNo];
+        [[theValue(coalescer.statistics().inFlight) should] equal:theValue(2)];
+
+        bool follows = coalescer.join(key, second.get(), [calls](g8::RecognitionOutput) {
+            ++*calls;
+        });
+        [[theValue(follows) should] beYes];
+        coalescer.finish(key, first.get(), g8::RecognitionOutput());
+        [[theValue(*calls) should] equal:theValue(0)];
+        coalescer.finish(key, second.get(), g8::RecognitionOutput());
+        [[theValue(*calls) should] equal:theValue(1)];
+
+        [[theValue(coalescer.statistics().coalesced) should] equal:theValue(1)];
+        [[theValue(coalescer.statistics().inFlight) should] equal:theValue(0)];
+    });
+});
+
+SPEC_END
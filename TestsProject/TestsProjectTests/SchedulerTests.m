@@ -0,0 +1,202 @@
+//
+//  SchedulerTests.m
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+SPEC_BEGIN(SchedulerTests)
+
+describe(@"Recognition scheduler", ^{
+
+    __block G8RecognitionScheduler *scheduler = nil;
+
+    G8Tesseract *(^tesseractWithImage)(NSString *) = ^G8Tesseract *(NSString *imageName) {
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        tesseract.image = [UIImage imageNamed:imageName];
+        return tesseract;
+    };
+
+    beforeEach(^{
+        scheduler = [[G8RecognitionScheduler alloc] initWithMaximumConcurrency:1];
+    });
+
+    afterEach(^{
+        scheduler = nil;
+    });
+
+    it(@"Should recognize scheduled images", ^{
+        G8Tesseract *tesseract = tesseractWithImage(@"image_sample.jpg");
+        __block NSNumber *outcome = nil;
+
+        BOOL scheduled = [scheduler scheduleRecognitionForTesseract:tesseract
+                                                           priority:G8RecognitionPriorityDefault
+                                                           deadline:nil
+                                                     overloadPolicy:G8OverloadPolicyReject
+                                                         completion:^(G8Tesseract *tesseract, G8SchedulingOutcome result) {
+            outcome = @(result);
+        }];
+        [[theValue(scheduled) should] beYes];
+
+        [[expectFutureValue(outcome) shouldEventuallyBeforeTimingOutAfter(30.0)] equal:@(G8SchedulingOutcomeCompleted)];
+        [[tesseract.recognizedText should] containString:@"1234567890"];
+
+        G8SchedulerMetrics *metrics = [scheduler metricsForPriority:G8RecognitionPriorityDefault];
+        [[theValue(metrics.completedCount) should] equal:theValue(1)];
+        [[theValue(metrics.queueDepth) should] equal:theValue(0)];
+        [[theValue(metrics.estimatedRecognitionTime) should] beGreaterThan:theValue(0)];
+    });
+
+    it(@"Should run interactive recognitions before background ones", ^{
+        NSMutableArray *order = [NSMutableArray array];
+        void (^schedule)(NSString *, G8Tesseract *, G8RecognitionPriority) = ^(NSString *name, G8Tesseract *tesseract, G8RecognitionPriority priority) {
+            [scheduler scheduleRecognitionForTesseract:tesseract
+                                              priority:priority
+                                              deadline:nil
+                                        overloadPolicy:G8OverloadPolicyReject
+                                            completion:^(G8Tesseract *tesseract, G8SchedulingOutcome outcome) {
+                [order addObject:name];
+            }];
+        };
+        G8Tesseract *background = tesseractWithImage(@"image_sample.jpg");
+        G8Tesseract *interactive = tesseractWithImage(@"image_sample.jpg");
+
+        // The first one occupies the only thread while the others queue up
+        schedule(@"first", tesseractWithImage(@"well_scaned_page"), G8RecognitionPriorityBackground);
+        [[expectFutureValue(theValue([scheduler metricsForPriority:G8RecognitionPriorityBackground].queueDepth))
+          shouldEventually] equal:theValue(0)];
+        schedule(@"background", background, G8RecognitionPriorityBackground);
+        schedule(@"interactive", interactive, G8RecognitionPriorityInteractive);
+
+        [[expectFutureValue(order) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:3];
+        [[order should] equal:@[@"first", @"interactive", @"background"]];
+
+        G8SchedulerMetrics *metrics = [scheduler metricsForPriority:G8RecognitionPriorityBackground];
+        [[theValue(metrics.completedCount) should] equal:theValue(2)];
+        [[theValue(metrics.maximumWaitTime) should] beGreaterThan:theValue(0)];
+    });
+
+    it(@"Should run earlier deadlines first", ^{
+        NSMutableArray *order = [NSMutableArray array];
+        NSMutableArray *tesseracts = [NSMutableArray array];
+        [tesseracts addObject:tesseractWithImage(@"well_scaned_page")];
+        for (NSUInteger i = 0; i < 3; i++) {
+            [tesseracts addObject:tesseractWithImage(@"image_sample.jpg")];
+        }
+        void (^schedule)(NSString *, NSTimeInterval) = ^(NSString *name, NSTimeInterval timeout) {
+            G8Tesseract *next = tesseracts.firstObject;
+            [tesseracts removeObjectAtIndex:0];
+            [scheduler scheduleRecognitionForTesseract:next
+                                              priority:G8RecognitionPriorityDefault
+                                              deadline:timeout > 0 ? [NSDate dateWithTimeIntervalSinceNow:timeout] : nil
+                                        overloadPolicy:G8OverloadPolicyReject
+                                            completion:^(G8Tesseract *tesseract, G8SchedulingOutcome outcome) {
+                [order addObject:name];
+            }];
+        };
+
+        schedule(@"first", 0);
+        [[expectFutureValue(theValue([scheduler metricsForPriority:G8RecognitionPriorityDefault].queueDepth))
+          shouldEventually] equal:theValue(0)];
+        schedule(@"none", 0);
+        schedule(@"late", 120);
+        schedule(@"early", 60);
+
+        [[expectFutureValue(order) shouldEventuallyBeforeTimingOutAfter(30.0)] haveCountOf:4];
+        [[order should] equal:@[@"first", @"early", @"late", @"none"]];
+    });
+
+    it(@"Should reject recognitions past their deadline", ^{
+        __block NSNumber *outcome = nil;
+        BOOL scheduled = [scheduler scheduleRecognitionForTesseract:tesseractWithImage(@"image_sample.jpg")
+                                                           priority:G8RecognitionPriorityInteractive
+                                                           deadline:[NSDate dateWithTimeIntervalSinceNow:-1]
+                                                     overloadPolicy:G8OverloadPolicyDegrade
+                                                         completion:^(G8Tesseract *tesseract, G8SchedulingOutcome result) {
+            outcome = @(result);
+        }];
+        [[theValue(scheduled) should] beNo];
+
+        [[expectFutureValue(outcome) shouldEventuallyBeforeTimingOutAfter(5.0)] equal:@(G8SchedulingOutcomeRejected)];
+        [[theValue([scheduler metricsForPriority:G8RecognitionPriorityInteractive].rejectedCount) should] equal:theValue(1)];
+    });
+
+    it(@"Should step down to cheaper quality tiers while recognitions wait", ^{
+        G8QualityTier *fast = [[G8QualityTier alloc] initWithLanguage:nil
+                                                  pageSegmentationMode:@(G8PageSegmentationModeSingleBlock)
+                                                            imageScale:0.75];
+        [[theValue(fast.isFullQuality) should] beNo];
+        scheduler.qualityTiers = @[[[G8QualityTier alloc] init], fast];
+        scheduler.qualityStepDownWaitTime = 0;
+        scheduler.qualityStepInterval = 0;
+
+        NSMutableArray *tesseracts = [NSMutableArray array];
+        for (NSUInteger i = 0; i < 3; i++) {
+            G8Tesseract *tesseract = tesseractWithImage(@"image_sample.jpg");
+            [tesseracts addObject:tesseract];
+            [scheduler scheduleRecognitionForTesseract:tesseract
+                                              priority:G8RecognitionPriorityDefault
+                                              deadline:nil
+                                        overloadPolicy:G8OverloadPolicyReject
+                                            completion:nil];
+        }
+        [scheduler waitUntilAllRecognitionsAreFinished];
+
+        // The later ones waited behind the first
+        G8Tesseract *last = tesseracts.lastObject;
+        [[theValue(last.recognizedQualityTier) should] equal:theValue(1)];
+        [[theValue(last.recognizedPageSegmentationMode) should] equal:theValue(G8PageSegmentationModeSingleBlock)];
+        [[theValue(last.recognizedText.length) should] beGreaterThan:theValue(0)];
+        [[theValue(scheduler.currentQualityTier) should] equal:theValue(1)];
+        [[theValue([scheduler metricsForPriority:G8RecognitionPriorityDefault].reducedQualityCount) should] beGreaterThan:theValue(0)];
+    });
+
+    context(@"with a known recognition time", ^{
+
+        beforeEach(^{
+            [scheduler scheduleRecognitionForTesseract:tesseractWithImage(@"well_scaned_page")
+                                              priority:G8RecognitionPriorityDefault
+                                              deadline:nil
+                                        overloadPolicy:G8OverloadPolicyReject
+                                            completion:nil];
+            [scheduler waitUntilAllRecognitionsAreFinished];
+        });
+
+        it(@"Should reject recognitions that can't make their deadline", ^{
+            NSTimeInterval estimate = [scheduler metricsForPriority:G8RecognitionPriorityDefault].estimatedRecognitionTime;
+            BOOL scheduled = [scheduler scheduleRecognitionForTesseract:tesseractWithImage(@"well_scaned_page")
+                                                               priority:G8RecognitionPriorityDefault
+                                                               deadline:[NSDate dateWithTimeIntervalSinceNow:estimate / 10]
+                                                         overloadPolicy:G8OverloadPolicyReject
+                                                             completion:nil];
+            [[theValue(scheduled) should] beNo];
+        });
+
+        it(@"Should degrade recognitions that can't make their deadline", ^{
+            NSTimeInterval estimate = [scheduler metricsForPriority:G8RecognitionPriorityDefault].estimatedRecognitionTime;
+            G8Tesseract *tesseract = tesseractWithImage(@"well_scaned_page");
+            __block NSNumber *outcome = nil;
+
+            BOOL scheduled = [scheduler scheduleRecognitionForTesseract:tesseract
+                                                               priority:G8RecognitionPriorityDefault
+                                                               deadline:[NSDate dateWithTimeIntervalSinceNow:estimate / 2]
+                                                         overloadPolicy:G8OverloadPolicyDegrade
+                                                             completion:^(G8Tesseract *tesseract, G8SchedulingOutcome result) {
+                outcome = @(result);
+            }];
+            [[theValue(scheduled) should] beYes];
+
+            [[expectFutureValue(outcome) shouldEventuallyBeforeTimingOutAfter(30.0)] equal:@(G8SchedulingOutcomeDegraded)];
+            [[theValue([scheduler metricsForPriority:G8RecognitionPriorityDefault].degradedCount) should] equal:theValue(1)];
+            [[theValue(tesseract.maximumRecognitionTime) should] equal:theValue(0)];
+        });
+    });
+});
+
+SPEC_END
@@ -0,0 +1,78 @@
+//
+//  TrainedDataTests.m
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+SPEC_BEGIN(TrainedDataTests)
+
+describe(@"Traineddata stripping", ^{
+
+    NSString *strippedPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"stripped"];
+    NSString *strippedTessdataPath = [strippedPath stringByAppendingPathComponent:@"tessdata"];
+
+    afterEach(^{
+        [[NSFileManager defaultManager] removeItemAtPath:strippedPath error:nil];
+    });
+
+    it(@"Should keep the output of the LSTM engine", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages
+                                                            engineMode:G8OCREngineModeLSTMOnly];
+        tesseract.image = [UIImage imageNamed:@"well_scaned_page"];
+
+        G8TrainedDataReport *report = [tesseract writeStrippedTrainedDataToDirectory:strippedTessdataPath];
+        [[report shouldNot] beNil];
+
+        [[theValue(report.strippedSize) should] beLessThanOrEqualTo:theValue(report.originalSize)];
+        [[theValue(report.isVerified) should] beYes];
+        [[theValue(report.identicalOutput) should] beYes];
+
+        NSString *file = [strippedTessdataPath stringByAppendingPathComponent:@"eng.traineddata"];
+        [[theValue([[NSFileManager defaultManager] fileExistsAtPath:file]) should] beYes];
+    });
+
+    it(@"Should be usable as tessdata", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages
+                                                            engineMode:G8OCREngineModeLSTMOnly];
+        [[[tesseract writeStrippedTrainedDataToDirectory:strippedTessdataPath] shouldNot] beNil];
+
+        G8Tesseract *stripped = [[G8Tesseract alloc] initWithLanguage:kG8Languages
+                                                     configDictionary:nil
+                                                      configFileNames:nil
+                                                     absoluteDataPath:strippedPath
+                                                           engineMode:G8OCREngineModeLSTMOnly];
+        [[theValue(stripped.isEngineConfigured) should] beYes];
+    });
+
+    it(@"Should skip verification without an image", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages
+                                                            engineMode:G8OCREngineModeLSTMOnly];
+        G8TrainedDataReport *report = [tesseract writeStrippedTrainedDataToDirectory:strippedTessdataPath];
+        [[report shouldNot] beNil];
+        [[theValue(report.isVerified) should] beNo];
+    });
+
+    it(@"Should refuse to write over its own tessdata", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages
+                                                            engineMode:G8OCREngineModeLSTMOnly];
+        NSString *file = [tesseract.absoluteDataPath stringByAppendingPathComponent:@"eng.traineddata"];
+        NSData *original = [NSData dataWithContentsOfFile:file];
+
+        [[[tesseract writeStrippedTrainedDataToDirectory:tesseract.absoluteDataPath] should] beNil];
+        [[[NSData dataWithContentsOfFile:file] should] equal:original];
+    });
+
+    it(@"Should fail for an unconfigured engine", ^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:@"rus"];
+        [[[tesseract writeStrippedTrainedDataToDirectory:strippedTessdataPath] should] beNil];
+    });
+});
+
+SPEC_END
@@ -0,0 +1,120 @@
+//
+//  WorkflowTests.mm
+//  TestsProjectTests
+//
+//  Created by agent on 18.10.26.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <TesseractOCR/TesseractOCR.h>
+#import <Kiwi/Kiwi.h>
+#import "Defaults.h"
+
+// Internal to the framework, not one of its public headers
+#import "../../TesseractOCR/G8Workflow.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+g8::Task<std::string> ocr(g8::AsyncRecognizer& recognizer, std::string path, g8::RenderFormat format) {
+    g8::PixWrapper pix = co_await g8::decode(recognizer, std::move(path));
+    pix = co_await g8::preprocess(recognizer, std::move(pix), g8::PreprocessOptions());
+    g8::RecognizedPage page = co_await g8::recognize(recognizer, pix, g8::RecognitionOptions());
+    co_return co_await g8::render(recognizer, page, format);
+}
+
+std::vector<std::vector<std::string>> rowsOfTSV(const std::string& tsv) {
+    std::vector<std::vector<std::string>> rows;
+    std::istringstream lines(tsv);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::vector<std::string> columns;
+        std::istringstream fields(line);
+        std::string field;
+        while (std::getline(fields, field, '\t')) {
+            columns.push_back(field);
+        }
+        // getline drops an empty last column
+        if (!line.empty() && line.back() == '\t') {
+            columns.push_back(std::string());
+        }
+        rows.push_back(columns);
+    }
+    return rows;
+}
+
+} // namespace
+
+SPEC_BEGIN(WorkflowTests)
+
+describe(@"Coroutine workflow", ^{
+
+    __block g8::EngineConfig config;
+    __block std::string pagePath;
+
+    beforeEach(^{
+        G8Tesseract *tesseract = [[G8Tesseract alloc] initWithLanguage:kG8Languages];
+        [[theValue(tesseract.isEngineConfigured) should] beYes];
+
+        config = g8::EngineConfig();
+        config.dataPath = tesseract.absoluteDataPath.fileSystemRepresentation;
+        config.language = tesseract.language.UTF8String;
+        config.engineMode = (int)tesseract.engineMode;
+        pagePath = [[NSBundle mainBundle] pathForResource:@"well_scaned_page" ofType:@"png"].fileSystemRepresentation;
+    });
+
+    it(@"Should decode, preprocess, recognize and render the text", ^{
+        g8::AsyncRecognizer recognizer(config, 2);
+        std::string text = g8::blockingWait(ocr(recognizer, pagePath, g8::RenderFormat::Text));
+
+        NSString *recognizedText = @(text.c_str());
+        [[recognizedText should] containString:@"Foreword"];
+        [[recognizedText should] containString:@"recommendations sometimes get acted on"];
+    });
+
+    it(@"Should render the page as TSV", ^{
+        g8::AsyncRecognizer recognizer(config, 2);
+        std::string tsv = g8::blockingWait(ocr(recognizer, pagePath, g8::RenderFormat::TSV));
+        std::vector<std::vector<std::string>> rows = rowsOfTSV(tsv);
+        [[theValue(rows.size()) should] beGreaterThan:theValue(2)];
+
+        std::vector<std::string> header = {"level", "page_num", "block_num", "par_num", "line_num", "word_num",
+                                           "left", "top", "width", "height", "conf", "text"};
+        [[theValue(rows[0] == header) should] beYes];
+
+        // The page row spans the whole image
+        std::vector<std::string> page = {"1", "1", "0", "0", "0", "0", "0", "0", "810", "1053", "-1", ""};
+        [[theValue(rows[1] == page) should] beYes];
+
+        NSUInteger words = 0;
+        BOOL foundHeading = NO;
+        for (size_t i = 1; i < rows.size(); ++i) {
+            const std::vector<std::string>& row = rows[i];
+            [[theValue(row.size()) should] equal:theValue(header.size())];
+            if (row.size() != header.size() || row[0] != "5") {
+                continue;
+            }
+            words++;
+            [[theValue(std::stoi(row[5])) should] beGreaterThan:theValue(0)];
+            [[theValue(std::stof(row[10])) should] beGreaterThanOrEqualTo:theValue(0)];
+            [[theValue(row[11].empty()) should] beNo];
+            if (row[11] == "Foreword") {
+                foundHeading = YES;
+            }
+        }
+        [[theValue(words) should] beGreaterThan:theValue(100)];
+        [[theValue(foundHeading) should] beYes];
+    });
+
+    it(@"Should render nothing for an image that can't be decoded", ^{
+        g8::AsyncRecognizer recognizer(config, 1);
+        std::string text = g8::blockingWait(ocr(recognizer, "/nonexistent.png", g8::RenderFormat::Text));
+        [[theValue(text.empty()) should] beYes];
+    });
+});
+
+SPEC_END
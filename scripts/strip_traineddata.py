@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Strip traineddata files down to the components an engine mode reads.
+
+Mirrors g8::TrainedData (TesseractOCR/G8TrainedData.mm), so it can run in an
+Xcode build phase before the files are copied into the bundle:
+
+    python3 scripts/strip_traineddata.py --engine-mode lstm \\
+        tessdata/eng.traineddata "$TARGET_BUILD_DIR/$UNLOCALIZED_RESOURCES_FOLDER_PATH/tessdata"
+
+Use G8Tesseract's writeStrippedTrainedDataToDirectory: to verify that the
+stripped files produce the same output.
+"""
+import argparse
+import os
+import struct
+import sys
+
+COMPONENT_COUNT = 24
+MAX_ENTRY_COUNT = 1000
+
+LANG_CONFIG, UNICHARSET, INTTEMP, VERSION = 0, 1, 3, 23
+OBSOLETE = {10, 11, 12}
+LSTM = set(range(17, 23))
+
+ENGINE_MODES = {'legacy': 0, 'lstm': 1, 'combined': 2, 'default': 3}
+
+
+def used_components(engine_mode):
+    used = set(range(COMPONENT_COUNT)) - OBSOLETE
+    if engine_mode == ENGINE_MODES['lstm']:
+        return used & (LSTM | {LANG_CONFIG, VERSION})
+    if engine_mode == ENGINE_MODES['legacy']:
+        return used - LSTM
+    return used
+
+
+def parse(data):
+    if len(data) < 4:
+        raise ValueError('file too short')
+    count, = struct.unpack_from('<I', data, 0)
+    if count > MAX_ENTRY_COUNT:
+        raise ValueError('unsupported byte order')
+    table_end = 4 + 8 * count
+    if len(data) < table_end:
+        raise ValueError('truncated offset table')
+    offsets = struct.unpack_from('<%dq' % count, data, 4)
+
+    components = [b''] * COMPONENT_COUNT
+    for i in range(min(count, COMPONENT_COUNT)):
+        if offsets[i] < 0:
+            continue
+        end = next((o for o in offsets[i + 1:] if o >= 0), len(data))
+        if offsets[i] < table_end or end < offsets[i] or end > len(data):
+            raise ValueError('bad offset for component %d' % i)
+        components[i] = data[offsets[i]:end]
+    return components
+
+
+def serialize(components):
+    offsets = []
+    offset = 4 + 8 * COMPONENT_COUNT
+    for component in components:
+        offsets.append(offset if component else -1)
+        offset += len(component)
+    header = struct.pack('<I%dq' % COMPONENT_COUNT, COMPONENT_COUNT, *offsets)
+    return header + b''.join(components)
+
+
+def strip(components, engine_mode):
+    if engine_mode == ENGINE_MODES['lstm'] and not components[17]:
+        raise ValueError('no LSTM model')
+    if engine_mode == ENGINE_MODES['legacy'] and not (components[UNICHARSET] and components[INTTEMP]):
+        raise ValueError('no legacy model')
+    used = used_components(engine_mode)
+    return [c if i in used else b'' for i, c in enumerate(components)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--engine-mode', choices=sorted(ENGINE_MODES), default='lstm')
+    parser.add_argument('files', nargs='+', metavar='file.traineddata')
+    parser.add_argument('output', help='output directory')
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    status = 0
+    for path in args.files:
+        try:
+            with open(path, 'rb') as f:
+                original = f.read()
+            stripped = serialize(strip(parse(original), ENGINE_MODES[args.engine_mode]))
+        except (OSError, ValueError) as e:
+            print('%s: %s' % (path, e), file=sys.stderr)
+            status = 1
+            continue
+        with open(os.path.join(args.output, os.path.basename(path)), 'wb') as f:
+            f.write(stripped)
+        print('%s: %d -> %d bytes' % (os.path.basename(path), len(original), len(stripped)))
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())